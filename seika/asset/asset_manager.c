@@ -4,12 +4,16 @@
 #include "seika/assert.h"
 #include "seika/data_structures/hash_map_string.h"
 #include "seika/rendering/texture.h"
+#include "seika/rendering/texture_atlas.h"
 #include "seika/rendering/font.h"
 #include "seika/audio/audio.h"
 
 static SkaStringHashMap* texturesMap = NULL;
 static SkaStringHashMap* fontMap = NULL;
 static SkaStringHashMap* audioSourceMap = NULL;
+#if SKA_RENDERING
+static SkaTextureAtlas* textureAtlas = NULL;
+#endif
 
 void ska_asset_manager_initialize() {
     texturesMap = ska_string_hash_map_create_default_capacity();
@@ -21,14 +25,36 @@ void ska_asset_manager_finalize() {
     ska_string_hash_map_destroy(texturesMap);
     ska_string_hash_map_destroy(fontMap);
     ska_string_hash_map_destroy(audioSourceMap);
+#if SKA_RENDERING
+    if (textureAtlas != NULL) {
+        ska_texture_atlas_destroy(textureAtlas);
+        textureAtlas = NULL;
+    }
+#endif
 }
 
 #if SKA_RENDERING
 // --- Texture --- //
+void ska_asset_manager_enable_texture_atlas(int32 pageSize) {
+    SKA_ASSERT_FMT(textureAtlas == NULL, "Texture atlas is already enabled!");
+    textureAtlas = ska_texture_atlas_create(pageSize);
+}
+
+// Packs into the texture atlas when enabled, textures that repeat or don't fit are created standalone
+static SkaTexture* asset_manager_create_texture(const char* fileName, GLint wrapS, GLint wrapT, bool applyNearestNeighbor) {
+    if (textureAtlas != NULL && wrapS != GL_REPEAT && wrapT != GL_REPEAT) {
+        SkaTexture* texture = ska_texture_atlas_load_texture(textureAtlas, fileName, applyNearestNeighbor);
+        if (texture != NULL) {
+            return texture;
+        }
+    }
+    return ska_texture_create_texture2(fileName, wrapS, wrapT, applyNearestNeighbor);
+}
+
 SkaTexture* ska_asset_manager_load_texture(const char* fileName, const char* key) {
     SKA_ASSERT(texturesMap != NULL);
     SKA_ASSERT_FMT(!ska_string_hash_map_has(texturesMap, fileName), "Already loaded texture at file path '%'s!  Has key '%s'.", fileName, key);
-    SkaTexture* texture = ska_texture_create_texture(fileName);
+    SkaTexture* texture = asset_manager_create_texture(fileName, GL_CLAMP_TO_BORDER, GL_CLAMP_TO_BORDER, true);
     ska_string_hash_map_add(texturesMap, key, texture, sizeof(SkaTexture));
     SKA_FREE(texture);
     texture = (SkaTexture*) ska_string_hash_map_get(texturesMap, key);
@@ -38,7 +64,7 @@ SkaTexture* ska_asset_manager_load_texture(const char* fileName, const char* key
 SkaTexture* ska_asset_manager_load_texture_ex(const char* fileName, const char* key, const char* wrap_s, const char* wrap_t, bool applyNearestNeighbor) {
     SKA_ASSERT(texturesMap != NULL);
     SKA_ASSERT_FMT(!ska_string_hash_map_has(texturesMap, fileName), "Already loaded texture at file path '%'s!  Has key '%s'.", fileName, key);
-    SkaTexture* texture = ska_texture_create_texture2(
+    SkaTexture* texture = asset_manager_create_texture(
                              fileName,
                              ska_texture_wrap_string_to_int(wrap_s),
                              ska_texture_wrap_string_to_int(wrap_t),
@@ -59,26 +85,40 @@ bool ska_asset_manager_has_texture(const char* key) {
 }
 
 // --- Font --- //
+// The map keeps its own copy of the font
+static SkaFont* asset_manager_add_font(const char* key, SkaFont* font) {
+    ska_string_hash_map_add(fontMap, key, font, sizeof(SkaFont));
+    SKA_FREE(font);
+    return (SkaFont*) ska_string_hash_map_get(fontMap, key);
+}
+
 SkaFont* ska_asset_manager_load_font(const char* fileName, const char* key, int size, bool applyNearestNeighbor) {
     SKA_ASSERT_FMT(!ska_asset_manager_has_font(key), "Font key '%s' already exists!", key);
     SkaFont* font = ska_font_create_font(fileName, size, applyNearestNeighbor);
     SKA_ASSERT_FMT(font != NULL, "Failed to load font! file_name: '%s', key: '%s', size: '%d'", fileName, key, size);
-    ska_string_hash_map_add(fontMap, key, font, sizeof(SkaFont));
-    SKA_FREE(font);
-    font = (SkaFont*) ska_string_hash_map_get(fontMap, key);
-    return font;
+    return asset_manager_add_font(key, font);
 }
 
 SkaFont* ska_asset_manager_load_font_from_memory(const char* key, void* buffer, usize bufferSize, int size, bool applyNearestNeighbor) {
     SKA_ASSERT_FMT(!ska_asset_manager_has_font(key), "Font key '%s' already exists!", key);
     SkaFont* font = ska_font_create_font_from_memory(buffer, bufferSize, size, applyNearestNeighbor);
     SKA_ASSERT_FMT(font != NULL, "Failed to load font! key: '%s', size: '%d'", key, size);
-    ska_string_hash_map_add(fontMap, key, font, sizeof(SkaFont));
-    SKA_FREE(font);
-    font = (SkaFont*) ska_string_hash_map_get(fontMap, key);
-    return  font;
+    return asset_manager_add_font(key, font);
 }
 
+SkaFont* ska_asset_manager_load_sdf_font(const char* fileName, const char* key, int referenceSize) {
+    SKA_ASSERT_FMT(!ska_asset_manager_has_font(key), "Font key '%s' already exists!", key);
+    SkaFont* font = ska_font_create_font2(fileName, referenceSize, false, SkaFontRenderMode_SDF);
+    SKA_ASSERT_FMT(font != NULL, "Failed to load font! file_name: '%s', key: '%s', size: '%d'", fileName, key, referenceSize);
+    return asset_manager_add_font(key, font);
+}
+
+SkaFont* ska_asset_manager_load_sdf_font_from_memory(const char* key, void* buffer, usize bufferSize, int referenceSize) {
+    SKA_ASSERT_FMT(!ska_asset_manager_has_font(key), "Font key '%s' already exists!", key);
+    SkaFont* font = ska_font_create_font_from_memory2(buffer, bufferSize, referenceSize, false, SkaFontRenderMode_SDF);
+    SKA_ASSERT_FMT(font != NULL, "Failed to load font! key: '%s', size: '%d'", key, referenceSize);
+    return asset_manager_add_font(key, font);
+}
 
 SkaFont* ska_asset_manager_get_font(const char* key) {
     return (SkaFont*) ska_string_hash_map_get(fontMap, key);
@@ -10,6 +10,9 @@ void ska_asset_manager_initialize();
 void ska_asset_manager_finalize();
 
 #if SKA_RENDERING
+// Textures loaded afterwards are packed into shared atlas pages ('pageSize' x 'pageSize' pixels) when they fit and don't
+// repeat, so sprites using different textures can be drawn in one batch
+void ska_asset_manager_enable_texture_atlas(int32 pageSize);
 struct SkaTexture* ska_asset_manager_load_texture(const char* fileName, const char* key);
 struct SkaTexture* ska_asset_manager_load_texture_ex(const char* fileName, const char* key, const char* wrap_s, const char* wrap_t, bool applyNearestNeighbor);
 struct SkaTexture* ska_asset_manager_get_texture(const char* key);
@@ -17,6 +20,9 @@ bool ska_asset_manager_has_texture(const char* key);
 
 struct SkaFont* ska_asset_manager_load_font(const char* fileName, const char* key, int size, bool applyNearestNeighbor);
 struct SkaFont* ska_asset_manager_load_font_from_memory(const char* key, void* buffer, usize bufferSize, int size, bool applyNearestNeighbor);
+// Signed distance field fonts are rasterized once at 'referenceSize' and drawn at any size by scaling the text
+struct SkaFont* ska_asset_manager_load_sdf_font(const char* fileName, const char* key, int referenceSize);
+struct SkaFont* ska_asset_manager_load_sdf_font_from_memory(const char* key, void* buffer, usize bufferSize, int referenceSize);
 struct SkaFont* ska_asset_manager_get_font(const char* key);
 bool ska_asset_manager_has_font(const char* key);
 #endif // #if SKA_RENDERING
@@ -35,6 +35,32 @@ void ska_array_list_push_back(SkaArrayList* list, const void* value) {
     list->size++;
 }
 
+void ska_array_list_push_back_array(SkaArrayList* list, const void* values, usize count) {
+    ska_array_list_reserve(list, list->size + count);
+    memcpy((char*)list->data + list->size * list->valueSize, values, count * list->valueSize);
+    list->size += count;
+}
+
+void ska_array_list_reserve(SkaArrayList* list, usize capacity) {
+    if (capacity <= list->capacity) {
+        return;
+    }
+    usize newCapacity = list->capacity > 0 ? list->capacity : 1;
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+    list->capacity = newCapacity;
+    list->data = ska_mem_reallocate(list->data, list->capacity * list->valueSize);
+}
+
+void ska_array_list_resize(SkaArrayList* list, usize size) {
+    ska_array_list_reserve(list, size);
+    if (size > list->size) {
+        memset((char*)list->data + list->size * list->valueSize, 0, (size - list->size) * list->valueSize);
+    }
+    list->size = size;
+}
+
 void* ska_array_list_get(SkaArrayList* list, usize index) {
     SKA_ASSERT_FMT(index < list->size, "Attempting to access out of bounds index '%d", index);
     return (char*)list->data + index * list->valueSize;
@@ -23,6 +23,12 @@ SkaArrayList* ska_array_list_create(usize valueSize, usize initialCapacity);
 void ska_array_list_destroy(SkaArrayList* list);
 // Inserts an item at the end of the list
 void ska_array_list_push_back(SkaArrayList* list, const void* value);
+// Inserts 'count' items at the end of the list, only grows the list once
+void ska_array_list_push_back_array(SkaArrayList* list, const void* values, usize count);
+// Makes sure the list can hold 'capacity' items without resizing
+void ska_array_list_reserve(SkaArrayList* list, usize capacity);
+// Sets the size of the list, new items are zeroed
+void ska_array_list_resize(SkaArrayList* list, usize size);
 // Returns an item from the list from specified index
 void* ska_array_list_get(SkaArrayList* list, usize index);
 // Removes the first item from the list who is equal to the passed in value
@@ -1,32 +1,160 @@
 #include "array_utils.h"
 
+#include <string.h>
+
 static inline void ska_array_utils_swap(int32* xp, int32* yp) {
     int32 temp = *xp;
     *xp = *yp;
     *yp = temp;
 }
 
-// Function to perform Selection Sort
+// Arrays up to this size are insertion sorted, merge sort also uses it for its initial runs
+#define SKA_ARRAY_UTILS_INSERTION_SORT_THRESHOLD 16
+
+static void array_utils_insertion_sort_int(int32 array[], usize size) {
+    for (usize i = 1; i < size; i++) {
+        const int32 value = array[i];
+        usize j = i;
+        for (; j > 0 && array[j - 1] > value; j--) {
+            array[j] = array[j - 1];
+        }
+        array[j] = value;
+    }
+}
+
+static void array_utils_sift_down_int(int32 array[], usize root, usize size) {
+    for (usize child = root * 2 + 1; child < size; child = root * 2 + 1) {
+        if (child + 1 < size && array[child + 1] > array[child]) {
+            child++;
+        }
+        if (array[root] >= array[child]) {
+            return;
+        }
+        ska_array_utils_swap(&array[root], &array[child]);
+        root = child;
+    }
+}
+
+void ska_array_utils_sort_int(int32 array[], usize size) {
+    if (size <= SKA_ARRAY_UTILS_INSERTION_SORT_THRESHOLD) {
+        array_utils_insertion_sort_int(array, size);
+        return;
+    }
+    // Heap sort, in place with no worst case beyond n log n
+    for (usize i = size / 2; i-- > 0;) {
+        array_utils_sift_down_int(array, i, size);
+    }
+    for (usize end = size - 1; end > 0; end--) {
+        ska_array_utils_swap(&array[0], &array[end]);
+        array_utils_sift_down_int(array, 0, end);
+    }
+}
+
 void ska_array_utils_selection_sort_int(int32 arr[], int32 arraySize) {
-    int32 min_idx;
+    if (arraySize > 1) {
+        ska_array_utils_sort_int(arr, (usize)arraySize);
+    }
+}
 
-    // One by one move boundary of unsorted subarray
-    for (int32 i = 0; i < arraySize - 1; i++) {
+// Sorts 'size' elements starting at 'array', 'temp' has room for one element
+static void array_utils_insertion_sort(char* array, usize size, usize elementSize, SkaArrayUtilsCompareFunc compareFunc, void* temp) {
+    for (usize i = 1; i < size; i++) {
+        char* element = array + i * elementSize;
+        if (compareFunc(element - elementSize, element) <= 0) {
+            continue;
+        }
+        memcpy(temp, element, elementSize);
+        usize j = i;
+        for (; j > 0 && compareFunc(array + (j - 1) * elementSize, temp) > 0; j--) {}
+        memmove(array + (j + 1) * elementSize, array + j * elementSize, (i - j) * elementSize);
+        memcpy(array + j * elementSize, temp, elementSize);
+    }
+}
 
-        // Find the minimum element in unsorted array
-        min_idx = i;
-        for (int32 j = i + 1; j < arraySize; j++) {
-            if (arr[j] < arr[min_idx]) {
-                min_idx = j;
+void ska_array_utils_merge_sort(void* array, void* scratch, usize size, usize elementSize, SkaArrayUtilsCompareFunc compareFunc) {
+    if (size < 2) {
+        return;
+    }
+    // Bottom up, runs are insertion sorted first and then merged back and forth between 'array' and 'scratch'
+    const usize runSize = SKA_ARRAY_UTILS_INSERTION_SORT_THRESHOLD;
+    for (usize start = 0; start < size; start += runSize) {
+        const usize count = size - start < runSize ? size - start : runSize;
+        array_utils_insertion_sort((char*)array + start * elementSize, count, elementSize, compareFunc, scratch);
+    }
+    char* source = (char*)array;
+    char* destination = (char*)scratch;
+    for (usize width = runSize; width < size; width *= 2) {
+        for (usize left = 0; left < size; left += width * 2) {
+            const usize middle = left + width < size ? left + width : size;
+            const usize right = middle + width < size ? middle + width : size;
+            usize i = left;
+            usize j = middle;
+            char* out = destination + left * elementSize;
+            // Ties take from the left run, which keeps the sort stable
+            while (i < middle && j < right) {
+                const usize index = compareFunc(source + j * elementSize, source + i * elementSize) < 0 ? j++ : i++;
+                memcpy(out, source + index * elementSize, elementSize);
+                out += elementSize;
             }
+            memcpy(out, source + i * elementSize, (middle - i) * elementSize);
+            out += (middle - i) * elementSize;
+            memcpy(out, source + j * elementSize, (right - j) * elementSize);
         }
+        char* temp = source;
+        source = destination;
+        destination = temp;
+    }
+    if (source != (char*)array) {
+        memcpy(array, source, size * elementSize);
+    }
+}
 
-        // Swap the found minimum element
-        // with the first element
-        ska_array_utils_swap(&arr[min_idx], &arr[i]);
+void ska_array_utils_radix_sort_uint64(uint64 array[], uint64 scratch[], usize size, uint32 keyBitOffset) {
+    if (size < 2 || keyBitOffset >= 64) {
+        return;
+    }
+    // Histograms of all sorted bytes are built in one pass
+    const uint32 firstByte = keyBitOffset / 8;
+    const uint32 byteCount = 8 - firstByte;
+    usize histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+    const uint64 keyMask = keyBitOffset % 8 == 0 ? ~(uint64)0 : ~(((uint64)1 << keyBitOffset) - 1);
+    for (usize i = 0; i < size; i++) {
+        const uint64 key = array[i] & keyMask;
+        for (uint32 b = 0; b < byteCount; b++) {
+            histograms[b][(key >> ((firstByte + b) * 8)) & 0xFF]++;
+        }
+    }
+
+    uint64* source = array;
+    uint64* destination = scratch;
+    for (uint32 b = 0; b < byteCount; b++) {
+        usize* histogram = histograms[b];
+        const uint32 shift = (firstByte + b) * 8;
+        // All elements share this byte, the pass wouldn't change anything
+        if (histogram[((source[0] & keyMask) >> shift) & 0xFF] == size) {
+            continue;
+        }
+        usize offset = 0;
+        for (usize digit = 0; digit < 256; digit++) {
+            const usize count = histogram[digit];
+            histogram[digit] = offset;
+            offset += count;
+        }
+        for (usize i = 0; i < size; i++) {
+            destination[histogram[((source[i] & keyMask) >> shift) & 0xFF]++] = source[i];
+        }
+        uint64* temp = source;
+        source = destination;
+        destination = temp;
+    }
+    if (source != array) {
+        memcpy(array, source, size * sizeof(uint64));
     }
 }
 
 void ska_array_utils_remove_item_uint32(uint32 array[], usize* size, uint32 item, uint32 emptyValue) {
     SKA_ARRAY_UTILS_REMOVE_ARRAY_ITEM(array, *size, item, emptyValue);
 }
+
+#undef SKA_ARRAY_UTILS_INSERTION_SORT_THRESHOLD
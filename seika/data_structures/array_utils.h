@@ -18,7 +18,17 @@ ARRAY[temp_arac_loop_index + 1] = EMPTY_VALUE;                         \
 }                                                        \
 }
 
-// Function to perform Selection Sort
+// Returns less than, equal to, or greater than zero if 'a' orders before, the same as, or after 'b'
+typedef int32 (*SkaArrayUtilsCompareFunc)(const void* a, const void* b);
+
+// In place O(n log n) sort, small arrays are insertion sorted
+void ska_array_utils_sort_int(int32 array[], usize size);
+// Kept for existing callers, same as 'ska_array_utils_sort_int'
 void ska_array_utils_selection_sort_int(int32 arr[], int32 arraySize);
+// Stable O(n log n) sort of 'size' elements of 'elementSize' bytes.  'scratch' needs room for 'size' elements.
+void ska_array_utils_merge_sort(void* array, void* scratch, usize size, usize elementSize, SkaArrayUtilsCompareFunc compareFunc);
+// Stable LSD radix sort of 'array' by its bits from 'keyBitOffset' up, lower bits keep their relative order.  'scratch' needs
+// room for 'size' elements.  Bytes that are the same for all elements are skipped.
+void ska_array_utils_radix_sort_uint64(uint64 array[], uint64 scratch[], usize size, uint32 keyBitOffset);
 
 void ska_array_utils_remove_item_uint32(uint32 array[], usize* size, uint32 item, uint32 emptyValue);
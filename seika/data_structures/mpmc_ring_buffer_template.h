@@ -0,0 +1,141 @@
+// Bounded lock free multi producer multi consumer ring buffer template (Vyukov)
+//
+// #define SKA_MPMC_RING_BUFFER_TEMPLATE NetworkMessage
+// #include "seika/data_structures/mpmc_ring_buffer_template.h"
+//
+// Defines 'SkaMPMCRingBuffer_NetworkMessage' and 'ska_mpmc_ring_buffer_NetworkMessage_*' functions.  Any number of threads
+// can push and pop.  The template type must be a single identifier (use a typedef).
+
+#ifndef SKA_MPMC_RING_BUFFER_TEMPLATE
+#error "SKA_MPMC_RING_BUFFER_TEMPLATE must be defined before including mpmc_ring_buffer_template.h"
+#endif
+
+#include "seika/thread/atomic.h"
+#include <stdint.h>
+
+#include "seika/defines.h"
+#include "seika/memory.h"
+
+#ifndef SKA_RING_BUFFER_CACHE_LINE_SIZE
+#define SKA_RING_BUFFER_CACHE_LINE_SIZE 64
+#endif
+
+#define SKA_MPMC_RING_BUFFER_T_IMPL(Name) SkaMPMCRingBuffer_##Name
+#define SKA_MPMC_RING_BUFFER_T(Name) SKA_MPMC_RING_BUFFER_T_IMPL(Name)
+#define SKA_MPMC_RING_BUFFER_CELL_T_IMPL(Name) SkaMPMCRingBufferCell_##Name
+#define SKA_MPMC_RING_BUFFER_CELL_T(Name) SKA_MPMC_RING_BUFFER_CELL_T_IMPL(Name)
+#define SKA_MPMC_RING_BUFFER_FUNC_IMPL(Name, Suffix) ska_mpmc_ring_buffer_##Name##_##Suffix
+#define SKA_MPMC_RING_BUFFER_FUNC(Name, Suffix) SKA_MPMC_RING_BUFFER_FUNC_IMPL(Name, Suffix)
+
+// Struct definition
+// Each cell's sequence tells whether it's ready to be written (sequence == position) or read (sequence == position + 1)
+typedef struct SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE) {
+    SKA_ATOMIC(usize) sequence;
+    SKA_MPMC_RING_BUFFER_TEMPLATE item;
+} SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE);
+
+typedef struct SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE) {
+    SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* cells;
+    usize capacity; // Power of 2
+    char cellsPadding[SKA_RING_BUFFER_CACHE_LINE_SIZE - sizeof(void*) - sizeof(usize)];
+    SKA_ATOMIC(usize) enqueuePosition;
+    char enqueuePadding[SKA_RING_BUFFER_CACHE_LINE_SIZE - sizeof(usize)];
+    SKA_ATOMIC(usize) dequeuePosition;
+    char dequeuePadding[SKA_RING_BUFFER_CACHE_LINE_SIZE - sizeof(usize)];
+} SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE);
+
+// Function definitions
+// Capacity is rounded up to a power of 2 (at least 2)
+static inline void SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, initialize)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer, usize capacity) {
+    ringBuffer->capacity = 2;
+    while (ringBuffer->capacity < capacity) {
+        ringBuffer->capacity <<= 1;
+    }
+    ringBuffer->cells = (SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE)*)SKA_ALLOC_BYTES(ringBuffer->capacity * sizeof(SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE)));
+    for (usize i = 0; i < ringBuffer->capacity; i++) {
+        ska_atomic_init(&ringBuffer->cells[i].sequence, i);
+    }
+    ska_atomic_init(&ringBuffer->enqueuePosition, 0);
+    ska_atomic_init(&ringBuffer->dequeuePosition, 0);
+}
+
+static inline void SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, finalize)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    SKA_FREE(ringBuffer->cells);
+    ringBuffer->cells = NULL;
+}
+
+static inline SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, create)(usize capacity) {
+    SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer = SKA_ALLOC(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE));
+    SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, initialize)(ringBuffer, capacity);
+    return ringBuffer;
+}
+
+static inline void SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, destroy)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, finalize)(ringBuffer);
+    SKA_FREE(ringBuffer);
+}
+
+// Returns false if full
+static inline bool SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, try_push)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer, SKA_MPMC_RING_BUFFER_TEMPLATE item) {
+    usize position = ska_atomic_load(&ringBuffer->enqueuePosition, SkaMemoryOrder_RELAXED);
+    SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* cell;
+    while (true) {
+        cell = &ringBuffer->cells[position & (ringBuffer->capacity - 1)];
+        const usize sequence = ska_atomic_load(&cell->sequence, SkaMemoryOrder_ACQUIRE);
+        const intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+        if (diff == 0) {
+            if (ska_atomic_compare_exchange_weak(&ringBuffer->enqueuePosition, &position, position + 1, SkaMemoryOrder_RELAXED, SkaMemoryOrder_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // Full
+        } else {
+            position = ska_atomic_load(&ringBuffer->enqueuePosition, SkaMemoryOrder_RELAXED);
+        }
+    }
+    cell->item = item;
+    ska_atomic_store(&cell->sequence, position + 1, SkaMemoryOrder_RELEASE);
+    return true;
+}
+
+// Returns false if empty
+static inline bool SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, try_pop)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer, SKA_MPMC_RING_BUFFER_TEMPLATE* outItem) {
+    usize position = ska_atomic_load(&ringBuffer->dequeuePosition, SkaMemoryOrder_RELAXED);
+    SKA_MPMC_RING_BUFFER_CELL_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* cell;
+    while (true) {
+        cell = &ringBuffer->cells[position & (ringBuffer->capacity - 1)];
+        const usize sequence = ska_atomic_load(&cell->sequence, SkaMemoryOrder_ACQUIRE);
+        const intptr_t diff = (intptr_t)sequence - (intptr_t)(position + 1);
+        if (diff == 0) {
+            if (ska_atomic_compare_exchange_weak(&ringBuffer->dequeuePosition, &position, position + 1, SkaMemoryOrder_RELAXED, SkaMemoryOrder_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // Empty
+        } else {
+            position = ska_atomic_load(&ringBuffer->dequeuePosition, SkaMemoryOrder_RELAXED);
+        }
+    }
+    *outItem = cell->item;
+    ska_atomic_store(&cell->sequence, position + ringBuffer->capacity, SkaMemoryOrder_RELEASE);
+    return true;
+}
+
+// Approximate when called while other threads push or pop
+static inline usize SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, get_size)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    const usize dequeuePosition = ska_atomic_load(&ringBuffer->dequeuePosition, SkaMemoryOrder_SEQ_CST);
+    const usize enqueuePosition = ska_atomic_load(&ringBuffer->enqueuePosition, SkaMemoryOrder_SEQ_CST);
+    return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+}
+
+static inline bool SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, is_empty)(SKA_MPMC_RING_BUFFER_T(SKA_MPMC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    return SKA_MPMC_RING_BUFFER_FUNC(SKA_MPMC_RING_BUFFER_TEMPLATE, get_size)(ringBuffer) == 0;
+}
+
+#undef SKA_MPMC_RING_BUFFER_T_IMPL
+#undef SKA_MPMC_RING_BUFFER_T
+#undef SKA_MPMC_RING_BUFFER_CELL_T_IMPL
+#undef SKA_MPMC_RING_BUFFER_CELL_T
+#undef SKA_MPMC_RING_BUFFER_FUNC_IMPL
+#undef SKA_MPMC_RING_BUFFER_FUNC
+#undef SKA_MPMC_RING_BUFFER_TEMPLATE
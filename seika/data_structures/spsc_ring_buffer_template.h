@@ -0,0 +1,114 @@
+// Bounded lock free single producer single consumer ring buffer template
+//
+// #define SKA_SPSC_RING_BUFFER_TEMPLATE AudioCommand
+// #include "seika/data_structures/spsc_ring_buffer_template.h"
+//
+// Defines 'SkaSPSCRingBuffer_AudioCommand' and 'ska_spsc_ring_buffer_AudioCommand_*' functions.  Only one thread may push
+// and only one (other) thread may pop at a time.  The template type must be a single identifier (use a typedef).
+
+#ifndef SKA_SPSC_RING_BUFFER_TEMPLATE
+#error "SKA_SPSC_RING_BUFFER_TEMPLATE must be defined before including spsc_ring_buffer_template.h"
+#endif
+
+#include "seika/thread/atomic.h"
+
+#include "seika/defines.h"
+#include "seika/memory.h"
+
+#ifndef SKA_RING_BUFFER_CACHE_LINE_SIZE
+#define SKA_RING_BUFFER_CACHE_LINE_SIZE 64
+#endif
+
+#define SKA_SPSC_RING_BUFFER_T_IMPL(Name) SkaSPSCRingBuffer_##Name
+#define SKA_SPSC_RING_BUFFER_T(Name) SKA_SPSC_RING_BUFFER_T_IMPL(Name)
+#define SKA_SPSC_RING_BUFFER_FUNC_IMPL(Name, Suffix) ska_spsc_ring_buffer_##Name##_##Suffix
+#define SKA_SPSC_RING_BUFFER_FUNC(Name, Suffix) SKA_SPSC_RING_BUFFER_FUNC_IMPL(Name, Suffix)
+
+// Struct definition
+// Producer and consumer positions live on separate cache lines, each side caches the other's position and only reloads
+// it when the buffer looks full (producer) or empty (consumer)
+typedef struct SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE) {
+    SKA_ATOMIC(usize) tail; // Next position to push, written by the producer
+    usize cachedHead;
+    char tailPadding[SKA_RING_BUFFER_CACHE_LINE_SIZE - sizeof(usize) * 2];
+    SKA_ATOMIC(usize) head; // Next position to pop, written by the consumer
+    usize cachedTail;
+    char headPadding[SKA_RING_BUFFER_CACHE_LINE_SIZE - sizeof(usize) * 2];
+    usize capacity; // Power of 2
+    SKA_SPSC_RING_BUFFER_TEMPLATE* items;
+} SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE);
+
+// Function definitions
+// Capacity is rounded up to a power of 2
+static inline void SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, initialize)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer, usize capacity) {
+    ringBuffer->capacity = 1;
+    while (ringBuffer->capacity < capacity) {
+        ringBuffer->capacity <<= 1;
+    }
+    ska_atomic_init(&ringBuffer->tail, 0);
+    ska_atomic_init(&ringBuffer->head, 0);
+    ringBuffer->cachedHead = 0;
+    ringBuffer->cachedTail = 0;
+    ringBuffer->items = (SKA_SPSC_RING_BUFFER_TEMPLATE*)SKA_ALLOC_BYTES(ringBuffer->capacity * sizeof(SKA_SPSC_RING_BUFFER_TEMPLATE));
+}
+
+static inline void SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, finalize)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    SKA_FREE(ringBuffer->items);
+    ringBuffer->items = NULL;
+}
+
+static inline SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, create)(usize capacity) {
+    SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer = SKA_ALLOC(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE));
+    SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, initialize)(ringBuffer, capacity);
+    return ringBuffer;
+}
+
+static inline void SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, destroy)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, finalize)(ringBuffer);
+    SKA_FREE(ringBuffer);
+}
+
+// Producer only, returns false if full
+static inline bool SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, try_push)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer, SKA_SPSC_RING_BUFFER_TEMPLATE item) {
+    const usize tail = ska_atomic_load(&ringBuffer->tail, SkaMemoryOrder_RELAXED);
+    if (tail - ringBuffer->cachedHead == ringBuffer->capacity) {
+        ringBuffer->cachedHead = ska_atomic_load(&ringBuffer->head, SkaMemoryOrder_ACQUIRE);
+        if (tail - ringBuffer->cachedHead == ringBuffer->capacity) {
+            return false;
+        }
+    }
+    ringBuffer->items[tail & (ringBuffer->capacity - 1)] = item;
+    ska_atomic_store(&ringBuffer->tail, tail + 1, SkaMemoryOrder_RELEASE);
+    return true;
+}
+
+// Consumer only, returns false if empty
+static inline bool SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, try_pop)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer, SKA_SPSC_RING_BUFFER_TEMPLATE* outItem) {
+    const usize head = ska_atomic_load(&ringBuffer->head, SkaMemoryOrder_RELAXED);
+    if (head == ringBuffer->cachedTail) {
+        ringBuffer->cachedTail = ska_atomic_load(&ringBuffer->tail, SkaMemoryOrder_ACQUIRE);
+        if (head == ringBuffer->cachedTail) {
+            return false;
+        }
+    }
+    *outItem = ringBuffer->items[head & (ringBuffer->capacity - 1)];
+    ska_atomic_store(&ringBuffer->head, head + 1, SkaMemoryOrder_RELEASE);
+    return true;
+}
+
+// Approximate when called while the other side is active
+static inline usize SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, get_size)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    const usize head = ska_atomic_load(&ringBuffer->head, SkaMemoryOrder_SEQ_CST);
+    const usize tail = ska_atomic_load(&ringBuffer->tail, SkaMemoryOrder_SEQ_CST);
+    return tail > head ? tail - head : 0;
+}
+
+static inline bool SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, is_empty)(SKA_SPSC_RING_BUFFER_T(SKA_SPSC_RING_BUFFER_TEMPLATE)* ringBuffer) {
+    return SKA_SPSC_RING_BUFFER_FUNC(SKA_SPSC_RING_BUFFER_TEMPLATE, get_size)(ringBuffer) == 0;
+}
+
+#undef SKA_SPSC_RING_BUFFER_T_IMPL
+#undef SKA_SPSC_RING_BUFFER_T
+#undef SKA_SPSC_RING_BUFFER_FUNC_IMPL
+#undef SKA_SPSC_RING_BUFFER_FUNC
+#undef SKA_SPSC_RING_BUFFER_TEMPLATE
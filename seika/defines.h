@@ -43,6 +43,8 @@ typedef int32_t i32;
 typedef int64_t int64;
 typedef int64_t i64;
 
+typedef uint16_t uint16;
+typedef uint16_t u16;
 typedef uint32_t uint32;
 typedef uint32_t u32;
 typedef uint64_t uint64;
@@ -1,8 +1,12 @@
 #if SKA_ECS
 
 #include "component.h"
+#include "query.h"
+
+#include <string.h>
 
 #include "seika/string.h"
+#include "seika/flag_utils.h"
 #include "seika/memory.h"
 #include "seika/assert.h"
 #include "seika/data_structures/hash_map_string.h"
@@ -11,6 +15,7 @@
 //--- Component ---//
 static SkaComponentIndex globalComponentIndex = 0;
 static SkaStringHashMap* componentNameToTypeMap = NULL;
+static usize componentSizes[SKA_ECS_MAX_COMPONENTS];
 
 const SkaComponentTypeInfo* ska_ecs_component_register_type(const char* name, usize componentSize) {
     SKA_ASSERT_FMT(globalComponentIndex + 1 < SKA_ECS_MAX_COMPONENTS, "Over the maximum allowed components which are '%d'", SKA_ECS_MAX_COMPONENTS);
@@ -28,6 +33,7 @@ const SkaComponentTypeInfo* ska_ecs_component_register_type(const char* name, us
         .size = componentSize
     };
     ska_string_hash_map_add(componentNameToTypeMap, name, &newTypeInfo, sizeof(SkaComponentTypeInfo));
+    componentSizes[newTypeIndex] = componentSize;
     return ska_ecs_component_get_type_info(name, componentSize);
 }
 
@@ -48,10 +54,77 @@ SkaComponentType ska_ecs_component_get_type_flag(const char* name, usize compone
     return typeInfo->type;
 }
 
+SkaComponentType ska_ecs_component_get_signature_from_string(const char* signatures) {
+    // Take signature string (e.g. 'TransformComponent, SpriteComponent') and create flags
+    SkaComponentType signature = SKA_ECS_COMPONENT_TYPE_NONE;
+    char typeNameBuffer[256];
+    char* word = typeNameBuffer;
+    for (const char* src = signatures; ; ++src) {
+        // Skip commas and whitespace
+        if (*src == ',' || *src == '\0') {
+            *word = '\0';
+            const SkaComponentTypeInfo* typeInfo = ska_ecs_component_find_type_info(typeNameBuffer);
+            SKA_ASSERT_FMT(typeInfo, "Unable to get type info for '%s'", typeNameBuffer);
+            signature |= typeInfo->type;
+            if (*src == '\0') {
+                break;
+            }
+            word = typeNameBuffer;
+            continue;
+        } else if (*src == ' ') {
+            continue;
+        }
+        *word++ = *src;
+    }
+    return signature;
+}
+
+//--- Component Batch ---//
+// Components created in a batch share one allocation per component type.  Each component is prefixed with a header
+// pointing back to its batch so components can still be removed individually, the batch is freed with its last component.
+typedef struct ComponentBatch {
+    usize refCount;
+} ComponentBatch;
+
+typedef union ComponentBatchItemHeader {
+    ComponentBatch* batch;
+    f64 alignValue;
+    uint64 alignInt;
+} ComponentBatchItemHeader;
+
+#define COMPONENT_BATCH_ALIGN(SIZE) (((SIZE) + sizeof(ComponentBatchItemHeader) - 1) / sizeof(ComponentBatchItemHeader) * sizeof(ComponentBatchItemHeader))
+
+static usize component_batch_get_item_stride(usize componentSize) {
+    return sizeof(ComponentBatchItemHeader) + COMPONENT_BATCH_ALIGN(componentSize);
+}
+
+static char* component_batch_create(usize componentSize, usize count) {
+    ComponentBatch* batch = (ComponentBatch*)SKA_ALLOC_BYTES(COMPONENT_BATCH_ALIGN(sizeof(ComponentBatch)) + component_batch_get_item_stride(componentSize) * count);
+    batch->refCount = count;
+    return (char*)batch + COMPONENT_BATCH_ALIGN(sizeof(ComponentBatch));
+}
+
+static void* component_batch_init_item(char* batchItems, usize componentSize, usize itemIndex) {
+    char* itemStart = batchItems + component_batch_get_item_stride(componentSize) * itemIndex;
+    ((ComponentBatchItemHeader*)itemStart)->batch = (ComponentBatch*)(batchItems - COMPONENT_BATCH_ALIGN(sizeof(ComponentBatch)));
+    return itemStart + sizeof(ComponentBatchItemHeader);
+}
+
+static void component_batch_release_item(void* component) {
+    ComponentBatch* batch = ((ComponentBatchItemHeader*)((char*)component - sizeof(ComponentBatchItemHeader)))->batch;
+    if (--batch->refCount == 0) {
+        SKA_FREE(batch);
+    }
+}
+
+#undef COMPONENT_BATCH_ALIGN
+
 //--- Component Array ---//
 typedef struct ComponentArray {
     void* components[SKA_ECS_MAX_COMPONENTS];
     SkaComponentType signature;
+    SkaComponentType batchAllocatedSignature; // Components that are owned by a component batch
+    uint32 changeTicks[SKA_ECS_MAX_COMPONENTS];
 } ComponentArray;
 
 static bool component_array_has_component(ComponentArray* componentArray, SkaComponentIndex index) {
@@ -62,18 +135,30 @@ static void* component_array_get_component(ComponentArray* componentArray, SkaCo
     return componentArray->components[index];
 }
 
-static void component_array_set_component(ComponentArray* componentArray, SkaComponentIndex index, void* component) {
-    componentArray->components[index] = component;
-}
-
 static void component_array_remove_component(ComponentArray* componentArray, SkaComponentIndex index) {
-    SKA_FREE(componentArray->components[index]);
+    const SkaComponentType type = (SkaComponentType)1 << index;
+    if (SKA_HAS_FLAG(componentArray->batchAllocatedSignature, type)) {
+        component_batch_release_item(componentArray->components[index]);
+        SKA_REMOVE_FLAGS(componentArray->batchAllocatedSignature, type);
+    } else {
+        SKA_FREE(componentArray->components[index]);
+    }
     componentArray->components[index] = NULL;
 }
 
+static void component_array_set_component(ComponentArray* componentArray, SkaComponentIndex index, void* component) {
+    // Batch allocated components are never owned by the caller, so release them when replaced
+    if (componentArray->components[index] != component && SKA_HAS_FLAG(componentArray->batchAllocatedSignature, (SkaComponentType)1 << index)) {
+        component_array_remove_component(componentArray, index);
+    }
+    componentArray->components[index] = component;
+}
+
 static void component_array_remove_all_components(ComponentArray* componentArray) {
     for (usize i = 0; i < SKA_ECS_MAX_COMPONENTS; i++) {
-        component_array_remove_component(componentArray, (SkaComponentIndex)i);
+        if (componentArray->components[i]) {
+            component_array_remove_component(componentArray, (SkaComponentIndex)i);
+        }
     }
     componentArray->signature = SKA_ECS_COMPONENT_TYPE_NONE;
 }
@@ -81,9 +166,13 @@ static void component_array_remove_all_components(ComponentArray* componentArray
 //--- Component Manager ---//
 typedef struct ComponentManager {
     SkaArrayList* componentArrays;
+    uint32 changeTick;
 } ComponentManager;
 
-static ComponentManager componentManager = { .componentArrays = NULL };
+// Change tick starts at 1 so components set before anything has run are newer than a zeroed tick
+#define SKA_ECS_COMPONENT_INITIAL_CHANGE_TICK 1
+
+static ComponentManager componentManager = { .componentArrays = NULL, .changeTick = SKA_ECS_COMPONENT_INITIAL_CHANGE_TICK };
 
 static SkaComponentType component_manager_translate_index_to_type(SkaComponentIndex index);
 
@@ -93,6 +182,7 @@ void ska_ecs_component_manager_initialize() {
 
     SKA_ASSERT_FMT(componentManager.componentArrays == NULL, "Component Manager's component arrays are not NULL when trying to initialize");
     componentManager.componentArrays = ska_array_list_create(sizeof(ComponentArray), 1000);
+    componentManager.changeTick = SKA_ECS_COMPONENT_INITIAL_CHANGE_TICK;
 }
 
 // Assumes component data was already deleted previously
@@ -108,73 +198,291 @@ void ska_ecs_component_manager_finalize() {
     ska_string_hash_map_destroy(componentNameToTypeMap);
     componentNameToTypeMap = NULL;
     globalComponentIndex = 0;
+    memset(componentSizes, 0, sizeof(componentSizes));
 
     SKA_ASSERT_FMT(componentManager.componentArrays != NULL, "Component Manager is NULL when trying to finalize...");
     ska_array_list_destroy(componentManager.componentArrays);
     componentManager.componentArrays = NULL;
 }
 
+// Component arrays are indexed by the entity's index only, a stale handle (index returned and possibly reused) would
+// otherwise access whatever entity has the index now
+#define SKA_ECS_COMPONENT_ASSERT_ALIVE(ENTITY) SKA_ASSERT_FMT(ska_ecs_entity_is_alive(ENTITY), "Entity '%u' isn't alive (stale or never created)!", (ENTITY))
+
 void* ska_ecs_component_manager_get_component(SkaEntity entity, SkaComponentIndex index) {
+    SKA_ECS_COMPONENT_ASSERT_ALIVE(entity);
     void* component = ska_ecs_component_manager_get_component_unchecked(entity, index);
     SKA_ASSERT_FMT(component != NULL, "Entity '%d' doesn't have '%s' component!", entity, ska_ecs_component_get_component_data_index_string(index));
     return component;
 }
 
 void* ska_ecs_component_manager_get_component_unchecked(SkaEntity entity, SkaComponentIndex index) {
-    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
+    if (!ska_ecs_entity_is_alive(entity)) {
+        return NULL;
+    }
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
     return component_array_get_component(componentArray, index);
 }
 
+void* ska_ecs_component_manager_get_component_mut(SkaEntity entity, SkaComponentIndex index) {
+    void* component = ska_ecs_component_manager_get_component(entity, index);
+    ska_ecs_component_manager_mark_changed(entity, index);
+    return component;
+}
+
 void ska_ecs_component_manager_set_component(SkaEntity entity, SkaComponentIndex index, void* component) {
+    if (!ska_ecs_entity_is_alive(entity)) {
+        SKA_ECS_COMPONENT_ASSERT_ALIVE(entity);
+        return;
+    }
     ska_ecs_component_manager_reserve(entity);
-    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    const SkaComponentType oldSignature = componentArray->signature;
     component_array_set_component(componentArray, index, component);
     componentArray->signature |= component_manager_translate_index_to_type(index);
+    ska_ecs_query_on_entity_signature_changed(entity, oldSignature, componentArray->signature);
+    // Adding a component counts as a change, done after the signature update so new query members are tracked
+    ska_ecs_component_manager_mark_changed(entity, index);
+}
+
+void ska_ecs_component_manager_set_components_batch(const SkaEntity* entities, usize count, SkaComponentType signature, const void* const* initData) {
+    if (count == 0) {
+        return;
+    }
+    SkaEntity lastEntity = entities[0];
+    for (usize i = 1; i < count; i++) {
+        if (SKA_ENTITY_GET_INDEX(entities[i]) > SKA_ENTITY_GET_INDEX(lastEntity)) {
+            lastEntity = entities[i];
+        }
+    }
+    ska_ecs_component_manager_reserve(lastEntity);
+    ComponentArray* componentArrays = (ComponentArray*)componentManager.componentArrays->data;
+    // Allocate and initialize each component type for the whole batch at once
+    for (SkaComponentIndex componentIndex = 0; componentIndex < SKA_ECS_MAX_COMPONENTS; componentIndex++) {
+        const SkaComponentType type = (SkaComponentType)1 << componentIndex;
+        if (!SKA_HAS_FLAG(signature, type)) {
+            continue;
+        }
+        const usize componentSize = componentSizes[componentIndex];
+        SKA_ASSERT_FMT(componentSize > 0, "Component index '%u' isn't registered!", componentIndex);
+        const void* componentInitData = initData ? initData[componentIndex] : NULL;
+        char* batchItems = component_batch_create(componentSize, count);
+        for (usize i = 0; i < count; i++) {
+            ComponentArray* componentArray = &componentArrays[SKA_ENTITY_GET_INDEX(entities[i])];
+            void* component = component_batch_init_item(batchItems, componentSize, i);
+            if (componentInitData) {
+                memcpy(component, componentInitData, componentSize);
+            } else {
+                memset(component, 0, componentSize);
+            }
+            if (componentArray->components[componentIndex]) {
+                component_array_remove_component(componentArray, componentIndex);
+            }
+            componentArray->components[componentIndex] = component;
+            componentArray->batchAllocatedSignature |= type;
+            componentArray->changeTicks[componentIndex] = componentManager.changeTick;
+        }
+    }
+    for (usize i = 0; i < count; i++) {
+        ComponentArray* componentArray = &componentArrays[SKA_ENTITY_GET_INDEX(entities[i])];
+        const SkaComponentType oldSignature = componentArray->signature;
+        componentArray->signature |= signature;
+        ska_ecs_query_on_entity_signature_changed(entities[i], oldSignature, componentArray->signature);
+        ska_ecs_query_on_entity_components_changed(entities[i], signature);
+    }
 }
 
 void ska_ecs_component_manager_remove_component(SkaEntity entity, SkaComponentIndex index) {
-    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
-    componentArray->signature &= component_manager_translate_index_to_type(index);
+    if (!ska_ecs_entity_is_alive(entity)) {
+        SKA_ECS_COMPONENT_ASSERT_ALIVE(entity);
+        return;
+    }
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    const SkaComponentType oldSignature = componentArray->signature;
+    componentArray->signature &= ~component_manager_translate_index_to_type(index);
     component_array_remove_component(componentArray, index);
+    ska_ecs_query_on_entity_signature_changed(entity, oldSignature, componentArray->signature);
 }
 
 void ska_ecs_component_manager_remove_all_components(SkaEntity entity) {
-    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
+    if (!ska_ecs_entity_is_alive(entity)) {
+        SKA_ECS_COMPONENT_ASSERT_ALIVE(entity);
+        return;
+    }
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    const SkaComponentType oldSignature = componentArray->signature;
     component_array_remove_all_components(componentArray);
+    ska_ecs_query_on_entity_signature_changed(entity, oldSignature, componentArray->signature);
 }
 
 bool ska_ecs_component_manager_has_component(SkaEntity entity, SkaComponentIndex index) {
-    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
+    if (!ska_ecs_entity_is_alive(entity)) {
+        return false;
+    }
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
     return component_array_has_component(componentArray, index);
 }
 
 void ska_ecs_component_manager_set_component_signature(SkaEntity entity, SkaComponentType componentTypeSignature) {
-    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    const SkaComponentType oldSignature = componentArray->signature;
     componentArray->signature = componentTypeSignature;
+    ska_ecs_query_on_entity_signature_changed(entity, oldSignature, componentTypeSignature);
 }
 
 SkaComponentType ska_ecs_component_manager_get_component_signature(SkaEntity entity) {
-    const ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)entity);
+    const ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
     return componentArray->signature;
 }
 
 void ska_ecs_component_manager_reserve(SkaEntity lastEntity) {
     // Add to component array if entity exceeds size
-    const usize newIndex = (usize)lastEntity;
-    while (componentManager.componentArrays->size <= newIndex) {
-        ska_array_list_push_back(componentManager.componentArrays, &(ComponentArray){0});
+    const usize newIndex = (usize)SKA_ENTITY_GET_INDEX(lastEntity);
+    if (componentManager.componentArrays->size <= newIndex) {
+        ska_array_list_resize(componentManager.componentArrays, newIndex + 1);
+    }
+}
+
+usize ska_ecs_component_manager_get_reserved_entity_count() {
+    return componentManager.componentArrays->size;
+}
+
+void ska_ecs_component_manager_mark_changed(SkaEntity entity, SkaComponentIndex index) {
+    if (!ska_ecs_entity_is_alive(entity)) {
+        SKA_ECS_COMPONENT_ASSERT_ALIVE(entity);
+        return;
     }
+    ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    componentArray->changeTicks[index] = componentManager.changeTick;
+    ska_ecs_query_on_entity_components_changed(entity, component_manager_translate_index_to_type(index));
+}
+
+uint32 ska_ecs_component_manager_get_component_change_tick(SkaEntity entity, SkaComponentIndex index) {
+    const ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    return componentArray->changeTicks[index];
+}
+
+bool ska_ecs_component_manager_has_changed_since(SkaEntity entity, SkaComponentType signature, uint32 tick) {
+    const ComponentArray* componentArray = ska_array_list_get(componentManager.componentArrays, (usize)SKA_ENTITY_GET_INDEX(entity));
+    SkaComponentType remainingTypes = signature & componentArray->signature;
+    for (SkaComponentIndex index = 0; remainingTypes != SKA_ECS_COMPONENT_TYPE_NONE; index++, remainingTypes >>= 1) {
+        // Compared through the signed difference so it still works after the tick wraps around
+        if ((remainingTypes & 1) && (int32)(componentArray->changeTicks[index] - tick) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32 ska_ecs_component_manager_get_change_tick() {
+    return componentManager.changeTick;
+}
+
+uint32 ska_ecs_component_manager_increment_change_tick() {
+    return ++componentManager.changeTick;
 }
 
 SkaComponentType component_manager_translate_index_to_type(SkaComponentIndex index) {
-    SKA_STRING_HASH_MAP_FOR_EACH(componentNameToTypeMap, iter) {
-        SkaStringHashMapNode* node = iter.pair;
-        const SkaComponentTypeInfo* typeInfo = (SkaComponentTypeInfo*)node->value;
-        if (typeInfo->index == index) {
-            return typeInfo->type;
+    // Component types are assigned as flags from their index on registration
+    return index < globalComponentIndex ? (SkaComponentType)1 << index : SKA_ECS_COMPONENT_TYPE_NONE;
+}
+
+// Layout: header, signatures and component masks for every reserved entity, then each entity's component bytes in component index order
+typedef struct ComponentSnapshotHeader {
+    usize reservedEntityCount;
+    usize componentSizes[SKA_ECS_MAX_COMPONENTS];
+} ComponentSnapshotHeader;
+
+// Components that are actually allocated, normally the same as the signature unless it was overridden
+static SkaComponentType component_array_get_component_mask(const ComponentArray* componentArray) {
+    SkaComponentType mask = SKA_ECS_COMPONENT_TYPE_NONE;
+    for (SkaComponentIndex index = 0; index < globalComponentIndex; index++) {
+        if (componentArray->components[index]) {
+            mask |= (SkaComponentType)1 << index;
         }
     }
-    return SKA_ECS_COMPONENT_TYPE_NONE;
+    return mask;
+}
+
+usize ska_ecs_component_manager_get_snapshot_size() {
+    const usize reservedEntityCount = componentManager.componentArrays->size;
+    const ComponentArray* componentArrays = (ComponentArray*)componentManager.componentArrays->data;
+    usize size = sizeof(ComponentSnapshotHeader) + reservedEntityCount * sizeof(SkaComponentType) * 2;
+    for (usize i = 0; i < reservedEntityCount; i++) {
+        const SkaComponentType mask = component_array_get_component_mask(&componentArrays[i]);
+        for (SkaComponentIndex index = 0; index < globalComponentIndex; index++) {
+            if (SKA_HAS_FLAG(mask, (SkaComponentType)1 << index)) {
+                size += componentSizes[index];
+            }
+        }
+    }
+    return size;
+}
+
+char* ska_ecs_component_manager_write_snapshot(char* buffer) {
+    ComponentSnapshotHeader header = { .reservedEntityCount = componentManager.componentArrays->size };
+    memcpy(header.componentSizes, componentSizes, sizeof(componentSizes));
+    memcpy(buffer, &header, sizeof(ComponentSnapshotHeader));
+    buffer += sizeof(ComponentSnapshotHeader);
+    const ComponentArray* componentArrays = (ComponentArray*)componentManager.componentArrays->data;
+    SkaComponentType* signatures = (SkaComponentType*)buffer;
+    SkaComponentType* masks = signatures + header.reservedEntityCount;
+    buffer = (char*)(masks + header.reservedEntityCount);
+    for (usize i = 0; i < header.reservedEntityCount; i++) {
+        const ComponentArray* componentArray = &componentArrays[i];
+        const SkaComponentType mask = component_array_get_component_mask(componentArray);
+        signatures[i] = componentArray->signature;
+        masks[i] = mask;
+        for (SkaComponentIndex index = 0; index < globalComponentIndex; index++) {
+            if (SKA_HAS_FLAG(mask, (SkaComponentType)1 << index)) {
+                memcpy(buffer, componentArray->components[index], componentSizes[index]);
+                buffer += componentSizes[index];
+            }
+        }
+    }
+    return buffer;
+}
+
+const char* ska_ecs_component_manager_read_snapshot(const char* buffer) {
+    ComponentSnapshotHeader header;
+    memcpy(&header, buffer, sizeof(ComponentSnapshotHeader));
+    SKA_ASSERT_FMT(memcmp(header.componentSizes, componentSizes, sizeof(componentSizes)) == 0, "Snapshot component types don't match the registered component types!");
+    buffer += sizeof(ComponentSnapshotHeader);
+    const SkaComponentType* signatures = (const SkaComponentType*)buffer;
+    const SkaComponentType* masks = signatures + header.reservedEntityCount;
+    buffer = (const char*)(masks + header.reservedEntityCount);
+    if (header.reservedEntityCount > 0) {
+        ska_ecs_component_manager_reserve((SkaEntity)(header.reservedEntityCount - 1));
+    }
+    ComponentArray* componentArrays = (ComponentArray*)componentManager.componentArrays->data;
+    for (usize i = 0; i < componentManager.componentArrays->size; i++) {
+        ComponentArray* componentArray = &componentArrays[i];
+        // Entities reserved after the snapshot was taken have no components
+        if (i >= header.reservedEntityCount) {
+            if (componentArray->signature != SKA_ECS_COMPONENT_TYPE_NONE || component_array_get_component_mask(componentArray) != SKA_ECS_COMPONENT_TYPE_NONE) {
+                component_array_remove_all_components(componentArray);
+            }
+            continue;
+        }
+        const SkaComponentType mask = masks[i];
+        for (SkaComponentIndex index = 0; index < globalComponentIndex; index++) {
+            const SkaComponentType type = (SkaComponentType)1 << index;
+            if (!SKA_HAS_FLAG(mask, type)) {
+                if (componentArray->components[index]) {
+                    component_array_remove_component(componentArray, index);
+                }
+                continue;
+            }
+            if (!componentArray->components[index]) {
+                componentArray->components[index] = SKA_ALLOC_BYTES(componentSizes[index]);
+            }
+            memcpy(componentArray->components[index], buffer, componentSizes[index]);
+            componentArray->changeTicks[index] = componentManager.changeTick;
+            buffer += componentSizes[index];
+        }
+        componentArray->signature = signatures[i];
+    }
+    return buffer;
 }
 
 const char* ska_ecs_component_get_component_data_index_string(SkaComponentIndex index) {
@@ -188,4 +496,6 @@ const char* ska_ecs_component_get_component_data_index_string(SkaComponentIndex
     return "INVALID";
 }
 
+#undef SKA_ECS_COMPONENT_ASSERT_ALIVE
+
 #endif // if SKA_ECS
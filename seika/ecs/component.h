@@ -36,19 +36,46 @@ const SkaComponentTypeInfo* ska_ecs_component_register_type(const char* name, us
 const SkaComponentTypeInfo* ska_ecs_component_get_type_info(const char* name, usize componentSize);
 const SkaComponentTypeInfo* ska_ecs_component_find_type_info(const char* name);
 SkaComponentType ska_ecs_component_get_type_flag(const char* name, usize componentSize);
+// Creates a signature from a comma separated list of registered component type names
+SkaComponentType ska_ecs_component_get_signature_from_string(const char* signatures);
 
 // --- Component Manager --- //
 void ska_ecs_component_manager_initialize();
 void ska_ecs_component_manager_finalize();
+// Entities must be alive, stale handles are caught by an assert and otherwise ignored (getters return NULL, 'has' returns false)
 void* ska_ecs_component_manager_get_component(SkaEntity entity, SkaComponentIndex index);
 void* ska_ecs_component_manager_get_component_unchecked(SkaEntity entity, SkaComponentIndex index); // No check, will probably consolidate later...
+// Same as 'ska_ecs_component_manager_get_component' but also marks the component as changed
+void* ska_ecs_component_manager_get_component_mut(SkaEntity entity, SkaComponentIndex index);
 void ska_ecs_component_manager_set_component(SkaEntity entity, SkaComponentIndex index, void* component);
+// Adds every component in 'signature' to all entities with a single allocation per component type.
+// 'initData' is indexed by component index and each component is copied from it, NULL entries (or a NULL 'initData') are zeroed.
+void ska_ecs_component_manager_set_components_batch(const SkaEntity* entities, usize count, SkaComponentType signature, const void* const* initData);
 void ska_ecs_component_manager_remove_component(SkaEntity entity, SkaComponentIndex index);
 void ska_ecs_component_manager_remove_all_components(SkaEntity entity);
 bool ska_ecs_component_manager_has_component(SkaEntity entity, SkaComponentIndex index);
 void ska_ecs_component_manager_set_component_signature(SkaEntity entity, SkaComponentType componentTypeSignature);
 SkaComponentType ska_ecs_component_manager_get_component_signature(SkaEntity entity);
 void ska_ecs_component_manager_reserve(SkaEntity lastEntity);
+usize ska_ecs_component_manager_get_reserved_entity_count();
+
+// --- Change Detection --- //
+// Every component stores the change tick it was last set or marked at.  The global change tick is advanced after each
+// system run so systems (and anything else holding on to a tick) can tell which components changed since they last looked.
+void ska_ecs_component_manager_mark_changed(SkaEntity entity, SkaComponentIndex index);
+uint32 ska_ecs_component_manager_get_component_change_tick(SkaEntity entity, SkaComponentIndex index);
+// Returns true if any component in 'signature' was changed after 'tick', ticks wrap so they must be less than 2^31 apart
+bool ska_ecs_component_manager_has_changed_since(SkaEntity entity, SkaComponentType signature, uint32 tick);
+uint32 ska_ecs_component_manager_get_change_tick();
+// Returns the new change tick
+uint32 ska_ecs_component_manager_increment_change_tick();
+
+// --- Snapshot --- //
+// Used by 'ska_ecs_snapshot_*'.  Write/read functions return the buffer advanced past the component data.
+// Restored components are marked as changed with the current change tick, queries are not updated.
+usize ska_ecs_component_manager_get_snapshot_size();
+char* ska_ecs_component_manager_write_snapshot(char* buffer);
+const char* ska_ecs_component_manager_read_snapshot(const char* buffer);
 
 const char* ska_ecs_component_get_component_data_index_string(SkaComponentIndex index);
 
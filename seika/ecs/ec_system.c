@@ -2,6 +2,8 @@
 
 #include "ec_system.h"
 
+#include <string.h>
+
 #include "seika/string.h"
 #include "seika/flag_utils.h"
 #include "seika/logger.h"
@@ -39,6 +41,17 @@ void ska_ecs_system_remove_entity_from_system(SkaEntity entity, SkaECSSystem* sy
 
 static EntitySystemData entitySystemData;
 
+// Components changed during a system's run are stamped with its 'this_run_tick', the tick is advanced afterwards so
+// anything changed later is newer than the run
+static inline void ecs_system_begin_run(SkaECSSystem* system) {
+    system->last_run_tick = system->this_run_tick;
+    system->this_run_tick = ska_ecs_component_manager_get_change_tick();
+}
+
+static inline void ecs_system_end_run() {
+    ska_ecs_component_manager_increment_change_tick();
+}
+
 void ska_ecs_system_initialize() {
     // Initialize system data to 0
     entitySystemData = (EntitySystemData){0};
@@ -86,28 +99,7 @@ SkaECSSystemTemplate ska_ecs_system_create_default_template(const char* systemNa
 
 static SkaECSSystem* update_system_with_type_signature_string(SkaECSSystem* system, const char* signatures) {
     // Take signature string, create flags, and add to system's component signature
-    static char typeNameBuffer[256];
-    char* word = typeNameBuffer;
-    char* start = word;
-    for (const char* src = signatures; *src != '\0'; ++src) {
-        // Skip commas and whitespace
-        if (*src == ',') {
-            *word = '\0';
-            const SkaComponentTypeInfo* typeInfo = ska_ecs_component_find_type_info(typeNameBuffer);
-            SKA_ASSERT_FMT(typeInfo, "Unable to get type info for '%s'", typeNameBuffer);
-            system->component_signature |= typeInfo->type;
-            word = start;
-            continue;
-        } else if (*src == ' ') {
-            continue;
-        }
-        *word++ = *src;
-    }
-
-    *word = '\0';
-    const SkaComponentTypeInfo* typeInfo = ska_ecs_component_find_type_info(typeNameBuffer);
-    SKA_ASSERT_FMT(typeInfo, "Unable to get type info for '%s'", typeNameBuffer);
-    system->component_signature |= typeInfo->type;
+    system->component_signature |= ska_ecs_component_get_signature_from_string(signatures);
     return system;
 }
 
@@ -186,6 +178,22 @@ void ska_ecs_system_update_entity_signature_with_systems(SkaEntity entity) {
     }
 }
 
+void ska_ecs_system_insert_new_entities(const SkaEntity* entities, usize count, SkaComponentType componentSignature) {
+    for (usize i = 0; i < entitySystemData.entity_systems_count; i++) {
+        SkaECSSystem* system = entitySystemData.entity_systems[i];
+        if (!SKA_FLAG_CONTAINS(componentSignature, system->component_signature)) {
+            continue;
+        }
+        // New entities can't already be in the system so skip the duplicate check and append all at once
+        ska_array_list_push_back_array(system->entities, entities, count);
+        if (system->on_entity_registered_func != NULL) {
+            for (usize entityIndex = 0; entityIndex < count; entityIndex++) {
+                system->on_entity_registered_func(system, entities[entityIndex]);
+            }
+        }
+    }
+}
+
 void ska_ecs_system_event_entity_start(SkaEntity entity) {
     const SkaComponentType entityComponentSignature = ska_ecs_component_manager_get_component_signature(entity);
     for (usize i = 0; i < entitySystemData.on_entity_start_systems_count; i++) {
@@ -221,35 +229,45 @@ void ska_ecs_system_event_entity_entered_scene(SkaEntity entity) {
 void ska_ecs_system_event_render_systems() {
     for (usize i = 0; i < entitySystemData.render_systems_count; i++) {
         SkaECSSystem* ecsSystem = entitySystemData.render_systems[i];
+        ecs_system_begin_run(ecsSystem);
         ecsSystem->render_func(ecsSystem);
+        ecs_system_end_run();
     }
 }
 
 void ska_ecs_system_event_pre_update_all_systems() {
     for (usize i = 0; i < entitySystemData.pre_update_all_systems_count; i++) {
         SkaECSSystem* ecsSystem = entitySystemData.pre_update_all_systems[i];
+        ecs_system_begin_run(ecsSystem);
         ecsSystem->pre_update_all_func(ecsSystem);
+        ecs_system_end_run();
     }
 }
 
 void ska_ecs_system_event_post_update_all_systems() {
     for (usize i = 0; i < entitySystemData.post_update_all_systems_count; i++) {
         SkaECSSystem* ecsSystem = entitySystemData.post_update_all_systems[i];
+        ecs_system_begin_run(ecsSystem);
         ecsSystem->post_update_all_func(ecsSystem);
+        ecs_system_end_run();
     }
 }
 
 void ska_ecs_system_event_update_systems(f32 deltaTime) {
     for (usize i = 0; i < entitySystemData.update_systems_count; i++) {
         SkaECSSystem* ecsSystem = entitySystemData.update_systems[i];
+        ecs_system_begin_run(ecsSystem);
         ecsSystem->update_func(ecsSystem, deltaTime);
+        ecs_system_end_run();
     }
 }
 
 void ska_ecs_system_event_fixed_update_systems(f32 deltaTime) {
     for (usize i = 0; i < entitySystemData.fixed_update_systems_count; i++) {
         SkaECSSystem* ecsSystem = entitySystemData.fixed_update_systems[i];
+        ecs_system_begin_run(ecsSystem);
         ecsSystem->fixed_update_func(ecsSystem, deltaTime);
+        ecs_system_end_run();
     }
 }
 
@@ -264,12 +282,86 @@ bool ska_ecs_system_has_entity(SkaEntity entity, SkaECSSystem* system) {
     return ska_array_list_has(system->entities, &entity);
 }
 
+bool ska_ecs_system_has_entity_changed(const SkaECSSystem* system, SkaEntity entity) {
+    const SkaComponentType changedSignature = system->changed_signature != SKA_ECS_COMPONENT_TYPE_NONE ? system->changed_signature : system->component_signature;
+    return ska_ecs_component_manager_has_changed_since(entity, changedSignature, system->last_run_tick);
+}
+
 void ska_ecs_system_remove_entity_from_all_systems(SkaEntity entity) {
     for (usize i = 0; i < entitySystemData.entity_systems_count; i++) {
         ska_ecs_system_remove_entity_from_system(entity, entitySystemData.entity_systems[i]);
     }
 }
 
+void ska_ecs_system_remove_entities_from_all_systems(const SkaEntity* entities, usize count) {
+    if (count == 0 || entitySystemData.entity_systems_count == 0) {
+        return;
+    }
+    // Flag removed entity indices so each system's entity list can be compacted in a single pass
+    uint32 maxIndex = 0;
+    for (usize i = 0; i < count; i++) {
+        if (SKA_ENTITY_GET_INDEX(entities[i]) > maxIndex) {
+            maxIndex = SKA_ENTITY_GET_INDEX(entities[i]);
+        }
+    }
+    bool* removedIndices = (bool*)SKA_ALLOC_BYTES_ZEROED(((usize)maxIndex + 1) * sizeof(bool));
+    for (usize i = 0; i < count; i++) {
+        removedIndices[SKA_ENTITY_GET_INDEX(entities[i])] = true;
+    }
+    for (usize i = 0; i < entitySystemData.entity_systems_count; i++) {
+        SkaArrayList* systemEntities = entitySystemData.entity_systems[i]->entities;
+        SkaEntity* systemEntityData = (SkaEntity*)systemEntities->data;
+        usize newSize = 0;
+        for (usize entityIndex = 0; entityIndex < systemEntities->size; entityIndex++) {
+            const uint32 index = SKA_ENTITY_GET_INDEX(systemEntityData[entityIndex]);
+            if (index > maxIndex || !removedIndices[index]) {
+                systemEntityData[newSize++] = systemEntityData[entityIndex];
+            }
+        }
+        systemEntities->size = newSize;
+    }
+    SKA_FREE(removedIndices);
+}
+
+// Layout: system count, then each registered system's entity count followed by its entities
+usize ska_ecs_system_get_snapshot_size() {
+    usize size = sizeof(usize);
+    for (usize i = 0; i < entitySystemData.entity_systems_count; i++) {
+        size += sizeof(usize) + entitySystemData.entity_systems[i]->entities->size * sizeof(SkaEntity);
+    }
+    return size;
+}
+
+char* ska_ecs_system_write_snapshot(char* buffer) {
+    memcpy(buffer, &entitySystemData.entity_systems_count, sizeof(usize));
+    buffer += sizeof(usize);
+    for (usize i = 0; i < entitySystemData.entity_systems_count; i++) {
+        const SkaArrayList* systemEntities = entitySystemData.entity_systems[i]->entities;
+        memcpy(buffer, &systemEntities->size, sizeof(usize));
+        buffer += sizeof(usize);
+        memcpy(buffer, systemEntities->data, systemEntities->size * sizeof(SkaEntity));
+        buffer += systemEntities->size * sizeof(SkaEntity);
+    }
+    return buffer;
+}
+
+const char* ska_ecs_system_read_snapshot(const char* buffer) {
+    usize systemCount;
+    memcpy(&systemCount, buffer, sizeof(usize));
+    buffer += sizeof(usize);
+    SKA_ASSERT_FMT(systemCount == entitySystemData.entity_systems_count, "Snapshot system count '%zu' doesn't match registered system count '%zu'!", systemCount, entitySystemData.entity_systems_count);
+    for (usize i = 0; i < systemCount; i++) {
+        SkaArrayList* systemEntities = entitySystemData.entity_systems[i]->entities;
+        usize entityCount;
+        memcpy(&entityCount, buffer, sizeof(usize));
+        buffer += sizeof(usize);
+        ska_array_list_resize(systemEntities, entityCount);
+        memcpy(systemEntities->data, buffer, entityCount * sizeof(SkaEntity));
+        buffer += entityCount * sizeof(SkaEntity);
+    }
+    return buffer;
+}
+
 // --- Internal Functions --- //
 
 void ska_ecs_system_insert_entity_into_system(SkaEntity entity, SkaECSSystem* system) {
@@ -17,6 +17,9 @@ ska_ecs_system_register(ska_ecs_system_create_from_template_with_signature_strin
 
 #define SKA_ECS_SYSTEM_ENTITIES_FOR(SYSTEM, VALUE) for(SkaEntity VALUE = *(SkaEntity*)((SYSTEM)->entities->data), *VALUE##_ptr = (SkaEntity*)((SYSTEM)->entities->data), *VALUE##_end = VALUE##_ptr + (SYSTEM)->entities->size; VALUE##_ptr < VALUE##_end; VALUE = *++VALUE##_ptr)
 
+// Same as 'SKA_ECS_SYSTEM_ENTITIES_FOR' but skips entities that haven't changed since the system's last run
+#define SKA_ECS_SYSTEM_CHANGED_ENTITIES_FOR(SYSTEM, VALUE) SKA_ECS_SYSTEM_ENTITIES_FOR(SYSTEM, VALUE) if (ska_ecs_system_has_entity_changed((SYSTEM), VALUE))
+
 struct SkaECSSystem;
 
 typedef void (*OnECSystemRegister) (struct SkaECSSystem*);
@@ -50,6 +53,9 @@ typedef struct SkaECSSystem {
     FixedUpdateFunc fixed_update_func;
     NetworkCallbackFunc network_callback_func;
     SkaComponentType component_signature;
+    SkaComponentType changed_signature; // Component types checked by 'ska_ecs_system_has_entity_changed', defaults to 'component_signature' when none
+    uint32 last_run_tick; // Change tick of the previous run of any of the system's frame callbacks
+    uint32 this_run_tick;
     SkaArrayList* entities;
 } SkaECSSystem;
 
@@ -99,7 +105,19 @@ void ska_ecs_system_destroy(SkaECSSystem* entitySystem);
 void ska_ecs_system_register(SkaECSSystem* system);
 void ska_ecs_system_update_entity_signature_with_systems(SkaEntity entity);
 void ska_ecs_system_remove_entity_from_all_systems(SkaEntity entity);
+// Adds newly created entities with the same component signature to all matching systems in one pass
+void ska_ecs_system_insert_new_entities(const SkaEntity* entities, usize count, SkaComponentType componentSignature);
+// Removes entities from all systems compacting each system's entity list once
+void ska_ecs_system_remove_entities_from_all_systems(const SkaEntity* entities, usize count);
 bool ska_ecs_system_has_entity(SkaEntity entity, SkaECSSystem* system);
+// Returns true if any of the entity's components in the system's 'changed_signature' changed since the system last ran.
+// Changes made by the system itself during its previous run are not included.
+bool ska_ecs_system_has_entity_changed(const SkaECSSystem* system, SkaEntity entity);
+
+// Snapshot support, used by 'ska_ecs_snapshot_*'.  Only system entity membership is stored, no callbacks are invoked on restore.
+usize ska_ecs_system_get_snapshot_size();
+char* ska_ecs_system_write_snapshot(char* buffer);
+const char* ska_ecs_system_read_snapshot(const char* buffer);
 
 // Event functions
 void ska_ecs_system_event_entity_start(SkaEntity entity);
@@ -6,12 +6,28 @@ void ska_ecs_initialize() {
     ska_ecs_entity_initialize();
     ska_ecs_system_initialize();
     ska_ecs_component_manager_initialize();
+    ska_ecs_query_initialize();
 }
 
 void ska_ecs_finalize() {
+    ska_ecs_query_finalize();
     ska_ecs_entity_finalize();
     ska_ecs_component_manager_finalize();
     ska_ecs_system_finalize();
 }
 
+void ska_ecs_spawn_batch(SkaComponentType signature, usize count, const void* const* initData, SkaEntity* outEntities) {
+    ska_ecs_entity_create_batch(outEntities, count);
+    ska_ecs_component_manager_set_components_batch(outEntities, count, signature, initData);
+    ska_ecs_system_insert_new_entities(outEntities, count, signature);
+}
+
+void ska_ecs_despawn_batch(const SkaEntity* entities, usize count) {
+    ska_ecs_system_remove_entities_from_all_systems(entities, count);
+    for (usize i = 0; i < count; i++) {
+        ska_ecs_component_manager_remove_all_components(entities[i]);
+    }
+    ska_ecs_entity_return_batch(entities, count);
+}
+
 #endif // if SKA_ECS
@@ -4,8 +4,15 @@
 
 // Including ecs related headers to simplify includes
 #include "ec_system.h"
+#include "query.h"
+#include "snapshot.h"
 
 void ska_ecs_initialize();
 void ska_ecs_finalize();
+// Creates 'count' entities with all components in 'signature' and registers them with matching systems.
+// 'initData' is indexed by component index (NULL entries zero initialize), 'outEntities' must hold 'count' entities.
+void ska_ecs_spawn_batch(SkaComponentType signature, usize count, const void* const* initData, SkaEntity* outEntities);
+// Removes entities from all systems, deletes their components, and returns them to the entity queue
+void ska_ecs_despawn_batch(const SkaEntity* entities, usize count);
 
 #endif // if SKA_ECS
\ No newline at end of file
@@ -1,42 +1,171 @@
 #if SKA_ECS
 
 #include "entity.h"
-#include "seika/data_structures/id_queue.h"
+
+#include <string.h>
+
+#include "seika/memory.h"
 #include "seika/assert.h"
 
 #define SKA_INITIAL_ENTITY_CAPACITY 1000
+#define SKA_ENTITY_CAPACITY_CHUNK_SIZE 1024
+// Recycled indices are only reused once this many are free, delays generation wrap around for frequently churned indices
+#define SKA_ENTITY_MIN_FREE_INDICES 1024
+// Set on a slot's generation while the index is in the free list
+#define SKA_ENTITY_SLOT_FREE_FLAG 0x8000
 
-static SkaIdQueue* entityIdQueue = NULL;
+// Generations are stored per index, freed indices are kept in a fifo ring buffer that is the same size as the slot capacity
+typedef struct EntitySlots {
+    uint16* generations;
+    uint32* freeIndices;
+    usize freeFront;
+    usize freeCount;
+    usize capacity;
+    usize nextUnusedIndex; // Indices at or above this haven't been handed out yet
+} EntitySlots;
+
+static EntitySlots entitySlots = { .generations = NULL, .freeIndices = NULL, .freeFront = 0, .freeCount = 0, .capacity = 0, .nextUnusedIndex = 0 };
 static usize activeEntityCount = 0;
 
+// Grows slot storage without touching existing slots, only the newly added generations are zeroed
+static void entity_slots_grow(usize newCapacity) {
+    SKA_ASSERT_FMT(newCapacity <= (usize)SKA_ENTITY_MAX_INDEX + 1, "Exceeded max entity count of '%u'", SKA_ENTITY_MAX_INDEX + 1);
+    const usize prevCapacity = entitySlots.capacity;
+    entitySlots.generations = (uint16*)ska_mem_reallocate(entitySlots.generations, newCapacity * sizeof(uint16));
+    memset(entitySlots.generations + prevCapacity, 0, (newCapacity - prevCapacity) * sizeof(uint16));
+    entitySlots.freeIndices = (uint32*)ska_mem_reallocate(entitySlots.freeIndices, newCapacity * sizeof(uint32));
+    // Unwrap the part of the ring buffer that wrapped around to the front
+    const usize wrappedCount = entitySlots.freeFront + entitySlots.freeCount > prevCapacity ? entitySlots.freeFront + entitySlots.freeCount - prevCapacity : 0;
+    for (usize i = 0; i < wrappedCount; i++) {
+        entitySlots.freeIndices[(prevCapacity + i) % newCapacity] = entitySlots.freeIndices[i];
+    }
+    entitySlots.capacity = newCapacity;
+}
+
 void ska_ecs_entity_initialize() {
-    SKA_ASSERT(entityIdQueue == NULL);
-    entityIdQueue = ska_id_queue_create(SKA_INITIAL_ENTITY_CAPACITY);
+    SKA_ASSERT(entitySlots.generations == NULL);
+    entity_slots_grow(SKA_INITIAL_ENTITY_CAPACITY);
 }
 
 void ska_ecs_entity_finalize() {
-    SKA_ASSERT(entityIdQueue);
-    ska_id_queue_destroy(entityIdQueue);
-    entityIdQueue = NULL;
+    SKA_ASSERT(entitySlots.generations);
+    SKA_FREE(entitySlots.generations);
+    SKA_FREE(entitySlots.freeIndices);
+    entitySlots = (EntitySlots){0};
     activeEntityCount = 0;
 }
 
-SkaEntity ska_ecs_entity_create() {
-    SKA_ASSERT(entityIdQueue);
-    SkaEntity newEntity;
-    ska_id_queue_dequeue(entityIdQueue, &newEntity);
+static inline SkaEntity entity_create_from_reserved_slots() {
+    uint32 index;
+    if (entitySlots.freeCount > SKA_ENTITY_MIN_FREE_INDICES || (entitySlots.freeCount > 0 && entitySlots.nextUnusedIndex > SKA_ENTITY_MAX_INDEX)) {
+        index = entitySlots.freeIndices[entitySlots.freeFront];
+        entitySlots.freeFront = (entitySlots.freeFront + 1) % entitySlots.capacity;
+        entitySlots.freeCount--;
+        entitySlots.generations[index] &= (uint16)~SKA_ENTITY_SLOT_FREE_FLAG;
+    } else {
+        SKA_ASSERT(entitySlots.nextUnusedIndex < entitySlots.capacity);
+        index = (uint32)entitySlots.nextUnusedIndex++;
+    }
     activeEntityCount++;
-    return newEntity;
+    return SKA_ENTITY_MAKE(index, entitySlots.generations[index]);
+}
+
+// Makes sure 'count' entities can be created without growing in between
+static void entity_slots_reserve(usize count) {
+    const usize maxCapacity = (usize)SKA_ENTITY_MAX_INDEX + 1;
+    if (entitySlots.nextUnusedIndex + count <= entitySlots.capacity || entitySlots.capacity >= maxCapacity) {
+        return;
+    }
+    const usize requiredCapacity = entitySlots.nextUnusedIndex + count;
+    const usize newCapacity = (requiredCapacity + SKA_ENTITY_CAPACITY_CHUNK_SIZE - 1) / SKA_ENTITY_CAPACITY_CHUNK_SIZE * SKA_ENTITY_CAPACITY_CHUNK_SIZE;
+    entity_slots_grow(newCapacity < maxCapacity ? newCapacity : maxCapacity);
+}
+
+SkaEntity ska_ecs_entity_create() {
+    SKA_ASSERT(entitySlots.generations);
+    entity_slots_reserve(1);
+    return entity_create_from_reserved_slots();
+}
+
+void ska_ecs_entity_create_batch(SkaEntity* outEntities, usize count) {
+    SKA_ASSERT(entitySlots.generations);
+    entity_slots_reserve(count);
+    for (usize i = 0; i < count; i++) {
+        outEntities[i] = entity_create_from_reserved_slots();
+    }
 }
 
 void ska_ecs_entity_return(SkaEntity entity) {
-    SKA_ASSERT(entityIdQueue);
-    ska_id_queue_enqueue(entityIdQueue, entity);
+    SKA_ASSERT_FMT(ska_ecs_entity_is_alive(entity), "Returning entity '%u' that isn't alive!", entity);
+    const uint32 index = SKA_ENTITY_GET_INDEX(entity);
+    entitySlots.generations[index] = (uint16)(((entitySlots.generations[index] + 1) & SKA_ENTITY_GENERATION_MASK) | SKA_ENTITY_SLOT_FREE_FLAG);
+    entitySlots.freeIndices[(entitySlots.freeFront + entitySlots.freeCount) % entitySlots.capacity] = index;
+    entitySlots.freeCount++;
     activeEntityCount--;
 }
 
+void ska_ecs_entity_return_batch(const SkaEntity* entities, usize count) {
+    for (usize i = 0; i < count; i++) {
+        ska_ecs_entity_return(entities[i]);
+    }
+}
+
+bool ska_ecs_entity_is_alive(SkaEntity entity) {
+    const uint32 index = SKA_ENTITY_GET_INDEX(entity);
+    return entity != SKA_NULL_ENTITY && index < entitySlots.nextUnusedIndex && (uint32)entitySlots.generations[index] == SKA_ENTITY_GET_GENERATION(entity);
+}
+
+SkaEntity ska_ecs_entity_get_from_index(uint32 index) {
+    SKA_ASSERT(index < entitySlots.capacity);
+    return SKA_ENTITY_MAKE(index, entitySlots.generations[index] & SKA_ENTITY_GENERATION_MASK);
+}
+
 usize ska_ecs_entity_get_active_count() {
     return activeEntityCount;
 }
 
+// Layout: header, generations for every handed out index, then the free index ring unwrapped starting from the front
+typedef struct EntitySnapshotHeader {
+    usize nextUnusedIndex;
+    usize freeCount;
+    usize activeEntityCount;
+} EntitySnapshotHeader;
+
+usize ska_ecs_entity_get_snapshot_size() {
+    return sizeof(EntitySnapshotHeader) + entitySlots.nextUnusedIndex * sizeof(uint16) + entitySlots.freeCount * sizeof(uint32);
+}
+
+char* ska_ecs_entity_write_snapshot(char* buffer) {
+    const EntitySnapshotHeader header = { .nextUnusedIndex = entitySlots.nextUnusedIndex, .freeCount = entitySlots.freeCount, .activeEntityCount = activeEntityCount };
+    memcpy(buffer, &header, sizeof(EntitySnapshotHeader));
+    buffer += sizeof(EntitySnapshotHeader);
+    memcpy(buffer, entitySlots.generations, header.nextUnusedIndex * sizeof(uint16));
+    buffer += header.nextUnusedIndex * sizeof(uint16);
+    const usize firstPartCount = entitySlots.freeFront + header.freeCount > entitySlots.capacity ? entitySlots.capacity - entitySlots.freeFront : header.freeCount;
+    memcpy(buffer, entitySlots.freeIndices + entitySlots.freeFront, firstPartCount * sizeof(uint32));
+    memcpy(buffer + firstPartCount * sizeof(uint32), entitySlots.freeIndices, (header.freeCount - firstPartCount) * sizeof(uint32));
+    return buffer + header.freeCount * sizeof(uint32);
+}
+
+const char* ska_ecs_entity_read_snapshot(const char* buffer) {
+    EntitySnapshotHeader header;
+    memcpy(&header, buffer, sizeof(EntitySnapshotHeader));
+    buffer += sizeof(EntitySnapshotHeader);
+    if (header.nextUnusedIndex > entitySlots.capacity) {
+        entity_slots_reserve(header.nextUnusedIndex - entitySlots.nextUnusedIndex);
+    }
+    memcpy(entitySlots.generations, buffer, header.nextUnusedIndex * sizeof(uint16));
+    buffer += header.nextUnusedIndex * sizeof(uint16);
+    // Indices handed out after the snapshot go back to their initial state so the same ids are created again
+    if (entitySlots.nextUnusedIndex > header.nextUnusedIndex) {
+        memset(entitySlots.generations + header.nextUnusedIndex, 0, (entitySlots.nextUnusedIndex - header.nextUnusedIndex) * sizeof(uint16));
+    }
+    memcpy(entitySlots.freeIndices, buffer, header.freeCount * sizeof(uint32));
+    entitySlots.freeFront = 0;
+    entitySlots.freeCount = header.freeCount;
+    entitySlots.nextUnusedIndex = header.nextUnusedIndex;
+    activeEntityCount = header.activeEntityCount;
+    return buffer + header.freeCount * sizeof(uint32);
+}
+
 #endif // if SKA_ECS
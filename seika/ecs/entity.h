@@ -4,16 +4,40 @@
 
 #include "seika/defines.h"
 
-// Entity is defined as a unsigned 32-bit integer
+// Entity is defined as a unsigned 32-bit integer which packs an index (lower bits) and a generation (upper bits).
+// The generation is incremented every time an index is returned so stale entity ids can be detected.
 typedef uint32 SkaEntity;
 #define SKA_NULL_ENTITY (SkaEntity)-1
 
+#define SKA_ENTITY_INDEX_BITS 20
+#define SKA_ENTITY_GENERATION_BITS 12
+#define SKA_ENTITY_INDEX_MASK ((1u << SKA_ENTITY_INDEX_BITS) - 1)
+#define SKA_ENTITY_GENERATION_MASK ((1u << SKA_ENTITY_GENERATION_BITS) - 1)
+// Last index is reserved so that 'SKA_NULL_ENTITY' is never a valid id
+#define SKA_ENTITY_MAX_INDEX (SKA_ENTITY_INDEX_MASK - 1)
+
+#define SKA_ENTITY_GET_INDEX(ENTITY) ((uint32)(ENTITY) & SKA_ENTITY_INDEX_MASK)
+#define SKA_ENTITY_GET_GENERATION(ENTITY) (((uint32)(ENTITY) >> SKA_ENTITY_INDEX_BITS) & SKA_ENTITY_GENERATION_MASK)
+#define SKA_ENTITY_MAKE(INDEX, GENERATION) ((SkaEntity)(((uint32)(GENERATION) & SKA_ENTITY_GENERATION_MASK) << SKA_ENTITY_INDEX_BITS | ((uint32)(INDEX) & SKA_ENTITY_INDEX_MASK)))
+
 void ska_ecs_entity_initialize();
 void ska_ecs_entity_finalize();
 // Pops entity from the queue
 SkaEntity ska_ecs_entity_create();
+// Pops 'count' entities from the queue, slot storage is only grown once
+void ska_ecs_entity_create_batch(SkaEntity* outEntities, usize count);
 // Push entity to the queue
 void ska_ecs_entity_return(SkaEntity entity);
+void ska_ecs_entity_return_batch(const SkaEntity* entities, usize count);
+// Returns true if the entity was created and not returned yet, a recycled index with an older generation is not alive
+bool ska_ecs_entity_is_alive(SkaEntity entity);
+// Returns the current entity id (with generation) for an index
+SkaEntity ska_ecs_entity_get_from_index(uint32 index);
 usize ska_ecs_entity_get_active_count();
 
+// Snapshot support, used by 'ska_ecs_snapshot_*'.  Write/read functions return the buffer advanced past the entity data.
+usize ska_ecs_entity_get_snapshot_size();
+char* ska_ecs_entity_write_snapshot(char* buffer);
+const char* ska_ecs_entity_read_snapshot(const char* buffer);
+
 #endif // if SKA_ECS
@@ -0,0 +1,266 @@
+#if SKA_ECS
+
+#include "query.h"
+
+#include "seika/flag_utils.h"
+#include "seika/memory.h"
+#include "seika/assert.h"
+
+#define SKA_ECS_QUERY_INITIAL_CAPACITY 64
+#define SKA_ECS_QUERY_INVALID_INDEX ((uint32)-1)
+
+typedef struct QueryData {
+    SkaECSQuery* queries[SKA_ECS_MAX_QUERIES];
+    usize queryCount;
+    SkaComponentType changeTrackedSignature; // Union of all queries' 'changedSignature', skips change notifications nobody listens to
+} QueryData;
+
+static QueryData queryData = { .queryCount = 0 };
+
+// Entities without components are never part of a query, otherwise queries without a 'with' signature would match free
+// slots and entities that are being despawned (which lose all their components first)
+static inline bool query_matches_entity_signature(const SkaECSQuery* query, SkaComponentType signature) {
+    return signature != SKA_ECS_COMPONENT_TYPE_NONE && ska_ecs_query_matches_signature(query, signature);
+}
+
+static void query_ensure_entity_index_capacity(SkaECSQuery* query, SkaEntity entity) {
+    const usize index = (usize)SKA_ENTITY_GET_INDEX(entity);
+    if (index < query->entityIndicesCapacity) {
+        return;
+    }
+    usize newCapacity = query->entityIndicesCapacity > 0 ? query->entityIndicesCapacity : SKA_ECS_QUERY_INITIAL_CAPACITY;
+    while (newCapacity <= index) {
+        newCapacity *= 2;
+    }
+    query->entityIndices = ska_mem_reallocate(query->entityIndices, newCapacity * sizeof(uint32));
+    for (usize i = query->entityIndicesCapacity; i < newCapacity; i++) {
+        query->entityIndices[i] = SKA_ECS_QUERY_INVALID_INDEX;
+    }
+    query->entityIndicesCapacity = newCapacity;
+}
+
+static void query_add_changed_entity(SkaECSQuery* query, uint32 entityPosition) {
+    if (query->changedIndices[entityPosition] != SKA_ECS_QUERY_INVALID_INDEX) {
+        return;
+    }
+    query->changedIndices[entityPosition] = (uint32)query->changedEntityCount;
+    query->changedEntities[query->changedEntityCount++] = query->entities[entityPosition];
+}
+
+static void query_remove_changed_entity(SkaECSQuery* query, uint32 entityPosition) {
+    const uint32 removedIndex = query->changedIndices[entityPosition];
+    if (removedIndex == SKA_ECS_QUERY_INVALID_INDEX) {
+        return;
+    }
+    const SkaEntity lastEntity = query->changedEntities[--query->changedEntityCount];
+    query->changedEntities[removedIndex] = lastEntity;
+    query->changedIndices[query->entityIndices[SKA_ENTITY_GET_INDEX(lastEntity)]] = removedIndex;
+    query->changedIndices[entityPosition] = SKA_ECS_QUERY_INVALID_INDEX;
+}
+
+static void query_add_entity(SkaECSQuery* query, SkaEntity entity) {
+    query_ensure_entity_index_capacity(query, entity);
+    if (query->entityIndices[SKA_ENTITY_GET_INDEX(entity)] != SKA_ECS_QUERY_INVALID_INDEX) {
+        return;
+    }
+    if (query->entityCount >= query->entityCapacity) {
+        query->entityCapacity *= 2;
+        query->entities = ska_mem_reallocate(query->entities, query->entityCapacity * sizeof(SkaEntity));
+        if (query->changedEntities) {
+            query->changedEntities = ska_mem_reallocate(query->changedEntities, query->entityCapacity * sizeof(SkaEntity));
+            query->changedIndices = ska_mem_reallocate(query->changedIndices, query->entityCapacity * sizeof(uint32));
+        }
+    }
+    query->entityIndices[SKA_ENTITY_GET_INDEX(entity)] = (uint32)query->entityCount;
+    if (query->changedIndices) {
+        query->changedIndices[query->entityCount] = SKA_ECS_QUERY_INVALID_INDEX;
+    }
+    query->entities[query->entityCount++] = entity;
+}
+
+// Swaps the last entity into the removed entity's slot so removal is O(1)
+static void query_remove_entity(SkaECSQuery* query, SkaEntity entity) {
+    if (!ska_ecs_query_has_entity(query, entity)) {
+        return;
+    }
+    const uint32 removedIndex = query->entityIndices[SKA_ENTITY_GET_INDEX(entity)];
+    const uint32 lastIndex = (uint32)--query->entityCount;
+    const SkaEntity lastEntity = query->entities[lastIndex];
+    if (query->changedIndices) {
+        query_remove_changed_entity(query, removedIndex);
+        query->changedIndices[removedIndex] = query->changedIndices[lastIndex];
+    }
+    query->entities[removedIndex] = lastEntity;
+    query->entityIndices[SKA_ENTITY_GET_INDEX(lastEntity)] = removedIndex;
+    query->entityIndices[SKA_ENTITY_GET_INDEX(entity)] = SKA_ECS_QUERY_INVALID_INDEX;
+}
+
+static void query_mark_all_changed(SkaECSQuery* query) {
+    query->changedEntityCount = 0;
+    for (usize i = 0; i < query->entityCount; i++) {
+        query->changedIndices[i] = SKA_ECS_QUERY_INVALID_INDEX;
+        query_add_changed_entity(query, (uint32)i);
+    }
+}
+
+static void query_update_change_tracked_signature() {
+    queryData.changeTrackedSignature = SKA_ECS_COMPONENT_TYPE_NONE;
+    for (usize i = 0; i < queryData.queryCount; i++) {
+        queryData.changeTrackedSignature |= queryData.queries[i]->changedSignature;
+    }
+}
+
+static void query_rebuild(SkaECSQuery* query) {
+    for (usize i = 0; i < query->entityCount; i++) {
+        query->entityIndices[SKA_ENTITY_GET_INDEX(query->entities[i])] = SKA_ECS_QUERY_INVALID_INDEX;
+    }
+    query->entityCount = 0;
+    query->changedEntityCount = 0;
+    const usize entityArraySize = ska_ecs_component_manager_get_reserved_entity_count();
+    for (usize i = 0; i < entityArraySize; i++) {
+        const SkaEntity entity = ska_ecs_entity_get_from_index((uint32)i);
+        if (ska_ecs_entity_is_alive(entity) && query_matches_entity_signature(query, ska_ecs_component_manager_get_component_signature(entity))) {
+            query_add_entity(query, entity);
+        }
+    }
+    // What changed before the rebuild is unknown, so every entity counts as changed
+    if (query->changedIndices) {
+        query_mark_all_changed(query);
+    }
+}
+
+void ska_ecs_query_initialize() {
+    queryData = (QueryData){0};
+}
+
+void ska_ecs_query_finalize() {
+    while (queryData.queryCount > 0) {
+        ska_ecs_query_destroy(queryData.queries[queryData.queryCount - 1]);
+    }
+}
+
+SkaECSQuery* ska_ecs_query_create(SkaComponentType signature) {
+    return ska_ecs_query_create_with_filter(signature, SKA_ECS_COMPONENT_TYPE_NONE);
+}
+
+SkaECSQuery* ska_ecs_query_create_with_filter(SkaComponentType withSignature, SkaComponentType withoutSignature) {
+    SKA_ASSERT_FMT(queryData.queryCount < SKA_ECS_MAX_QUERIES, "At query limit of '%d'", SKA_ECS_MAX_QUERIES);
+    SKA_ASSERT_FMT(SKA_HAS_NONE_OF_FLAGS(withSignature, withoutSignature), "Query 'with' and 'without' signatures overlap!");
+    SkaECSQuery* query = SKA_ALLOC_ZEROED(SkaECSQuery);
+    query->withSignature = withSignature;
+    query->withoutSignature = withoutSignature;
+    query->entityCapacity = SKA_ECS_QUERY_INITIAL_CAPACITY;
+    query->entities = SKA_ALLOC_BYTES(query->entityCapacity * sizeof(SkaEntity));
+    query_rebuild(query);
+    queryData.queries[queryData.queryCount++] = query;
+    return query;
+}
+
+SkaECSQuery* ska_ecs_query_create_with_signature_string(const char* signatures) {
+    return ska_ecs_query_create(ska_ecs_component_get_signature_from_string(signatures));
+}
+
+void ska_ecs_query_destroy(SkaECSQuery* query) {
+    for (usize i = 0; i < queryData.queryCount; i++) {
+        if (queryData.queries[i] == query) {
+            queryData.queries[i] = queryData.queries[--queryData.queryCount];
+            queryData.queries[queryData.queryCount] = NULL;
+            break;
+        }
+    }
+    query_update_change_tracked_signature();
+    SKA_FREE(query->entities);
+    if (query->entityIndices) {
+        SKA_FREE(query->entityIndices);
+    }
+    if (query->changedEntities) {
+        SKA_FREE(query->changedEntities);
+        SKA_FREE(query->changedIndices);
+    }
+    SKA_FREE(query);
+}
+
+void ska_ecs_query_set_without(SkaECSQuery* query, SkaComponentType withoutSignature) {
+    SKA_ASSERT_FMT(SKA_HAS_NONE_OF_FLAGS(query->withSignature, withoutSignature), "Query 'with' and 'without' signatures overlap!");
+    query->withoutSignature = withoutSignature;
+    query_rebuild(query);
+}
+
+bool ska_ecs_query_has_entity(const SkaECSQuery* query, SkaEntity entity) {
+    const uint32 index = SKA_ENTITY_GET_INDEX(entity);
+    return (usize)index < query->entityIndicesCapacity && query->entityIndices[index] != SKA_ECS_QUERY_INVALID_INDEX && query->entities[query->entityIndices[index]] == entity;
+}
+
+bool ska_ecs_query_matches_signature(const SkaECSQuery* query, SkaComponentType signature) {
+    return SKA_FLAG_CONTAINS(signature, query->withSignature) && SKA_HAS_NO_FLAG(signature, query->withoutSignature);
+}
+
+usize ska_ecs_query_get_entity_count(const SkaECSQuery* query) {
+    return query->entityCount;
+}
+
+void ska_ecs_query_set_changed(SkaECSQuery* query, SkaComponentType changedSignature) {
+    SKA_ASSERT_FMT(SKA_FLAG_CONTAINS(query->withSignature, changedSignature), "Query 'changed' signature must be part of the 'with' signature!");
+    query->changedSignature = changedSignature;
+    if (!query->changedEntities) {
+        query->changedEntities = SKA_ALLOC_BYTES(query->entityCapacity * sizeof(SkaEntity));
+        query->changedIndices = SKA_ALLOC_BYTES(query->entityCapacity * sizeof(uint32));
+    }
+    query_mark_all_changed(query);
+    query_update_change_tracked_signature();
+}
+
+bool ska_ecs_query_has_changed_entity(const SkaECSQuery* query, SkaEntity entity) {
+    return query->changedIndices && ska_ecs_query_has_entity(query, entity) && query->changedIndices[query->entityIndices[SKA_ENTITY_GET_INDEX(entity)]] != SKA_ECS_QUERY_INVALID_INDEX;
+}
+
+usize ska_ecs_query_get_changed_entity_count(const SkaECSQuery* query) {
+    return query->changedEntityCount;
+}
+
+void ska_ecs_query_clear_changed(SkaECSQuery* query) {
+    for (usize i = 0; i < query->changedEntityCount; i++) {
+        query->changedIndices[query->entityIndices[SKA_ENTITY_GET_INDEX(query->changedEntities[i])]] = SKA_ECS_QUERY_INVALID_INDEX;
+    }
+    query->changedEntityCount = 0;
+}
+
+void ska_ecs_query_rebuild_all() {
+    for (usize i = 0; i < queryData.queryCount; i++) {
+        query_rebuild(queryData.queries[i]);
+    }
+}
+
+void ska_ecs_query_on_entity_signature_changed(SkaEntity entity, SkaComponentType oldSignature, SkaComponentType newSignature) {
+    if (oldSignature == newSignature) {
+        return;
+    }
+    for (usize i = 0; i < queryData.queryCount; i++) {
+        SkaECSQuery* query = queryData.queries[i];
+        const bool didMatch = query_matches_entity_signature(query, oldSignature);
+        const bool doesMatch = query_matches_entity_signature(query, newSignature);
+        if (doesMatch && !didMatch) {
+            query_add_entity(query, entity);
+            // Entities entering a change tracking query start out as changed
+            if (query->changedIndices) {
+                query_add_changed_entity(query, (uint32)query->entityCount - 1);
+            }
+        } else if (didMatch && !doesMatch) {
+            query_remove_entity(query, entity);
+        }
+    }
+}
+
+void ska_ecs_query_on_entity_components_changed(SkaEntity entity, SkaComponentType changedTypes) {
+    if (SKA_HAS_NO_FLAG(queryData.changeTrackedSignature, changedTypes)) {
+        return;
+    }
+    for (usize i = 0; i < queryData.queryCount; i++) {
+        SkaECSQuery* query = queryData.queries[i];
+        if (SKA_HAS_FLAG(query->changedSignature, changedTypes) && ska_ecs_query_has_entity(query, entity)) {
+            query_add_changed_entity(query, query->entityIndices[SKA_ENTITY_GET_INDEX(entity)]);
+        }
+    }
+}
+
+#endif // if SKA_ECS
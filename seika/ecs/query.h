@@ -0,0 +1,73 @@
+#pragma once
+
+#if SKA_ECS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "component.h"
+
+#define SKA_ECS_MAX_QUERIES 32
+
+// Creates a query from component type names, e.g. 'SKA_ECS_QUERY_CREATE(Transform2DComponent, SpriteComponent)'
+#define SKA_ECS_QUERY_CREATE(...) \
+ska_ecs_query_create_with_signature_string(#__VA_ARGS__)
+
+// Iterates over all entities currently matching the query.  Changing component signatures while iterating may skip entities.
+#define SKA_ECS_QUERY_FOR_EACH(QUERY, VALUE) for(SkaEntity VALUE = (QUERY)->entityCount > 0 ? (QUERY)->entities[0] : SKA_NULL_ENTITY, *VALUE##_ptr = (QUERY)->entities, *VALUE##_end = VALUE##_ptr + (QUERY)->entityCount; VALUE##_ptr < VALUE##_end; VALUE = ++VALUE##_ptr < VALUE##_end ? *VALUE##_ptr : SKA_NULL_ENTITY)
+
+// Iterates over matching entities that had a component in the query's 'changedSignature' set or marked since the last 'ska_ecs_query_clear_changed'
+#define SKA_ECS_QUERY_FOR_EACH_CHANGED(QUERY, VALUE) for(SkaEntity VALUE = (QUERY)->changedEntityCount > 0 ? (QUERY)->changedEntities[0] : SKA_NULL_ENTITY, *VALUE##_ptr = (QUERY)->changedEntities, *VALUE##_end = VALUE##_ptr + (QUERY)->changedEntityCount; VALUE##_ptr < VALUE##_end; VALUE = ++VALUE##_ptr < VALUE##_end ? *VALUE##_ptr : SKA_NULL_ENTITY)
+
+// Caches the list of entities whose component signature contains all 'withSignature' flags and none of the 'withoutSignature' flags.
+// The list is updated incrementally by the component manager whenever an entity's signature changes.  Entities without any
+// components aren't part of any query, including queries with an empty 'withSignature'.
+// Queries with a 'changedSignature' also keep a list of matching entities whose components in that signature changed,
+// so consumers only have to visit what changed rather than every matching entity.
+typedef struct SkaECSQuery {
+    SkaComponentType withSignature;
+    SkaComponentType withoutSignature;
+    SkaComponentType changedSignature;
+    SkaEntity* entities; // Dense array of matching entities
+    usize entityCount;
+    usize entityCapacity;
+    uint32* entityIndices; // Sparse array mapping an entity index to its position within 'entities'
+    usize entityIndicesCapacity;
+    SkaEntity* changedEntities; // Dense array of changed matching entities
+    usize changedEntityCount;
+    uint32* changedIndices; // Parallel to 'entities', position within 'changedEntities'
+} SkaECSQuery;
+
+void ska_ecs_query_initialize();
+void ska_ecs_query_finalize();
+SkaECSQuery* ska_ecs_query_create(SkaComponentType signature);
+SkaECSQuery* ska_ecs_query_create_with_filter(SkaComponentType withSignature, SkaComponentType withoutSignature);
+SkaECSQuery* ska_ecs_query_create_with_signature_string(const char* signatures);
+void ska_ecs_query_destroy(SkaECSQuery* query);
+// Excludes entities with any of the component types from the query, the cached entity list is rebuilt (change tracking
+// queries mark all entities as changed, like 'ska_ecs_query_rebuild_all')
+void ska_ecs_query_set_without(SkaECSQuery* query, SkaComponentType withoutSignature);
+bool ska_ecs_query_has_entity(const SkaECSQuery* query, SkaEntity entity);
+bool ska_ecs_query_matches_signature(const SkaECSQuery* query, SkaComponentType signature);
+usize ska_ecs_query_get_entity_count(const SkaECSQuery* query);
+// Tracks changes to the component types in 'changedSignature' (must be part of the 'with' signature).
+// All current entities and entities that later enter the query start out as changed.
+void ska_ecs_query_set_changed(SkaECSQuery* query, SkaComponentType changedSignature);
+bool ska_ecs_query_has_changed_entity(const SkaECSQuery* query, SkaEntity entity);
+usize ska_ecs_query_get_changed_entity_count(const SkaECSQuery* query);
+void ska_ecs_query_clear_changed(SkaECSQuery* query);
+
+// Rebuilds every query's entity list from the component manager, change tracking queries mark all entities as changed
+void ska_ecs_query_rebuild_all();
+
+// Called by the component manager when an entity's component signature changes
+void ska_ecs_query_on_entity_signature_changed(SkaEntity entity, SkaComponentType oldSignature, SkaComponentType newSignature);
+// Called by the component manager when components are set or marked as changed
+void ska_ecs_query_on_entity_components_changed(SkaEntity entity, SkaComponentType changedTypes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // if SKA_ECS
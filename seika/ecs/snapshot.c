@@ -0,0 +1,75 @@
+#if SKA_ECS
+
+#include "snapshot.h"
+
+#include <string.h>
+
+#include "ec_system.h"
+#include "query.h"
+#include "seika/memory.h"
+#include "seika/assert.h"
+
+#define SKA_ECS_SNAPSHOT_ID 0x534B4153 // 'SKAS'
+// Each section starts aligned so modules can read their data directly
+#define SKA_ECS_SNAPSHOT_SECTION_ALIGNMENT 16
+#define SKA_ECS_SNAPSHOT_ALIGN(SIZE) (((SIZE) + SKA_ECS_SNAPSHOT_SECTION_ALIGNMENT - 1) / SKA_ECS_SNAPSHOT_SECTION_ALIGNMENT * SKA_ECS_SNAPSHOT_SECTION_ALIGNMENT)
+
+typedef struct ECSSnapshotHeader {
+    uint32 id;
+    usize entitySectionSize;
+    usize componentSectionSize;
+    usize systemSectionSize;
+} ECSSnapshotHeader;
+
+SkaECSSnapshot* ska_ecs_snapshot_create() {
+    SkaECSSnapshot* snapshot = SKA_ALLOC_ZEROED(SkaECSSnapshot);
+    return snapshot;
+}
+
+void ska_ecs_snapshot_destroy(SkaECSSnapshot* snapshot) {
+    if (snapshot->data) {
+        SKA_FREE(snapshot->data);
+    }
+    SKA_FREE(snapshot);
+}
+
+void ska_ecs_snapshot_capture(SkaECSSnapshot* snapshot) {
+    const ECSSnapshotHeader header = {
+        .id = SKA_ECS_SNAPSHOT_ID,
+        .entitySectionSize = SKA_ECS_SNAPSHOT_ALIGN(ska_ecs_entity_get_snapshot_size()),
+        .componentSectionSize = SKA_ECS_SNAPSHOT_ALIGN(ska_ecs_component_manager_get_snapshot_size()),
+        .systemSectionSize = SKA_ECS_SNAPSHOT_ALIGN(ska_ecs_system_get_snapshot_size())
+    };
+    const usize headerSize = SKA_ECS_SNAPSHOT_ALIGN(sizeof(ECSSnapshotHeader));
+    snapshot->size = headerSize + header.entitySectionSize + header.componentSectionSize + header.systemSectionSize;
+    if (snapshot->size > snapshot->capacity) {
+        snapshot->capacity = snapshot->size;
+        snapshot->data = ska_mem_reallocate(snapshot->data, snapshot->capacity);
+    }
+    char* buffer = snapshot->data;
+    memcpy(buffer, &header, sizeof(ECSSnapshotHeader));
+    buffer += headerSize;
+    ska_ecs_entity_write_snapshot(buffer);
+    buffer += header.entitySectionSize;
+    ska_ecs_component_manager_write_snapshot(buffer);
+    buffer += header.componentSectionSize;
+    ska_ecs_system_write_snapshot(buffer);
+}
+
+void ska_ecs_snapshot_restore(const SkaECSSnapshot* snapshot) {
+    SKA_ASSERT_FMT(snapshot->data != NULL, "Restoring an ecs snapshot that wasn't captured!");
+    ECSSnapshotHeader header;
+    memcpy(&header, snapshot->data, sizeof(ECSSnapshotHeader));
+    SKA_ASSERT_FMT(header.id == SKA_ECS_SNAPSHOT_ID, "Invalid ecs snapshot id '%u'!", header.id);
+    const char* buffer = snapshot->data + SKA_ECS_SNAPSHOT_ALIGN(sizeof(ECSSnapshotHeader));
+    ska_ecs_entity_read_snapshot(buffer);
+    buffer += header.entitySectionSize;
+    ska_ecs_component_manager_read_snapshot(buffer);
+    buffer += header.componentSectionSize;
+    ska_ecs_system_read_snapshot(buffer);
+    ska_ecs_query_rebuild_all();
+}
+
+#undef SKA_ECS_SNAPSHOT_ALIGN
+
+#endif // if SKA_ECS
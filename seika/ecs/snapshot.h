@@ -0,0 +1,30 @@
+#pragma once
+
+#if SKA_ECS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/defines.h"
+
+// Holds the whole ecs state (entity ids, component signatures and bytes, system membership) in one contiguous buffer.
+// Component types and systems must be registered the same way when restoring as when the snapshot was captured.
+typedef struct SkaECSSnapshot {
+    char* data;
+    usize size;
+    usize capacity;
+} SkaECSSnapshot;
+
+SkaECSSnapshot* ska_ecs_snapshot_create();
+void ska_ecs_snapshot_destroy(SkaECSSnapshot* snapshot);
+// Captures the current ecs state, the snapshot's buffer is only reallocated when it needs to grow so snapshots can be reused every frame
+void ska_ecs_snapshot_capture(SkaECSSnapshot* snapshot);
+// Restores the ecs state from the snapshot.  System callbacks are not invoked, queries are rebuilt.
+void ska_ecs_snapshot_restore(const SkaECSSnapshot* snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // if SKA_ECS
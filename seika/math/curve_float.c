@@ -1,38 +1,40 @@
 #include "curve_float.h"
 
+#include <string.h>
+
 #include "seika/math/math.h"
+#include "seika/data_structures/array_utils.h"
 #include "seika/assert.h"
 
 // Helper functions
-void control_point_swap(SkaCurveControlPoint* pointA, SkaCurveControlPoint* pointB) {
-    SkaCurveControlPoint temp = *pointA;
-    *pointA = *pointB;
-    *pointB = temp;
+static int32 control_point_compare(const void* a, const void* b) {
+    const f64 aX = ((const SkaCurveControlPoint*)a)->x;
+    const f64 bX = ((const SkaCurveControlPoint*)b)->x;
+    return (aX > bX) - (aX < bX);
 }
 
-// Function to perform Selection Sort
-void selection_sort_curve_float(SkaCurveFloat* curve) {
-    usize minX;
-    // One by one move boundary of unsorted subarray
-    for (usize i = 0; i < curve->controlPointCount - 1; i++) {
-        // Find the minimum element in unsorted array
-        minX = i;
-        for (usize j = i + 1; j < curve->controlPointCount; j++) {
-            if (curve->controlPoints[j].x < curve->controlPoints[minX].x) {
-                minX = j;
-            }
+// Index after the last point with an x less than or equal to 'x', so points with the same x stay in insertion order
+static usize control_point_upper_bound(const SkaCurveFloat* curve, f64 x) {
+    usize low = 0;
+    usize high = curve->controlPointCount;
+    while (low < high) {
+        const usize mid = (low + high) / 2;
+        if (curve->controlPoints[mid].x <= x) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
-        // Swap the found minimum element
-        // with the first element
-        control_point_swap(&curve->controlPoints[minX], &curve->controlPoints[i]);
     }
+    return low;
 }
 
 //--- SkaCurveFloat ---//
 void ska_curve_float_add_control_point(SkaCurveFloat* curve, SkaCurveControlPoint point) {
     SKA_ASSERT_FMT(curve->controlPointCount + 1 < SKA_CURVE_MAX_CONTROL_POINTS, "Trying to add more points than max '%u'", SKA_CURVE_MAX_CONTROL_POINTS);
-    curve->controlPoints[curve->controlPointCount++] = point;
-    selection_sort_curve_float(curve);
+    const usize index = control_point_upper_bound(curve, point.x);
+    memmove(&curve->controlPoints[index + 1], &curve->controlPoints[index], (curve->controlPointCount - index) * sizeof(SkaCurveControlPoint));
+    curve->controlPoints[index] = point;
+    curve->controlPointCount++;
 }
 
 void ska_curve_float_add_control_points(SkaCurveFloat* curve, SkaCurveControlPoint points[], usize count) {
@@ -43,16 +45,16 @@ void ska_curve_float_add_control_points(SkaCurveFloat* curve, SkaCurveControlPoi
         SKA_ASSERT_FMT(curve->controlPointCount + 1 < SKA_CURVE_MAX_CONTROL_POINTS, "Trying to add multiple points that go beyond the max of '%u'", SKA_CURVE_MAX_CONTROL_POINTS);
         curve->controlPoints[curve->controlPointCount++] = points[i];
     }
-    selection_sort_curve_float(curve);
+    SkaCurveControlPoint scratch[SKA_CURVE_MAX_CONTROL_POINTS];
+    ska_array_utils_merge_sort(curve->controlPoints, scratch, curve->controlPointCount, sizeof(SkaCurveControlPoint), control_point_compare);
 }
 
 bool ska_curve_float_remove_control_point(SkaCurveFloat* curve, f64 x, f64 y) {
     for (usize i = 0; i < curve->controlPointCount; i++) {
         SkaCurveControlPoint* point = &curve->controlPoints[i];
         if (ska_math_is_almost_equal_double_default(x, point->x) && ska_math_is_almost_equal_double_default(y, point->y)) {
-            // We've found a matching point so set it's x to the highest value, sort it, then decrement the point count.
-            point->x = DBL_MAX;
-            selection_sort_curve_float(curve);
+            // Shift the following points down, they are already in order
+            memmove(point, point + 1, (curve->controlPointCount - i - 1) * sizeof(SkaCurveControlPoint));
             curve->controlPointCount--;
             return true;
         }
@@ -1,5 +1,14 @@
 #include "math.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SKA_MATH_AFFINE2D_AVX
+#define SKA_MATH_AFFINE2D_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SKA_MATH_AFFINE2D_SSE2
+#endif
+
 // --- Vector2 --- //
 bool ska_math_vec2_equals(const SkaVector2* v1, const SkaVector2* v2) {
     return v1->x == v2->x && v1->y == v2->y;
@@ -63,6 +72,98 @@ SkaTransform2D ska_transform2d_lerp(const SkaTransform2D* tA, const SkaTransform
     };
 }
 
+// --- Affine2D --- //
+void ska_affine2d_from_transform(const SkaTransform2D* transform, SkaAffine2D* outAffine) {
+    const f32 angle = SKA_DEG_2_RADF(transform->rotation);
+    const f32 cosAngle = cosf(angle);
+    const f32 sinAngle = sinf(angle);
+    outAffine->xAxis[0] = cosAngle * transform->scale.x;
+    outAffine->xAxis[1] = sinAngle * transform->scale.x;
+    outAffine->yAxis[0] = -sinAngle * transform->scale.y;
+    outAffine->yAxis[1] = cosAngle * transform->scale.y;
+    outAffine->origin[0] = transform->position.x;
+    outAffine->origin[1] = transform->position.y;
+}
+
+void ska_affine2d_from_mat4(mat4 matrix, SkaAffine2D* outAffine) {
+    outAffine->xAxis[0] = matrix[0][0];
+    outAffine->xAxis[1] = matrix[0][1];
+    outAffine->yAxis[0] = matrix[1][0];
+    outAffine->yAxis[1] = matrix[1][1];
+    outAffine->origin[0] = matrix[3][0];
+    outAffine->origin[1] = matrix[3][1];
+}
+
+void ska_affine2d_to_mat4(const SkaAffine2D* affine, mat4 outMatrix) {
+    glm_mat4_identity(outMatrix);
+    outMatrix[0][0] = affine->xAxis[0];
+    outMatrix[0][1] = affine->xAxis[1];
+    outMatrix[1][0] = affine->yAxis[0];
+    outMatrix[1][1] = affine->yAxis[1];
+    outMatrix[3][0] = affine->origin[0];
+    outMatrix[3][1] = affine->origin[1];
+}
+
+void ska_affine2d_multiply(const SkaAffine2D* parent, const SkaAffine2D* child, SkaAffine2D* outAffine) {
+    const SkaAffine2D p = *parent;
+    const SkaAffine2D c = *child;
+    outAffine->xAxis[0] = p.xAxis[0] * c.xAxis[0] + p.yAxis[0] * c.xAxis[1];
+    outAffine->xAxis[1] = p.xAxis[1] * c.xAxis[0] + p.yAxis[1] * c.xAxis[1];
+    outAffine->yAxis[0] = p.xAxis[0] * c.yAxis[0] + p.yAxis[0] * c.yAxis[1];
+    outAffine->yAxis[1] = p.xAxis[1] * c.yAxis[0] + p.yAxis[1] * c.yAxis[1];
+    outAffine->origin[0] = p.origin[0] + p.xAxis[0] * c.origin[0] + p.yAxis[0] * c.origin[1];
+    outAffine->origin[1] = p.origin[1] + p.xAxis[1] * c.origin[0] + p.yAxis[1] * c.origin[1];
+}
+
+SkaVector2 ska_affine2d_transform_point(const SkaAffine2D* affine, SkaVector2 point) {
+    return (SkaVector2){
+        .x = affine->origin[0] + point.x * affine->xAxis[0] + point.y * affine->yAxis[0],
+        .y = affine->origin[1] + point.x * affine->xAxis[1] + point.y * affine->yAxis[1]
+    };
+}
+
+void ska_affine2d_transform_quads(const SkaAffine2D* affines, const SkaSize2D* sizes, usize count, SkaVector2* outCorners) {
+    f32* out = (f32*)outCorners;
+    usize i = 0;
+#if defined(SKA_MATH_AFFINE2D_AVX)
+    // Each 128 bit lane holds one quad, (xAxis * w, yAxis * h) and its origin twice
+    for (; i + 2 <= count; i += 2) {
+        const __m256 axes = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(affines[i].xAxis)), _mm_loadu_ps(affines[i + 1].xAxis), 1);
+        const __m256 scale = _mm256_setr_ps(sizes[i].w, sizes[i].w, sizes[i].h, sizes[i].h, sizes[i + 1].w, sizes[i + 1].w, sizes[i + 1].h, sizes[i + 1].h);
+        const __m256 origins = _mm256_setr_ps(affines[i].origin[0], affines[i].origin[1], affines[i].origin[0], affines[i].origin[1], affines[i + 1].origin[0], affines[i + 1].origin[1], affines[i + 1].origin[0], affines[i + 1].origin[1]);
+        const __m256 scaledAxes = _mm256_mul_ps(axes, scale);
+        // (0, 0, xAxis) and (yAxis, yAxis) per lane
+        const __m256 xOffset = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_setzero_pd(), _mm256_castps_pd(scaledAxes)));
+        const __m256 yOffset = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(scaledAxes), _mm256_castps_pd(scaledAxes)));
+        const __m256 bottomCorners = _mm256_add_ps(origins, xOffset);
+        const __m256 topCorners = _mm256_add_ps(bottomCorners, yOffset);
+        _mm256_storeu_ps(&out[i * 8], _mm256_permute2f128_ps(bottomCorners, topCorners, 0x20));
+        _mm256_storeu_ps(&out[i * 8 + 8], _mm256_permute2f128_ps(bottomCorners, topCorners, 0x31));
+    }
+#endif
+#if defined(SKA_MATH_AFFINE2D_SSE2)
+    for (; i < count; i++) {
+        const __m128 scaledAxes = _mm_mul_ps(_mm_loadu_ps(affines[i].xAxis), _mm_setr_ps(sizes[i].w, sizes[i].w, sizes[i].h, sizes[i].h));
+        const __m128 origin = _mm_setr_ps(affines[i].origin[0], affines[i].origin[1], affines[i].origin[0], affines[i].origin[1]);
+        const __m128 bottomCorners = _mm_add_ps(origin, _mm_movelh_ps(_mm_setzero_ps(), scaledAxes));
+        _mm_storeu_ps(&out[i * 8], bottomCorners);
+        _mm_storeu_ps(&out[i * 8 + 4], _mm_add_ps(bottomCorners, _mm_movehl_ps(scaledAxes, scaledAxes)));
+    }
+#endif
+    // Scalar fallback
+    for (; i < count; i++) {
+        const f32 xAxisX = affines[i].xAxis[0] * sizes[i].w;
+        const f32 xAxisY = affines[i].xAxis[1] * sizes[i].w;
+        const f32 yAxisX = affines[i].yAxis[0] * sizes[i].h;
+        const f32 yAxisY = affines[i].yAxis[1] * sizes[i].h;
+        SkaVector2* corners = &outCorners[i * 4];
+        corners[0] = (SkaVector2){ affines[i].origin[0], affines[i].origin[1] };
+        corners[1] = (SkaVector2){ corners[0].x + xAxisX, corners[0].y + xAxisY };
+        corners[2] = (SkaVector2){ corners[0].x + yAxisX, corners[0].y + yAxisY };
+        corners[3] = (SkaVector2){ corners[1].x + yAxisX, corners[1].y + yAxisY };
+    }
+}
+
 // --- Transform2D Model --- //
 SkaTransform2D ska_transform2d_model_convert_to_transform(SkaTransformModel2D* transformModel2D) {
     SkaTransform2D transform2D;
@@ -174,3 +275,6 @@ bool ska_math_is_almost_equal_double_default(f64 v1, f64 v2) {
     static const f64 epsilon = 0.001;
     return fabs(v1 - v2) <= epsilon;
 }
+
+#undef SKA_MATH_AFFINE2D_AVX
+#undef SKA_MATH_AFFINE2D_SSE2
@@ -113,6 +113,29 @@ SkaTransform2D ska_transform2d_model_convert_to_transform(SkaTransformModel2D* t
     .scaleSign = SKA_VECTOR2_ONE \
 }
 
+// --- SkaAffine2D --- //
+// 2D affine transform as a 2x3 column major matrix, the same values as the 2D part of a trs mat4 without the unused rows
+// and columns.  A point is transformed as 'origin + x * xAxis + y * yAxis'.
+typedef struct SkaAffine2D {
+    f32 xAxis[2];
+    f32 yAxis[2];
+    f32 origin[2];
+} SkaAffine2D;
+
+#define SKA_AFFINE2D_IDENTITY SKA_STRUCT_LITERAL(SkaAffine2D){ { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f } }
+
+// Same result as 'ska_transform2d_transform_to_mat4' without building 4x4 matrices
+void ska_affine2d_from_transform(const SkaTransform2D* transform, SkaAffine2D* outAffine);
+void ska_affine2d_from_mat4(mat4 matrix, SkaAffine2D* outAffine);
+void ska_affine2d_to_mat4(const SkaAffine2D* affine, mat4 outMatrix);
+// 'outAffine' applies 'child' first and then 'parent', it may alias either
+void ska_affine2d_multiply(const SkaAffine2D* parent, const SkaAffine2D* child, SkaAffine2D* outAffine);
+SkaVector2 ska_affine2d_transform_point(const SkaAffine2D* affine, SkaVector2 point);
+// Batch kernel writing the 4 corners of 'count' quads, quad 'i' spans (0, 0) to 'sizes[i]' in the local space of
+// 'affines[i]'.  Corners are written as (0, 0), (w, 0), (0, h), (w, h) to 'outCorners[i * 4]'.  Uses avx (2 quads at a
+// time) or sse2 (1 quad at a time) when the target supports it.
+void ska_affine2d_transform_quads(const SkaAffine2D* affines, const SkaSize2D* sizes, usize count, SkaVector2* outCorners);
+
 // --- SkaVector3 --- //
 typedef struct SkaVector3 {
     f32 x;
@@ -0,0 +1,95 @@
+#include "distance_field.h"
+
+#include <math.h>
+
+#include "seika/memory.h"
+#include "seika/math/math.h"
+
+#define SKA_DISTANCE_FIELD_FAR 1e20f
+
+// Squared euclidean distance transform of 'count' grid values 'stride' apart, in place (Felzenszwalb & Huttenlocher).
+// Each value is the squared distance of that pixel to the shape and is lowered to the distance through any other pixel.
+// 'f', 'z' and 'v' need room for 'count', 'count + 1' and 'count' values.
+static void distance_field_transform_1d(f32* grid, int32 offset, int32 stride, int32 count, f32* f, f32* z, int32* v) {
+    // Lower envelope of the parabolas rooted at each value
+    v[0] = 0;
+    z[0] = -SKA_DISTANCE_FIELD_FAR;
+    z[1] = SKA_DISTANCE_FIELD_FAR;
+    f[0] = grid[offset];
+    int32 k = 0;
+    for (int32 q = 1; q < count; q++) {
+        f[q] = grid[offset + q * stride];
+        f32 s;
+        do {
+            const int32 r = v[k];
+            s = (f[q] - f[r] + (f32)(q * q - r * r)) / (f32)(2 * (q - r));
+        } while (s <= z[k] && --k > -1);
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = SKA_DISTANCE_FIELD_FAR;
+    }
+    k = 0;
+    for (int32 q = 0; q < count; q++) {
+        while (z[k + 1] < (f32)q) {
+            k++;
+        }
+        const int32 r = v[k];
+        grid[offset + q * stride] = f[r] + (f32)((q - r) * (q - r));
+    }
+}
+
+static void distance_field_transform_2d(f32* grid, int32 width, int32 height, f32* f, f32* z, int32* v) {
+    for (int32 x = 0; x < width; x++) {
+        distance_field_transform_1d(grid, x, width, height, f, z, v);
+    }
+    for (int32 y = 0; y < height; y++) {
+        distance_field_transform_1d(grid, y * width, 1, width, f, z, v);
+    }
+}
+
+void ska_distance_field_generate(const unsigned char* coverage, int32 width, int32 height, int32 pitch, int32 spread, unsigned char* outField) {
+    const int32 fieldWidth = width + spread * 2;
+    const int32 fieldHeight = height + spread * 2;
+    const usize fieldSize = (usize)fieldWidth * (usize)fieldHeight;
+    const int32 maxLength = SKA_MATH_MAX(fieldWidth, fieldHeight);
+    // Squared distances to the shape from outside and to the background from inside, followed by transform scratch space
+    f32* outer = (f32*)SKA_ALLOC_BYTES((fieldSize * 2 + (usize)maxLength * 2 + 1) * sizeof(f32));
+    f32* inner = outer + fieldSize;
+    f32* f = inner + fieldSize;
+    f32* z = f + maxLength;
+    int32* v = (int32*)SKA_ALLOC_BYTES((usize)maxLength * sizeof(int32));
+
+    for (usize i = 0; i < fieldSize; i++) {
+        outer[i] = SKA_DISTANCE_FIELD_FAR;
+        inner[i] = 0.0f;
+    }
+    for (int32 y = 0; y < height; y++) {
+        for (int32 x = 0; x < width; x++) {
+            const f32 alpha = (f32)coverage[y * pitch + x] / 255.0f;
+            const usize i = (usize)(y + spread) * (usize)fieldWidth + (usize)(x + spread);
+            if (alpha >= 1.0f) {
+                outer[i] = 0.0f;
+                inner[i] = SKA_DISTANCE_FIELD_FAR;
+            } else if (alpha > 0.0f) {
+                // The outline crosses the pixel, closer to its center the closer coverage is to half
+                const f32 edgeOffset = 0.5f - alpha;
+                outer[i] = edgeOffset > 0.0f ? edgeOffset * edgeOffset : 0.0f;
+                inner[i] = edgeOffset < 0.0f ? edgeOffset * edgeOffset : 0.0f;
+            }
+        }
+    }
+    distance_field_transform_2d(outer, fieldWidth, fieldHeight, f, z, v);
+    distance_field_transform_2d(inner, fieldWidth, fieldHeight, f, z, v);
+
+    const f32 valuePerPixel = 127.5f / (f32)spread;
+    for (usize i = 0; i < fieldSize; i++) {
+        const f32 distance = sqrtf(inner[i]) - sqrtf(outer[i]);
+        outField[i] = (unsigned char)(ska_math_clamp_float(127.5f + distance * valuePerPixel, 0.0f, 255.0f) + 0.5f);
+    }
+
+    SKA_FREE(outer);
+    SKA_FREE(v);
+}
+
+#undef SKA_DISTANCE_FIELD_FAR
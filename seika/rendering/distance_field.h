@@ -0,0 +1,17 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/defines.h"
+
+// Writes the signed distance field of an 8 bit coverage bitmap (e.g. a rasterized glyph) into 'outField', which is
+// '2 * spread' pixels wider and taller so the field has room around the shape.  Distances up to 'spread' pixels are
+// stored as 127.5 + distance * 127.5 / spread, positive inside, so the outline is at 0.5 when sampled as a normalized
+// texture.  Partially covered pixels place the outline inside the pixel, which keeps edges smooth when scaled up.
+void ska_distance_field_generate(const unsigned char* coverage, int32 width, int32 height, int32 pitch, int32 spread, unsigned char* outField);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,21 +2,30 @@
 
 #if SKA_RENDERING
 
+#include <string.h>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 #include "render_context.h"
+#include "distance_field.h"
 #include "seika/logger.h"
 #include "seika/memory.h"
+#include "seika/string.h"
 #include "seika/asset/asset_file_loader.h"
 
 static bool ska_generate_new_font_face(const char* fileName, FT_Face* face);
 static void ska_initialize_font(FT_Face face, SkaFont* font, bool applyNearestNeighbor);
 
 SkaFont* ska_font_create_font(const char* fileName, int32 size, bool applyNearestNeighbor) {
+    return ska_font_create_font2(fileName, size, applyNearestNeighbor, SkaFontRenderMode_BITMAP);
+}
+
+SkaFont* ska_font_create_font2(const char* fileName, int32 size, bool applyNearestNeighbor, SkaFontRenderMode renderMode) {
     FT_Face face;
-    SkaFont* font = SKA_ALLOC(SkaFont);
+    SkaFont* font = SKA_ALLOC_ZEROED(SkaFont);
     font->size = size;
+    font->renderMode = renderMode;
 
     // Failed to create font, exit out early
     if (!ska_generate_new_font_face(fileName, &face)) {
@@ -32,9 +41,14 @@ SkaFont* ska_font_create_font(const char* fileName, int32 size, bool applyNeares
 }
 
 SkaFont* ska_font_create_font_from_memory(const void* buffer, usize bufferSize, int32 size, bool applyNearestNeighbor) {
+    return ska_font_create_font_from_memory2(buffer, bufferSize, size, applyNearestNeighbor, SkaFontRenderMode_BITMAP);
+}
+
+SkaFont* ska_font_create_font_from_memory2(const void* buffer, usize bufferSize, int32 size, bool applyNearestNeighbor, SkaFontRenderMode renderMode) {
     FT_Face face;
-    SkaFont* font = SKA_ALLOC(SkaFont);
+    SkaFont* font = SKA_ALLOC_ZEROED(SkaFont);
     font->size = size;
+    font->renderMode = renderMode;
 
     // Failed to create font, exit out early
     if(FT_New_Memory_Face(ska_render_context_get()->freeTypeLibrary, (unsigned char*)buffer, (FT_Long)bufferSize, 0, &face)) {
@@ -50,9 +64,166 @@ SkaFont* ska_font_create_font_from_memory(const void* buffer, usize bufferSize,
 }
 
 void ska_font_delete(SkaFont* font) {
+    if (font->isValid) {
+        glDeleteTextures(1, &font->atlasTextureId);
+        ska_glyph_cache_destroy(font->glyphCache);
+        SKA_FREE(font->characters);
+        FT_Done_Face(font->face);
+    }
     SKA_FREE(font);
 }
 
+// Rasterizes the glyph of a cache entry into its atlas cell, expects the atlas texture to be bound
+static void font_rasterize_glyph(SkaFont* font, uint32 entryIndex) {
+    const SkaGlyphCacheEntry* entry = &font->glyphCache->entries[entryIndex];
+    SkaFontCharacter* character = &font->characters[entryIndex];
+    if (FT_Load_Char(font->face, entry->codepoint, FT_LOAD_RENDER)) {
+        ska_logger_error("Freetype failed to load glyph '%u'!", entry->codepoint);
+        *character = (SkaFontCharacter){ .advance = 0 };
+        return;
+    }
+    const FT_GlyphSlot glyph = font->face->glyph;
+    const unsigned char* pixels = glyph->bitmap.buffer;
+    int32 pixelsWidth = (int32)glyph->bitmap.width;
+    int32 pixelsHeight = (int32)glyph->bitmap.rows;
+    int32 pitch = glyph->bitmap.pitch;
+    SkaVector2 bearing = { (f32)glyph->bitmap_left, (f32)glyph->bitmap_top };
+    unsigned char* distanceField = NULL;
+    if (font->renderMode == SkaFontRenderMode_SDF && pixelsWidth > 0 && pixelsHeight > 0 && pitch > 0) {
+        // The field extends 'SKA_FONT_SDF_SPREAD' pixels past the glyph's coverage on every side
+        distanceField = (unsigned char*)SKA_ALLOC_BYTES((usize)(pixelsWidth + SKA_FONT_SDF_SPREAD * 2) * (usize)(pixelsHeight + SKA_FONT_SDF_SPREAD * 2));
+        ska_distance_field_generate(pixels, pixelsWidth, pixelsHeight, pitch, SKA_FONT_SDF_SPREAD, distanceField);
+        pixels = distanceField;
+        pixelsWidth += SKA_FONT_SDF_SPREAD * 2;
+        pixelsHeight += SKA_FONT_SDF_SPREAD * 2;
+        pitch = pixelsWidth;
+        bearing.x -= (f32)SKA_FONT_SDF_SPREAD;
+        bearing.y += (f32)SKA_FONT_SDF_SPREAD;
+    }
+    // Cells fit the face's bounding box, anything outside of it is cut off
+    const int32 width = ska_math_clamp_int(pixelsWidth, 0, font->glyphCache->cellWidth - SKA_FONT_ATLAS_PADDING);
+    const int32 height = ska_math_clamp_int(pixelsHeight, 0, font->glyphCache->cellHeight - SKA_FONT_ATLAS_PADDING);
+    if (width > 0 && height > 0 && pitch > 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, entry->cellX, entry->cellY, width, height, GL_RED, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    if (distanceField != NULL) {
+        SKA_FREE(distanceField);
+    }
+    *character = (SkaFontCharacter){
+        .size = { (f32)width, (f32)height },
+        .bearing = bearing,
+        .advance = (uint32)glyph->advance.x,
+        .uvRect = { (uint16)entry->cellX, (uint16)entry->cellY, (uint16)(entry->cellX + width), (uint16)(entry->cellY + height) }
+    };
+}
+
+// Clears the cell of a cache entry, expects the atlas texture to be bound
+static void font_clear_cell(SkaFont* font, uint32 entryIndex) {
+    const SkaGlyphCacheEntry* entry = &font->glyphCache->entries[entryIndex];
+    const int32 cellWidth = font->glyphCache->cellWidth;
+    const int32 cellHeight = font->glyphCache->cellHeight;
+    unsigned char* cellPixels = (unsigned char*)SKA_ALLOC_BYTES_ZEROED((usize)cellWidth * (usize)cellHeight);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, entry->cellX, entry->cellY, cellWidth, cellHeight, GL_RED, GL_UNSIGNED_BYTE, cellPixels);
+    SKA_FREE(cellPixels);
+}
+
+// Allocates the atlas texture at the glyph cache's atlas size, cached glyphs are rasterized again at the same cells
+static void font_resize_atlas(SkaFont* font) {
+    const int32 atlasSize = font->glyphCache->atlasSize;
+    if (font->characterCapacity < font->glyphCache->entryCapacity) {
+        font->characterCapacity = font->glyphCache->entryCapacity;
+        font->characters = (SkaFontCharacter*)ska_mem_reallocate(font->characters, font->characterCapacity * sizeof(SkaFontCharacter));
+    }
+    // Starts out empty, which is what padding between glyphs relies on
+    unsigned char* atlasPixels = (unsigned char*)SKA_ALLOC_BYTES_ZEROED((usize)atlasSize * (usize)atlasSize);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, font->atlasTextureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasSize, atlasSize, 0, GL_RED, GL_UNSIGNED_BYTE, atlasPixels);
+    SKA_FREE(atlasPixels);
+    for (uint32 i = 0; i < font->glyphCache->entryCount; i++) {
+        font_rasterize_glyph(font, i);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+const SkaFontCharacter* ska_font_get_character(SkaFont* font, uint32 codepoint) {
+    const uint32 cachedIndex = ska_glyph_cache_find(font->glyphCache, codepoint);
+    if (cachedIndex != SKA_GLYPH_CACHE_NOT_FOUND) {
+        return &font->characters[cachedIndex];
+    }
+    const int32 prevAtlasSize = font->glyphCache->atlasSize;
+    const uint32 entryIndex = ska_glyph_cache_insert(font->glyphCache, codepoint);
+    if (entryIndex == SKA_GLYPH_CACHE_NOT_FOUND) {
+        return NULL;
+    }
+    if (font->glyphCache->atlasSize != prevAtlasSize) {
+        font_resize_atlas(font);
+        return &font->characters[entryIndex];
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, font->atlasTextureId);
+    // A smaller glyph leaves parts of the evicted one behind, including the padding sampled at the new glyph's edges
+    if (font->glyphCache->entries[entryIndex].isCellReused) {
+        font_clear_cell(font, entryIndex);
+    }
+    font_rasterize_glyph(font, entryIndex);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return &font->characters[entryIndex];
+}
+
+void ska_font_begin_frame(SkaFont* font) {
+    ska_glyph_cache_begin_frame(font->glyphCache);
+}
+
+f32 ska_font_get_kerning(const SkaFont* font, uint32 leftCodepoint, uint32 rightCodepoint) {
+    if (!FT_HAS_KERNING(font->face)) {
+        return 0.0f;
+    }
+    FT_Vector kerning;
+    if (FT_Get_Kerning(font->face, FT_Get_Char_Index(font->face, leftCodepoint), FT_Get_Char_Index(font->face, rightCodepoint), FT_KERNING_DEFAULT, &kerning)) {
+        return 0.0f;
+    }
+    return (f32)(kerning.x >> 6);
+}
+
+f32 ska_font_get_line_height(const SkaFont* font) {
+    return (f32)(font->face->size->metrics.height >> 6);
+}
+
+void ska_font_pack_quad_color(const SkaColor* color, unsigned char outColor[4]) {
+    outColor[0] = (unsigned char)(ska_math_clamp_float(color->r, 0.0f, 1.0f) * 255.0f + 0.5f);
+    outColor[1] = (unsigned char)(ska_math_clamp_float(color->g, 0.0f, 1.0f) * 255.0f + 0.5f);
+    outColor[2] = (unsigned char)(ska_math_clamp_float(color->b, 0.0f, 1.0f) * 255.0f + 0.5f);
+    outColor[3] = (unsigned char)(ska_math_clamp_float(color->a, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+void ska_font_write_glyph_quad(const SkaFontCharacter* character, f32 x, f32 y, f32 scale, const SkaColor* color, SkaFontGlyphQuad* outQuad) {
+    outQuad->rect[0] = x + character->bearing.x * scale;
+    outQuad->rect[1] = -y - (character->size.y - character->bearing.y) * scale; // Invert Y because orthographic projection is flipped
+    outQuad->rect[2] = character->size.x * scale;
+    outQuad->rect[3] = character->size.y * scale;
+    memcpy(outQuad->uvRect, character->uvRect, sizeof(outQuad->uvRect));
+    ska_font_pack_quad_color(color, outQuad->color);
+}
+
+usize ska_font_write_text_quads(SkaFont* font, const char* text, f32 x, f32 y, f32 scale, const SkaColor* color, SkaFontGlyphQuad* outQuads) {
+    usize glyphCount = 0;
+    while (*text != '\0') {
+        const SkaFontCharacter* ch = ska_font_get_character(font, ska_str_utf8_decode_next(&text));
+        if (ch == NULL) {
+            continue;
+        }
+        if (ch->size.x > 0.0f && ch->size.y > 0.0f) {
+            ska_font_write_glyph_quad(ch, x, y, scale, color, &outQuads[glyphCount]);
+            glyphCount++;
+        }
+        x += (f32)(ch->advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
+    }
+    return glyphCount;
+}
+
 bool ska_generate_new_font_face(const char* fileName, FT_Face* face) {
     if (ska_asset_file_loader_get_read_mode() == SkaAssetFileLoaderReadMode_ARCHIVE) {
         SkaArchiveFileAsset fileAsset = ska_asset_file_loader_get_asset(fileName);
@@ -77,60 +248,50 @@ bool ska_generate_new_font_face(const char* fileName, FT_Face* face) {
 static void ska_initialize_font(FT_Face face, SkaFont* font, bool applyNearestNeighbor) {
     // Set size to load glyphs, width set to 0 to dynamically adjust
     FT_Set_Pixel_Sizes(face, 0, font->size);
-    // Disable byte alignment restriction
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    // Load first 128 characters of ASCII set
-    for (unsigned char c = 0; c < 128; c++) { // 'c++' ;-)
-        // Load character glyph
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-            ska_logger_error("Freetype failed to load glyph '%u!", c);
-            continue;
-        }
-        // Generate texture
-        GLuint textTexture;
-        glGenTextures(1, &textTexture);
-        glBindTexture(GL_TEXTURE_2D, textTexture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            (GLsizei) face->glyph->bitmap.width,
-            (GLsizei) face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-        // Texture wrap and filter options
-        const GLint filterType = applyNearestNeighbor ? GL_NEAREST : GL_LINEAR;
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterType);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterType);
-        // Create character struct
-        SkaFontCharacter character = {
-                .textureId = textTexture,
-                .size = { (f32)face->glyph->bitmap.width, (f32)face->glyph->bitmap.rows },
-                .bearing = { (f32)face->glyph->bitmap_left, (f32)face->glyph->bitmap_top },
-                .advance = (GLuint) face->glyph->advance.x
-        };
-        font->characters[c] = character;
+    // Atlas cells fit any glyph of the face
+    const FT_Size_Metrics* metrics = &face->size->metrics;
+    int32 cellWidth = (int32)(metrics->max_advance >> 6);
+    int32 cellHeight = (int32)(metrics->height >> 6);
+    if (FT_IS_SCALABLE(face)) {
+        cellWidth = (int32)((FT_MulFix(face->bbox.xMax - face->bbox.xMin, metrics->x_scale) + 63) >> 6);
+        cellHeight = (int32)((FT_MulFix(face->bbox.yMax - face->bbox.yMin, metrics->y_scale) + 63) >> 6);
+    }
+    cellWidth = SKA_MATH_MAX(cellWidth, 1) + SKA_FONT_ATLAS_PADDING;
+    cellHeight = SKA_MATH_MAX(cellHeight, 1) + SKA_FONT_ATLAS_PADDING;
+    if (font->renderMode == SkaFontRenderMode_SDF) {
+        // Room for the distance field around the glyph
+        cellWidth += SKA_FONT_SDF_SPREAD * 2;
+        cellHeight += SKA_FONT_SDF_SPREAD * 2;
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
 
-    // configure VAO & VBO texture quads
-    glGenVertexArrays(1, &font->VAO);
-    glGenBuffers(1, &font->VBO);
-    glBindVertexArray(font->VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, font->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), NULL);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    font->isValid = true;
+    // Start with room for about 8 x 8 glyphs, the atlas grows as glyphs are used
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    const int32 maxAtlasSize = SKA_MATH_MIN(SKA_FONT_MAX_ATLAS_SIZE, (int32)maxTextureSize);
+    int32 atlasSize = 64;
+    while (atlasSize < SKA_MATH_MAX(cellWidth, cellHeight) * 8 && atlasSize < maxAtlasSize) {
+        atlasSize *= 2;
+    }
+    if (cellWidth > atlasSize || cellHeight > atlasSize) {
+        ska_logger_error("Font glyphs with size '%d' don't fit into a '%d' texture!", font->size, maxAtlasSize);
+        font->isValid = false;
+        FT_Done_Face(face);
+        return;
+    }
 
-    FT_Done_Face(face);
+    font->face = face;
+    font->glyphCache = ska_glyph_cache_create(cellWidth, cellHeight, atlasSize, maxAtlasSize);
+    glGenTextures(1, &font->atlasTextureId);
+    font_resize_atlas(font);
+    // Texture wrap and filter options, distances have to be interpolated
+    const GLint filterType = applyNearestNeighbor && font->renderMode != SkaFontRenderMode_SDF ? GL_NEAREST : GL_LINEAR;
+    glBindTexture(GL_TEXTURE_2D, font->atlasTextureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterType);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterType);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    font->isValid = true;
 }
 
 #endif // #if SKA_RENDERING
@@ -6,25 +6,84 @@
 
 #include <glad/glad.h>
 
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
 #include "seika/math/math.h"
+#include "glyph_cache.h"
+
+// Empty pixels kept between glyphs in the atlas, so filtering at a glyph's edge doesn't pick up its neighbors
+#define SKA_FONT_ATLAS_PADDING 1
+// Size the glyph atlas grows to before least recently used glyphs are evicted (also capped by the gl max texture size)
+#define SKA_FONT_MAX_ATLAS_SIZE 2048
+// Distance in pixels at the font's size encoded around the outline of SDF glyphs
+#define SKA_FONT_SDF_SPREAD 8
+
+// How glyphs are rasterized into the atlas
+typedef enum SkaFontRenderMode {
+    SkaFontRenderMode_BITMAP, // Coverage at the font's size, crisp when drawn at scale 1
+    SkaFontRenderMode_SDF, // Signed distance fields at a reference size, crisp at any scale so one font serves every size
+} SkaFontRenderMode;
 
 typedef struct SkaFontCharacter {
-    GLuint textureId;
     SkaVector2 size;
     SkaVector2 bearing;
     uint32 advance;
+    uint16 uvRect[4]; // Min and max corner in atlas pixels, normalized by the font shader so it stays valid when the atlas grows
 } SkaFontCharacter;
 
+// Instance of a glyph quad drawn over a unit quad, quads of all text drawn with the same font and z index are drawn
+// together.  Kept small since every glyph of every queued text is streamed each frame.
+typedef struct SkaFontGlyphQuad {
+    f32 rect[4]; // Bottom left corner and size, y pointing up
+    uint16 uvRect[4];
+    unsigned char color[4]; // rgba, normalized by the font shader
+} SkaFontGlyphQuad;
+
+// Glyphs are rasterized on first use into a single atlas texture, so text is drawn without switching textures and only
+// the glyphs actually used take up memory
 typedef struct SkaFont {
     bool isValid;
-    GLuint VAO;
-    GLuint VBO;
+    GLuint atlasTextureId;
     int32 size;
-    SkaFontCharacter characters[128]; // First 128 of ASCII set
+    SkaFontRenderMode renderMode;
+    FT_Face face; // Kept open to rasterize glyphs on demand
+    SkaGlyphCache* glyphCache;
+    SkaFontCharacter* characters; // By glyph cache entry index
+    uint32 characterCapacity;
 } SkaFont;
 
 SkaFont* ska_font_create_font(const char* fileName, int32 size, bool applyNearestNeighbor);
+// For 'SkaFontRenderMode_SDF' 'size' is the reference size glyphs are rasterized at and 'applyNearestNeighbor' is ignored
+SkaFont* ska_font_create_font2(const char* fileName, int32 size, bool applyNearestNeighbor, SkaFontRenderMode renderMode);
+// 'buffer' has to outlive the font, glyphs are read from it on demand
 SkaFont* ska_font_create_font_from_memory(const void* buffer, usize bufferSize, int32 size, bool applyNearestNeighbor);
+SkaFont* ska_font_create_font_from_memory2(const void* buffer, usize bufferSize, int32 size, bool applyNearestNeighbor, SkaFontRenderMode renderMode);
 void ska_font_delete(SkaFont* font);
+// Returns the glyph of a unicode codepoint, rasterizing it into the atlas on first use.  Returns NULL if the atlas is
+// full of glyphs used this frame.
+const SkaFontCharacter* ska_font_get_character(SkaFont* font, uint32 codepoint);
+// Index of the character in 'characters' and the glyph cache, only valid until the glyph cache evicts a glyph
+static inline uint32 ska_font_get_character_index(const SkaFont* font, const SkaFontCharacter* character) {
+    return (uint32)(character - font->characters);
+}
+// Kerning between two codepoints in pixels at the font's size, 0 for faces without kerning
+f32 ska_font_get_kerning(const SkaFont* font, uint32 leftCodepoint, uint32 rightCodepoint);
+// Distance between baselines in pixels at the font's size
+f32 ska_font_get_line_height(const SkaFont* font);
+// Scale to draw text with so it appears at 'size' pixels, e.g. for sdf fonts
+static inline f32 ska_font_get_scale_for_size(const SkaFont* font, f32 size) {
+    return size / (f32)font->size;
+}
+// Glyphs used after this call stay in the atlas at least until the next call, the renderer calls this once per frame
+// before writing text quads
+void ska_font_begin_frame(SkaFont* font);
+// Writes the glyph quads of UTF-8 'text' for the font shader, which has y pointing up.  'outQuads' needs room for a quad
+// per byte of 'text'.  Returns the amount of quads written, glyphs without pixels (e.g. spaces) only advance the pen.
+usize ska_font_write_text_quads(SkaFont* font, const char* text, f32 x, f32 y, f32 scale, const SkaColor* color, SkaFontGlyphQuad* outQuads);
+// Writes the quad of a glyph with pixels, with the pen at 'x' and baseline at 'y'
+void ska_font_write_glyph_quad(const SkaFontCharacter* character, f32 x, f32 y, f32 scale, const SkaColor* color, SkaFontGlyphQuad* outQuad);
+// Converts a color to the quads' rgba bytes
+void ska_font_pack_quad_color(const SkaColor* color, unsigned char outColor[4]);
 
 #endif // #if SKA_RENDERING
\ No newline at end of file
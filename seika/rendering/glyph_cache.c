@@ -0,0 +1,160 @@
+#include "glyph_cache.h"
+
+#include <string.h>
+
+#include "seika/memory.h"
+#include "seika/assert.h"
+
+#define SKA_GLYPH_CACHE_EMPTY_SLOT 0xFFFFFFFFu
+
+static inline uint32 glyph_cache_hash(uint32 codepoint) {
+    uint32 hash = codepoint * 0x9E3779B1u;
+    return hash ^ (hash >> 16);
+}
+
+static void glyph_cache_rebuild_slots(SkaGlyphCache* cache) {
+    // Kept at most half full so probe sequences stay short
+    uint32 slotCapacity = 16;
+    while (slotCapacity < cache->entryCapacity * 2) {
+        slotCapacity *= 2;
+    }
+    if (slotCapacity != cache->slotCapacity) {
+        SKA_FREE(cache->slots);
+        cache->slots = (uint32*)SKA_ALLOC_BYTES(slotCapacity * sizeof(uint32));
+        cache->slotCapacity = slotCapacity;
+    }
+    memset(cache->slots, 0xFF, cache->slotCapacity * sizeof(uint32));
+    const uint32 mask = cache->slotCapacity - 1;
+    for (uint32 i = 0; i < cache->entryCount; i++) {
+        uint32 slot = glyph_cache_hash(cache->entries[i].codepoint) & mask;
+        while (cache->slots[slot] != SKA_GLYPH_CACHE_EMPTY_SLOT) {
+            slot = (slot + 1) & mask;
+        }
+        cache->slots[slot] = i;
+    }
+}
+
+// Resizes the atlas to 'atlasSize' and adds the cells that didn't fit before as free cells
+static void glyph_cache_resize_atlas(SkaGlyphCache* cache, int32 atlasSize) {
+    const uint32 oldColumns = (uint32)(cache->atlasSize / cache->cellWidth);
+    const uint32 oldRows = (uint32)(cache->atlasSize / cache->cellHeight);
+    const uint32 columns = (uint32)(atlasSize / cache->cellWidth);
+    const uint32 rows = (uint32)(atlasSize / cache->cellHeight);
+    cache->atlasSize = atlasSize;
+    cache->entryCapacity = columns * rows;
+    cache->entries = (SkaGlyphCacheEntry*)ska_mem_reallocate(cache->entries, cache->entryCapacity * sizeof(SkaGlyphCacheEntry));
+    cache->freeCells = (uint32*)ska_mem_reallocate(cache->freeCells, cache->entryCapacity * sizeof(uint32));
+    // Pushed in reverse, so cells are handed out row by row
+    for (uint32 row = rows; row-- > 0;) {
+        for (uint32 column = columns; column-- > 0;) {
+            if (row >= oldRows || column >= oldColumns) {
+                cache->freeCells[cache->freeCellCount++] = (row << 16) | column;
+            }
+        }
+    }
+    glyph_cache_rebuild_slots(cache);
+}
+
+SkaGlyphCache* ska_glyph_cache_create(int32 cellWidth, int32 cellHeight, int32 initialAtlasSize, int32 maxAtlasSize) {
+    SKA_ASSERT_FMT(cellWidth > 0 && cellHeight > 0 && cellWidth <= initialAtlasSize && cellHeight <= initialAtlasSize && initialAtlasSize <= maxAtlasSize,
+                   "Invalid glyph cache cell size '%dx%d' for atlas size '%d'", cellWidth, cellHeight, initialAtlasSize);
+    SkaGlyphCache* cache = SKA_ALLOC_ZEROED(SkaGlyphCache);
+    cache->cellWidth = cellWidth;
+    cache->cellHeight = cellHeight;
+    cache->maxAtlasSize = maxAtlasSize;
+    glyph_cache_resize_atlas(cache, initialAtlasSize);
+    return cache;
+}
+
+void ska_glyph_cache_destroy(SkaGlyphCache* cache) {
+    SKA_FREE(cache->entries);
+    SKA_FREE(cache->slots);
+    SKA_FREE(cache->freeCells);
+    SKA_FREE(cache);
+}
+
+static uint32 glyph_cache_find_slot(const SkaGlyphCache* cache, uint32 codepoint) {
+    const uint32 mask = cache->slotCapacity - 1;
+    uint32 slot = glyph_cache_hash(codepoint) & mask;
+    while (cache->slots[slot] != SKA_GLYPH_CACHE_EMPTY_SLOT) {
+        if (cache->entries[cache->slots[slot]].codepoint == codepoint) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+uint32 ska_glyph_cache_find(SkaGlyphCache* cache, uint32 codepoint) {
+    const uint32 entryIndex = cache->slots[glyph_cache_find_slot(cache, codepoint)];
+    if (entryIndex == SKA_GLYPH_CACHE_EMPTY_SLOT) {
+        return SKA_GLYPH_CACHE_NOT_FOUND;
+    }
+    cache->entries[entryIndex].lastUsed = ++cache->useCounter;
+    return entryIndex;
+}
+
+// Backward shift deletion, entries after the removed slot are moved up so lookups never stop early
+static void glyph_cache_remove_slot(SkaGlyphCache* cache, uint32 slot) {
+    const uint32 mask = cache->slotCapacity - 1;
+    uint32 hole = slot;
+    for (uint32 next = (hole + 1) & mask; cache->slots[next] != SKA_GLYPH_CACHE_EMPTY_SLOT; next = (next + 1) & mask) {
+        const uint32 home = glyph_cache_hash(cache->entries[cache->slots[next]].codepoint) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            cache->slots[hole] = cache->slots[next];
+            hole = next;
+        }
+    }
+    cache->slots[hole] = SKA_GLYPH_CACHE_EMPTY_SLOT;
+}
+
+// Returns the least recently used entry not used this frame, or 'SKA_GLYPH_CACHE_NOT_FOUND'
+static uint32 glyph_cache_find_evictable_entry(const SkaGlyphCache* cache) {
+    uint32 evictIndex = SKA_GLYPH_CACHE_NOT_FOUND;
+    uint64 oldestUse = cache->frameStartUse + 1;
+    for (uint32 i = 0; i < cache->entryCount; i++) {
+        if (cache->entries[i].lastUsed < oldestUse) {
+            oldestUse = cache->entries[i].lastUsed;
+            evictIndex = i;
+        }
+    }
+    return evictIndex;
+}
+
+uint32 ska_glyph_cache_insert(SkaGlyphCache* cache, uint32 codepoint) {
+    if (cache->freeCellCount == 0 && cache->atlasSize * 2 <= cache->maxAtlasSize) {
+        glyph_cache_resize_atlas(cache, cache->atlasSize * 2);
+    }
+    uint32 entryIndex;
+    if (cache->freeCellCount > 0) {
+        const uint32 cell = cache->freeCells[--cache->freeCellCount];
+        entryIndex = cache->entryCount++;
+        cache->entries[entryIndex].cellX = (int32)(cell & 0xFFFF) * cache->cellWidth;
+        cache->entries[entryIndex].cellY = (int32)(cell >> 16) * cache->cellHeight;
+        cache->entries[entryIndex].isCellReused = false;
+    } else {
+        entryIndex = glyph_cache_find_evictable_entry(cache);
+        if (entryIndex == SKA_GLYPH_CACHE_NOT_FOUND) {
+            return SKA_GLYPH_CACHE_NOT_FOUND;
+        }
+        glyph_cache_remove_slot(cache, glyph_cache_find_slot(cache, cache->entries[entryIndex].codepoint));
+        cache->entries[entryIndex].isCellReused = true;
+        cache->evictionCount++;
+    }
+    cache->entries[entryIndex].codepoint = codepoint;
+    cache->entries[entryIndex].lastUsed = ++cache->useCounter;
+    cache->slots[glyph_cache_find_slot(cache, codepoint)] = entryIndex;
+    return entryIndex;
+}
+
+void ska_glyph_cache_mark_used(SkaGlyphCache* cache, const uint32* entryIndices, usize entryCount) {
+    for (usize i = 0; i < entryCount; i++) {
+        cache->entries[entryIndices[i]].lastUsed = ++cache->useCounter;
+    }
+}
+
+void ska_glyph_cache_begin_frame(SkaGlyphCache* cache) {
+    cache->frameStartUse = cache->useCounter;
+}
+
+#undef SKA_GLYPH_CACHE_EMPTY_SLOT
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/defines.h"
+
+#define SKA_GLYPH_CACHE_NOT_FOUND 0xFFFFFFFFu
+
+typedef struct SkaGlyphCacheEntry {
+    uint32 codepoint;
+    int32 cellX; // Top left corner of the glyph's cell in atlas pixels
+    int32 cellY;
+    uint64 lastUsed;
+    bool isCellReused; // The cell still holds the pixels of the evicted glyph, unlike the empty cells of a new atlas
+} SkaGlyphCacheEntry;
+
+// Bookkeeping of a glyph atlas filled on demand.  The atlas is split into equally sized cells that fit the largest glyph,
+// so any cell can be reused by any glyph.  When all cells are taken the atlas doubles in size up to 'maxAtlasSize', after
+// that the least recently used glyph is evicted.  Glyphs used since the last 'ska_glyph_cache_begin_frame' are never
+// evicted, queued vertices may still point at their cells.
+typedef struct SkaGlyphCache {
+    SkaGlyphCacheEntry* entries; // Entry indices are stable, an evicted glyph's entry is reused by the new glyph
+    uint32 entryCount;
+    uint32 entryCapacity; // Amount of cells in the current atlas
+    uint32* slots; // Open addressing table of entry indices by codepoint
+    uint32 slotCapacity; // Power of two
+    uint32* freeCells; // Cells as (row << 16 | column), popped from the back
+    uint32 freeCellCount;
+    int32 cellWidth;
+    int32 cellHeight;
+    int32 atlasSize;
+    int32 maxAtlasSize;
+    uint64 useCounter;
+    uint64 frameStartUse;
+    uint32 evictionCount; // Changes whenever a cell gets a new glyph, cached vertices are stale afterwards
+} SkaGlyphCache;
+
+SkaGlyphCache* ska_glyph_cache_create(int32 cellWidth, int32 cellHeight, int32 initialAtlasSize, int32 maxAtlasSize);
+void ska_glyph_cache_destroy(SkaGlyphCache* cache);
+// Returns the entry index of a cached codepoint and marks it as used, or 'SKA_GLYPH_CACHE_NOT_FOUND'
+uint32 ska_glyph_cache_find(SkaGlyphCache* cache, uint32 codepoint);
+// Adds a codepoint that isn't cached yet and returns its entry index, the atlas may grow (check 'atlasSize') or a glyph
+// may be evicted.  Returns 'SKA_GLYPH_CACHE_NOT_FOUND' if every cell holds a glyph used this frame.
+uint32 ska_glyph_cache_insert(SkaGlyphCache* cache, uint32 codepoint);
+// Marks entries as used without looking them up, for callers that kept the entry indices of glyphs (e.g. cached text)
+void ska_glyph_cache_mark_used(SkaGlyphCache* cache, const uint32* entryIndices, usize entryCount);
+// Starts a new frame, glyphs only used in previous frames can be evicted again
+void ska_glyph_cache_begin_frame(SkaGlyphCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
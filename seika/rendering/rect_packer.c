@@ -0,0 +1,119 @@
+#include "rect_packer.h"
+
+#include <string.h>
+
+#include "seika/memory.h"
+#include "seika/assert.h"
+
+SkaRectPacker* ska_rect_packer_create(int32 width, int32 height) {
+    SKA_ASSERT_FMT(width > 0 && height > 0, "Invalid rect packer size '%d x %d'", width, height);
+    SkaRectPacker* packer = SKA_ALLOC_ZEROED(SkaRectPacker);
+    packer->width = width;
+    packer->height = height;
+    // Segments are at least a pixel wide, plus one for the segment inserted before the ones it covers are removed
+    packer->nodeCapacity = (usize)width + 1;
+    packer->nodes = (SkaRectPackerNode*)SKA_ALLOC_BYTES(packer->nodeCapacity * sizeof(SkaRectPackerNode));
+    ska_rect_packer_clear(packer);
+    return packer;
+}
+
+void ska_rect_packer_destroy(SkaRectPacker* packer) {
+    SKA_FREE(packer->nodes);
+    SKA_FREE(packer);
+}
+
+// Returns the y position a rect placed at the start of segment 'nodeIndex' would rest at, -1 if it doesn't fit there
+static int32 rect_packer_fit(const SkaRectPacker* packer, usize nodeIndex, int32 width, int32 height) {
+    const SkaRectPackerNode* nodes = packer->nodes;
+    if (nodes[nodeIndex].x + width > packer->width) {
+        return -1;
+    }
+    int32 y = nodes[nodeIndex].y;
+    int32 widthLeft = width;
+    for (usize i = nodeIndex; widthLeft > 0; i++) {
+        if (nodes[i].y > y) {
+            y = nodes[i].y;
+        }
+        if (y + height > packer->height) {
+            return -1;
+        }
+        widthLeft -= nodes[i].width;
+    }
+    return y;
+}
+
+static inline void rect_packer_remove_node(SkaRectPacker* packer, usize nodeIndex) {
+    memmove(&packer->nodes[nodeIndex], &packer->nodes[nodeIndex + 1], (packer->nodeCount - nodeIndex - 1) * sizeof(SkaRectPackerNode));
+    packer->nodeCount--;
+}
+
+bool ska_rect_packer_pack(SkaRectPacker* packer, int32 width, int32 height, int32* outX, int32* outY) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    // Lowest resulting top edge wins, ties go to the narrowest segment to keep wide ones for wide rects
+    usize bestIndex = packer->nodeCount;
+    int32 bestY = 0;
+    int32 bestTop = packer->height + 1;
+    int32 bestWidth = packer->width + 1;
+    for (usize i = 0; i < packer->nodeCount; i++) {
+        const int32 y = rect_packer_fit(packer, i, width, height);
+        if (y < 0) {
+            continue;
+        }
+        if (y + height < bestTop || (y + height == bestTop && packer->nodes[i].width < bestWidth)) {
+            bestIndex = i;
+            bestY = y;
+            bestTop = y + height;
+            bestWidth = packer->nodes[i].width;
+        }
+    }
+    if (bestIndex == packer->nodeCount) {
+        return false;
+    }
+
+    // Insert the rect's top edge as a new segment and cut away the segments it now covers
+    SkaRectPackerNode* nodes = packer->nodes;
+    const int32 x = nodes[bestIndex].x;
+    SKA_ASSERT(packer->nodeCount < packer->nodeCapacity);
+    memmove(&nodes[bestIndex + 1], &nodes[bestIndex], (packer->nodeCount - bestIndex) * sizeof(SkaRectPackerNode));
+    nodes[bestIndex] = (SkaRectPackerNode){ .x = x, .y = bestY + height, .width = width };
+    packer->nodeCount++;
+    for (usize i = bestIndex + 1; i < packer->nodeCount;) {
+        const int32 previousEnd = nodes[i - 1].x + nodes[i - 1].width;
+        if (nodes[i].x >= previousEnd) {
+            break;
+        }
+        const int32 shrink = previousEnd - nodes[i].x;
+        nodes[i].x += shrink;
+        nodes[i].width -= shrink;
+        if (nodes[i].width > 0) {
+            break;
+        }
+        rect_packer_remove_node(packer, i);
+    }
+    // Merge neighbouring segments at the same height
+    for (usize i = 0; i + 1 < packer->nodeCount;) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].width += nodes[i + 1].width;
+            rect_packer_remove_node(packer, i + 1);
+        } else {
+            i++;
+        }
+    }
+
+    packer->usedArea += (int64)width * (int64)height;
+    *outX = x;
+    *outY = bestY;
+    return true;
+}
+
+void ska_rect_packer_clear(SkaRectPacker* packer) {
+    packer->nodes[0] = (SkaRectPackerNode){ .x = 0, .y = 0, .width = packer->width };
+    packer->nodeCount = 1;
+    packer->usedArea = 0;
+}
+
+f32 ska_rect_packer_get_occupancy(const SkaRectPacker* packer) {
+    return (f32)((f64)packer->usedArea / ((f64)packer->width * (f64)packer->height));
+}
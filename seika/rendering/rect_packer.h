@@ -0,0 +1,36 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/defines.h"
+
+typedef struct SkaRectPackerNode {
+    int32 x;
+    int32 y;
+    int32 width;
+} SkaRectPackerNode;
+
+// Skyline bottom left packer, rects are placed at the lowest spot of the skyline (the top edge of everything packed so far)
+// that they fit in.  Packing is online, rects can't be removed individually.
+typedef struct SkaRectPacker {
+    int32 width;
+    int32 height;
+    SkaRectPackerNode* nodes; // Skyline segments from left to right, a segment never has a width of 0
+    usize nodeCount;
+    usize nodeCapacity;
+    int64 usedArea;
+} SkaRectPacker;
+
+SkaRectPacker* ska_rect_packer_create(int32 width, int32 height);
+void ska_rect_packer_destroy(SkaRectPacker* packer);
+// Returns false if there is no space left for a 'width' x 'height' rect
+bool ska_rect_packer_pack(SkaRectPacker* packer, int32 width, int32 height, int32* outX, int32* outY);
+void ska_rect_packer_clear(SkaRectPacker* packer);
+// Ratio of the packer's area covered by rects
+f32 ska_rect_packer_get_occupancy(const SkaRectPacker* packer);
+
+#ifdef __cplusplus
+}
+#endif
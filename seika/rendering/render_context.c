@@ -17,6 +17,7 @@ void ska_render_context_initialize() {
 void ska_render_context_finalize() {
     SKA_ASSERT_FMT(renderContext != NULL, "Render context is not initialized!");
     SKA_FREE(renderContext);
+    renderContext = NULL;
 }
 
 SkaRenderContext* ska_render_context_get() {
@@ -0,0 +1,143 @@
+#include "render_queue.h"
+
+#include <string.h>
+
+#include "seika/memory.h"
+#include "seika/data_structures/array_utils.h"
+
+#define SKA_RENDER_QUEUE_NO_ORDINAL 0xFFFFFFFFu
+
+static void render_queue_handle_table_initialize(SkaRenderQueueHandleTable* table, uint32 maxCount) {
+    // Kept at most half full so probe sequences stay short
+    table->capacity = maxCount * 2;
+    table->maxCount = maxCount;
+    table->count = 0;
+    table->generation = 1;
+    table->lastOrdinal = SKA_RENDER_QUEUE_NO_ORDINAL;
+    table->handles = (uint64*)SKA_ALLOC_BYTES(table->capacity * sizeof(uint64));
+    table->ordinals = (uint32*)SKA_ALLOC_BYTES(table->capacity * sizeof(uint32));
+    table->generations = (uint32*)SKA_ALLOC_BYTES_ZEROED(table->capacity * sizeof(uint32));
+}
+
+static void render_queue_handle_table_finalize(SkaRenderQueueHandleTable* table) {
+    SKA_FREE(table->handles);
+    SKA_FREE(table->ordinals);
+    SKA_FREE(table->generations);
+}
+
+static void render_queue_handle_table_clear(SkaRenderQueueHandleTable* table) {
+    table->count = 0;
+    table->lastOrdinal = SKA_RENDER_QUEUE_NO_ORDINAL;
+    if (++table->generation == 0) {
+        // Wrapped around, stale slots could look current
+        memset(table->generations, 0, table->capacity * sizeof(uint32));
+        table->generation = 1;
+    }
+}
+
+static uint32 render_queue_handle_table_get_ordinal(SkaRenderQueueHandleTable* table, uint64 handle) {
+    if (table->lastOrdinal != SKA_RENDER_QUEUE_NO_ORDINAL && table->lastHandle == handle) {
+        return table->lastOrdinal;
+    }
+    uint64 hash = handle ^ (handle >> 33);
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    const uint32 mask = table->capacity - 1;
+    uint32 slot = (uint32)hash & mask;
+    while (table->generations[slot] == table->generation && table->handles[slot] != handle) {
+        slot = (slot + 1) & mask;
+    }
+    uint32 ordinal;
+    if (table->generations[slot] == table->generation) {
+        ordinal = table->ordinals[slot];
+    } else if (table->count < table->maxCount - 1) {
+        table->generations[slot] = table->generation;
+        table->handles[slot] = handle;
+        table->ordinals[slot] = table->count++;
+        ordinal = table->ordinals[slot];
+    } else {
+        // Past the limit handles share the overflow ordinal and aren't added, so the table never fills up
+        ordinal = table->maxCount - 1;
+    }
+    table->lastHandle = handle;
+    table->lastOrdinal = ordinal;
+    return ordinal;
+}
+
+SkaRenderQueue* ska_render_queue_create(usize initialCapacity) {
+    SkaRenderQueue* queue = SKA_ALLOC_ZEROED(SkaRenderQueue);
+    queue->capacity = initialCapacity > 0 ? initialCapacity : 1;
+    queue->keys = (uint64*)SKA_ALLOC_BYTES(queue->capacity * sizeof(uint64));
+    queue->sortScratch = (uint64*)SKA_ALLOC_BYTES(queue->capacity * sizeof(uint64));
+    render_queue_handle_table_initialize(&queue->shaders, SKA_RENDER_QUEUE_MAX_SHADERS);
+    render_queue_handle_table_initialize(&queue->textures, SKA_RENDER_QUEUE_MAX_TEXTURES);
+    return queue;
+}
+
+void ska_render_queue_destroy(SkaRenderQueue* queue) {
+    render_queue_handle_table_finalize(&queue->shaders);
+    render_queue_handle_table_finalize(&queue->textures);
+    SKA_FREE(queue->keys);
+    SKA_FREE(queue->sortScratch);
+    SKA_FREE(queue);
+}
+
+static inline void render_queue_push_key(SkaRenderQueue* queue, uint64 key) {
+    if (queue->count >= queue->capacity) {
+        queue->capacity *= 2;
+        queue->keys = (uint64*)ska_mem_reallocate(queue->keys, queue->capacity * sizeof(uint64));
+        SKA_FREE(queue->sortScratch);
+        queue->sortScratch = (uint64*)SKA_ALLOC_BYTES(queue->capacity * sizeof(uint64));
+    }
+    queue->keys[queue->count++] = key;
+}
+
+void ska_render_queue_push_sprite(SkaRenderQueue* queue, uint32 arrayZIndex, const void* shader, uint32 textureId, uint32 commandIndex) {
+    const uint64 shaderOrdinal = render_queue_handle_table_get_ordinal(&queue->shaders, (uint64)(uintptr_t)shader);
+    const uint64 textureOrdinal = render_queue_handle_table_get_ordinal(&queue->textures, (uint64)textureId);
+    const uint64 key = ((uint64)(arrayZIndex & 0xFF) << SKA_RENDER_QUEUE_KEY_Z_INDEX_SHIFT)
+        | ((uint64)SkaRenderQueueItemType_SPRITE << SKA_RENDER_QUEUE_KEY_TYPE_SHIFT)
+        | (shaderOrdinal << SKA_RENDER_QUEUE_KEY_SHADER_SHIFT)
+        | (textureOrdinal << SKA_RENDER_QUEUE_KEY_TEXTURE_SHIFT)
+        | (uint64)commandIndex;
+    render_queue_push_key(queue, key);
+}
+
+void ska_render_queue_push_font(SkaRenderQueue* queue, uint32 arrayZIndex, uint32 textureId, uint32 commandIndex) {
+    const uint64 textureOrdinal = render_queue_handle_table_get_ordinal(&queue->textures, (uint64)textureId);
+    const uint64 key = ((uint64)(arrayZIndex & 0xFF) << SKA_RENDER_QUEUE_KEY_Z_INDEX_SHIFT)
+        | ((uint64)SkaRenderQueueItemType_FONT << SKA_RENDER_QUEUE_KEY_TYPE_SHIFT)
+        | (textureOrdinal << SKA_RENDER_QUEUE_KEY_TEXTURE_SHIFT)
+        | (uint64)commandIndex;
+    render_queue_push_key(queue, key);
+}
+
+void ska_render_queue_sort(SkaRenderQueue* queue) {
+    // Keys are pushed in submission order, so the command index bits never need a pass
+    ska_array_utils_radix_sort_uint64(queue->keys, queue->sortScratch, queue->count, SKA_RENDER_QUEUE_KEY_TEXTURE_SHIFT);
+}
+
+void ska_render_queue_remove_hidden_sprites(SkaRenderQueue* queue, const bool* spriteVisibility) {
+    usize keptCount = 0;
+    for (usize i = 0; i < queue->count; i++) {
+        const uint64 key = queue->keys[i];
+        if (ska_render_queue_key_get_type(key) == SkaRenderQueueItemType_FONT || spriteVisibility[ska_render_queue_key_get_index(key)]) {
+            queue->keys[keptCount++] = key;
+        }
+    }
+    queue->count = keptCount;
+}
+
+void ska_render_queue_clear(SkaRenderQueue* queue) {
+    queue->count = 0;
+    render_queue_handle_table_clear(&queue->shaders);
+    render_queue_handle_table_clear(&queue->textures);
+}
+
+usize ska_render_queue_get_memory_size(const SkaRenderQueue* queue) {
+    const usize tableSlotSize = sizeof(uint64) + sizeof(uint32) + sizeof(uint32);
+    return sizeof(SkaRenderQueue) + queue->capacity * 2 * sizeof(uint64)
+        + (usize)(queue->shaders.capacity + queue->textures.capacity) * tableSlotSize;
+}
+
+#undef SKA_RENDER_QUEUE_NO_ORDINAL
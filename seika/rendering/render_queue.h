@@ -0,0 +1,91 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/defines.h"
+
+// Distinct shaders and textures per frame, limited by their bits in the sort key.  The last ordinal is shared by every
+// handle past the limit, items with such a key have the same batch key without sharing their shader or texture.
+#define SKA_RENDER_QUEUE_MAX_SHADERS 2048
+#define SKA_RENDER_QUEUE_MAX_TEXTURES 4096
+#define SKA_RENDER_QUEUE_SHADER_OVERFLOW_ORDINAL (SKA_RENDER_QUEUE_MAX_SHADERS - 1)
+#define SKA_RENDER_QUEUE_TEXTURE_OVERFLOW_ORDINAL (SKA_RENDER_QUEUE_MAX_TEXTURES - 1)
+
+// Sort key layout, from the most significant bit:
+//   z index (8) | item type (1) | shader (11) | texture (12) | command index (32)
+// Shaders and textures are numbered in the order they are first queued in a frame.  Only the upper 32 bits are sorted, the
+// command index is the submission order and is kept stable by the sort.
+#define SKA_RENDER_QUEUE_KEY_Z_INDEX_SHIFT 56
+#define SKA_RENDER_QUEUE_KEY_TYPE_SHIFT 55
+#define SKA_RENDER_QUEUE_KEY_SHADER_SHIFT 44
+#define SKA_RENDER_QUEUE_KEY_TEXTURE_SHIFT 32
+#define SKA_RENDER_QUEUE_KEY_INDEX_MASK 0xFFFFFFFFull
+
+typedef enum SkaRenderQueueItemType {
+    SkaRenderQueueItemType_SPRITE = 0,
+    SkaRenderQueueItemType_FONT = 1, // Drawn after the sprites of the same z index
+} SkaRenderQueueItemType;
+
+// Open addressing table numbering handles (shader pointers, texture ids) in the order they are first seen.  Cleared by
+// bumping the generation, so clearing doesn't touch the table.
+typedef struct SkaRenderQueueHandleTable {
+    uint64* handles;
+    uint32* ordinals;
+    uint32* generations;
+    uint32 capacity; // Power of two
+    uint32 count;
+    uint32 maxCount; // Includes the overflow ordinal, so at most 'maxCount - 1' handles get their own
+    uint32 generation;
+    uint64 lastHandle; // Consecutive items usually share their shader and texture
+    uint32 lastOrdinal;
+} SkaRenderQueueHandleTable;
+
+// Per frame queue of draw items as 64 bit sort keys, items themselves live in the caller's dense command arrays.  Grows as
+// needed, there are no per z index or per batch caps.
+typedef struct SkaRenderQueue {
+    uint64* keys;
+    uint64* sortScratch;
+    usize count;
+    usize capacity;
+    SkaRenderQueueHandleTable shaders;
+    SkaRenderQueueHandleTable textures;
+} SkaRenderQueue;
+
+SkaRenderQueue* ska_render_queue_create(usize initialCapacity);
+void ska_render_queue_destroy(SkaRenderQueue* queue);
+// 'arrayZIndex' is the z index offset into [0, 256), 'commandIndex' is the item's index in the caller's command array
+void ska_render_queue_push_sprite(SkaRenderQueue* queue, uint32 arrayZIndex, const void* shader, uint32 textureId, uint32 commandIndex);
+// 'textureId' is the font's atlas texture, text of the same font and z index shares a batch key
+void ska_render_queue_push_font(SkaRenderQueue* queue, uint32 arrayZIndex, uint32 textureId, uint32 commandIndex);
+// Sorts keys by z index, item type, shader and texture, items with equal keys stay in submission order
+void ska_render_queue_sort(SkaRenderQueue* queue);
+// Removes sprite keys whose 'spriteVisibility' entry (by command index) is false, fonts and the order of kept keys are unchanged
+void ska_render_queue_remove_hidden_sprites(SkaRenderQueue* queue, const bool* spriteVisibility);
+void ska_render_queue_clear(SkaRenderQueue* queue);
+// Bytes currently allocated by the queue
+usize ska_render_queue_get_memory_size(const SkaRenderQueue* queue);
+
+// Items with the same batch key share z index, type, shader and texture
+static inline uint32 ska_render_queue_key_get_batch(uint64 key) {
+    return (uint32)(key >> SKA_RENDER_QUEUE_KEY_TEXTURE_SHIFT);
+}
+
+// Whether the shader or texture overflowed the per frame limit, items of the batch then have to be compared by their handles
+static inline bool ska_render_queue_key_is_overflow(uint64 key) {
+    return ((key >> SKA_RENDER_QUEUE_KEY_SHADER_SHIFT) & (SKA_RENDER_QUEUE_MAX_SHADERS - 1)) == SKA_RENDER_QUEUE_SHADER_OVERFLOW_ORDINAL
+        || ((key >> SKA_RENDER_QUEUE_KEY_TEXTURE_SHIFT) & (SKA_RENDER_QUEUE_MAX_TEXTURES - 1)) == SKA_RENDER_QUEUE_TEXTURE_OVERFLOW_ORDINAL;
+}
+
+static inline SkaRenderQueueItemType ska_render_queue_key_get_type(uint64 key) {
+    return (SkaRenderQueueItemType)((key >> SKA_RENDER_QUEUE_KEY_TYPE_SHIFT) & 1);
+}
+
+static inline uint32 ska_render_queue_key_get_index(uint64 key) {
+    return (uint32)(key & SKA_RENDER_QUEUE_KEY_INDEX_MASK);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,49 +4,71 @@
 
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "render_context.h"
+#include "render_queue.h"
+#include "sprite_culling.h"
+#include "sprite_batch.h"
+#include "stream_ring.h"
 #include "shader/shader.h"
 #include "shader/shader_cache.h"
 #include "shader/shader_source.h"
 #include "seika/assert.h"
 #include "seika/logger.h"
-#include "seika/data_structures/static_array.h"
+#include "seika/memory.h"
 
 #define SKA_RENDER_TO_FRAMEBUFFER
-#define SKA_RENDER_LAYER_BATCH_ITEM_MAX 1024
-#define SKA_RENDER_LAYER_FONT_BATCH_ITEM_MAX 100
-#define SKA_RENDER_TEXTURE_LAYER_TEXTURE_MAX 64
+// Initial capacities of the per frame command arrays, they grow to the largest amount queued in a frame
+#define SKA_RENDERER_INITIAL_SPRITE_CAPACITY 1024
+#define SKA_RENDERER_INITIAL_FONT_CAPACITY 64
 
 #ifdef SKA_RENDER_TO_FRAMEBUFFER
 #include "frame_buffer.h"
 #endif
 
-typedef struct SkaTextureCoordinates {
-    GLfloat sMin;
-    GLfloat sMax;
-    GLfloat tMin;
-    GLfloat tMax;
-} SkaTextureCoordinates;
-
-static SkaTextureCoordinates renderer_get_texture_coordinates(const SkaTexture* texture, const SkaRect2* drawSource, bool flipH, bool flipV);
 static void renderer_set_shader_instance_params(SkaShaderInstance* shaderInstance);
 static void renderer_print_opengl_errors();
 
 static void sprite_renderer_initialize();
 static void sprite_renderer_finalize();
 static void sprite_renderer_update_resolution();
+static bool sprite_renderer_stream_batch_sprites();
 
 static void font_renderer_initialize();
 static void font_renderer_finalize();
 static void font_renderer_update_resolution();
-static void font_renderer_draw_text(const SkaFont* font, const char* text, f32 x, f32 y, f32 scale, const SkaColor* color);
-
+static bool font_renderer_stream_text();
+static void font_renderer_draw_text(const SkaFont* font, GLint firstGlyph, GLsizei glyphCount);
+
+// Streaming array buffer written once per frame, see 'renderer_stream_buffer_map'
+typedef struct RendererStreamBuffer {
+    GLuint vbo;
+    SkaStreamRing ring;
+    // Range being written, either mapped or in 'stagingData' when mapping isn't available
+    GLintptr writeOffset;
+    GLsizeiptr writeSize;
+    unsigned char* stagingData;
+    usize stagingCapacity;
+    bool isStaged;
+} RendererStreamBuffer;
+
+static void renderer_stream_buffer_initialize(RendererStreamBuffer* buffer, GLsizeiptr initialSize);
+static void renderer_stream_buffer_finalize(RendererStreamBuffer* buffer);
+static void* renderer_stream_buffer_map(RendererStreamBuffer* buffer, GLsizeiptr size, GLintptr* outOffset);
+static bool renderer_stream_buffer_unmap(RendererStreamBuffer* buffer);
+
+static SkaRendererSpriteMode spriteMode = SkaRendererSpriteMode_VERTICES;
 static GLuint spriteQuadVAO;
-static GLuint spriteQuadVBO;
+static GLuint spriteQuadVBO; // Unit quad for instanced sprites
+static RendererStreamBuffer spriteStream;
+static GLuint fontVAO;
+static GLuint fontQuadVBO; // Unit quad the glyph quad instances are drawn with
+static RendererStreamBuffer fontStream;
 
 static SkaShader* spriteShader = NULL;
 static SkaShader* fontShader = NULL;
+static SkaShader* fontSdfShader = NULL;
 
 // Global Shader Params
 static f32 globalShaderParamTime = 0.0f;
@@ -68,39 +90,49 @@ typedef struct SpriteBatchItem {
     SkaColor color;
     bool flipH;
     bool flipV;
-    SkaRendererTransform2D transform2D;
+    SkaAffine2D model;
     SkaShaderInstance* shaderInstance;
 } SpriteBatchItem;
 
 typedef struct FontBatchItem {
     SkaFont* font;
+    SkaTextLayout* layout; // Cached glyph quads are copied instead of laying out 'text' when set
     const char* text;
     f32 x;
     f32 y;
     f32 scale;
     SkaColor color;
+    GLint firstGlyph; // Set once the frame's text is streamed
+    GLsizei glyphCount;
 } FontBatchItem;
 
-void renderer_batching_draw_sprites(SpriteBatchItem items[], usize spriteCount);
-
-// Render Layer - Arranges draw order by z index
-typedef struct RenderTextureLayer {
-    SpriteBatchItem spriteBatchItems[SKA_RENDER_LAYER_BATCH_ITEM_MAX];
-    usize spriteBatchItemCount;
-} RenderTextureLayer;
-
-typedef struct RenderLayer {
-    RenderTextureLayer renderTextureLayers[SKA_RENDER_TEXTURE_LAYER_TEXTURE_MAX];
-    FontBatchItem fontBatchItems[SKA_RENDER_LAYER_FONT_BATCH_ITEM_MAX];
-    usize renderTextureLayerCount;
-    usize fontBatchItemCount;
-} RenderLayer;
-
-SKA_STATIC_ARRAY_CREATE(RenderLayer, SKA_RENDERER_MAX_Z_INDEX, render_layer_items);
-SKA_STATIC_ARRAY_CREATE(int32, SKA_RENDERER_MAX_Z_INDEX, active_render_layer_items_indices);
+void renderer_batching_draw_sprites(const SpriteBatchItem* firstItem, usize spriteCount, GLint firstSprite);
+
+// Draw order - Items are stored densely in submission order and drawn in the order of their render queue sort keys
+// (z index, sprites before fonts, shader, texture).  Consecutive sprites with the same key form a batch.
+static SpriteBatchItem* spriteBatchItems = NULL;
+static usize spriteBatchItemCount = 0;
+static usize spriteBatchItemCapacity = 0;
+static FontBatchItem* fontBatchItems = NULL;
+static usize fontBatchItemCount = 0;
+static usize fontBatchItemCapacity = 0;
+static usize fontBatchTextLength = 0; // Bytes of all queued text without a layout, bounds their glyph count
+static SkaRenderQueue* renderQueue = NULL;
+
+// Culling
+static bool isSpriteCullingEnabled = false;
+static SkaSpriteCullingBounds* spriteCullingBounds = NULL;
+static bool* spriteVisibility = NULL; // Per sprite batch item
+static usize spriteVisibilityCapacity = 0;
+static SkaRendererStats rendererStats = {0};
 
 // Renderer
 void ska_renderer_initialize(int32 inWindowWidth, int32 inWindowHeight, int32 inResolutionWidth, int32 inResolutionHeight, bool maintainAspectRatio) {
+    ska_renderer_initialize2(inWindowWidth, inWindowHeight, inResolutionWidth, inResolutionHeight, maintainAspectRatio, SkaRendererSpriteMode_VERTICES);
+}
+
+void ska_renderer_initialize2(int32 inWindowWidth, int32 inWindowHeight, int32 inResolutionWidth, int32 inResolutionHeight, bool maintainAspectRatio, SkaRendererSpriteMode inSpriteMode) {
+    spriteMode = inSpriteMode;
     resolutionWidth = (f32)inResolutionWidth;
     resolutionHeight = (f32)inResolutionHeight;
     glEnable(GL_CULL_FACE);
@@ -117,14 +149,19 @@ void ska_renderer_initialize(int32 inWindowWidth, int32 inWindowHeight, int32 in
     SKA_ASSERT_FMT(ska_frame_buffer_initialize(inWindowWidth, inWindowHeight, inResolutionWidth, inResolutionHeight), "Framebuffer didn't initialize!");
     ska_frame_buffer_set_maintain_aspect_ratio(maintainAspectRatio);
 #endif
-    // Set initial data for render layer
-    for (usize i = 0; i < SKA_RENDERER_MAX_Z_INDEX; i++) {
-        render_layer_items[i].renderTextureLayerCount = 0;
-        render_layer_items[i].fontBatchItemCount = 0;
-        for (usize j = 0; j < SKA_RENDER_TEXTURE_LAYER_TEXTURE_MAX; j++) {
-            render_layer_items[i].renderTextureLayers[j].spriteBatchItemCount = 0;
-        }
-    }
+    // Set initial data for draw order
+    spriteBatchItemCapacity = SKA_RENDERER_INITIAL_SPRITE_CAPACITY;
+    spriteBatchItemCount = 0;
+    spriteBatchItems = (SpriteBatchItem*)SKA_ALLOC_BYTES(spriteBatchItemCapacity * sizeof(SpriteBatchItem));
+    fontBatchItemCapacity = SKA_RENDERER_INITIAL_FONT_CAPACITY;
+    fontBatchItemCount = 0;
+    fontBatchTextLength = 0;
+    fontBatchItems = (FontBatchItem*)SKA_ALLOC_BYTES(fontBatchItemCapacity * sizeof(FontBatchItem));
+    renderQueue = ska_render_queue_create(SKA_RENDERER_INITIAL_SPRITE_CAPACITY);
+    spriteCullingBounds = ska_sprite_culling_bounds_create(SKA_RENDERER_INITIAL_SPRITE_CAPACITY);
+    spriteVisibilityCapacity = SKA_RENDERER_INITIAL_SPRITE_CAPACITY;
+    spriteVisibility = (bool*)SKA_ALLOC_BYTES(spriteVisibilityCapacity * sizeof(bool));
+    rendererStats = (SkaRendererStats){0};
 }
 
 void ska_renderer_finalize() {
@@ -132,6 +169,22 @@ void ska_renderer_finalize() {
     sprite_renderer_finalize();
     ska_render_context_finalize();
     ska_shader_cache_finalize();
+    SKA_FREE(spriteBatchItems);
+    spriteBatchItems = NULL;
+    spriteBatchItemCount = 0;
+    spriteBatchItemCapacity = 0;
+    SKA_FREE(fontBatchItems);
+    fontBatchItems = NULL;
+    fontBatchItemCount = 0;
+    fontBatchItemCapacity = 0;
+    fontBatchTextLength = 0;
+    ska_render_queue_destroy(renderQueue);
+    renderQueue = NULL;
+    ska_sprite_culling_bounds_destroy(spriteCullingBounds);
+    spriteCullingBounds = NULL;
+    SKA_FREE(spriteVisibility);
+    spriteVisibility = NULL;
+    spriteVisibilityCapacity = 0;
 #ifdef SKA_RENDER_TO_FRAMEBUFFER
     ska_frame_buffer_finalize();
 #endif
@@ -156,36 +209,23 @@ void ska_renderer_update_window_size(int32 windowWidth, int32 windowHeight) {
 #endif
 }
 
-static inline void update_active_render_layer_index(int32 zIndex) {
-    const usize sizeBefore = SKA_STATIC_ARRAY_SIZE(active_render_layer_items_indices);
-    SKA_STATIC_ARRAY_ADD_IF_UNIQUE(active_render_layer_items_indices, zIndex);
-    const usize sizeAfter = SKA_STATIC_ARRAY_SIZE(active_render_layer_items_indices);
-    if (sizeBefore != sizeAfter) {
-        SKA_STATIC_ARRAY_SORT_INT(active_render_layer_items_indices);
-    }
+static inline uint32 ska_renderer_get_array_z_index(int32 zIndex) {
+    return (uint32)ska_math_clamp_int(zIndex + SKA_RENDERER_MAX_Z_INDEX / 2, 0, SKA_RENDERER_MAX_Z_INDEX - 1);
 }
 
-static inline void ska_renderer_queue_sprite_draw_call(SpriteBatchItem* item, int32 zIndex) {
-    const int32 arrayZIndex = ska_math_clamp_int(zIndex + SKA_RENDERER_MAX_Z_INDEX / 2, 0, SKA_RENDERER_MAX_Z_INDEX - 1);
-    // Get texture layer index for render texture
-    usize textureLayerIndex = render_layer_items[arrayZIndex].renderTextureLayerCount;
-    for (usize i = 0; i < render_layer_items[arrayZIndex].renderTextureLayerCount; i++) {
-        if (item->texture == render_layer_items[arrayZIndex].renderTextureLayers[i].spriteBatchItems[0].texture && item->shaderInstance == render_layer_items[arrayZIndex].renderTextureLayers[i].spriteBatchItems[0].shaderInstance) {
-            textureLayerIndex = i;
-            break;
-        }
+// Returns the next sprite batch item slot, 'ska_renderer_push_sprite_batch_item' queues it once filled in
+static inline SpriteBatchItem* ska_renderer_get_next_sprite_batch_item() {
+    if (spriteBatchItemCount >= spriteBatchItemCapacity) {
+        spriteBatchItemCapacity *= 2;
+        spriteBatchItems = (SpriteBatchItem*)ska_mem_reallocate(spriteBatchItems, spriteBatchItemCapacity * sizeof(SpriteBatchItem));
     }
-    RenderTextureLayer* textureLayer =  &render_layer_items[arrayZIndex].renderTextureLayers[textureLayerIndex];
-    // Increment render texture layer count if first sprite
-    if (textureLayer->spriteBatchItemCount == 0) {
-        render_layer_items[arrayZIndex].renderTextureLayerCount++;
-    }
-    // Copy batch item into batch items array and increment item count
-    SKA_ASSERT_FMT(textureLayer->spriteBatchItemCount + 1 < SKA_RENDER_LAYER_BATCH_ITEM_MAX, "Exceeded SKA_RENDER_LAYER_BATCH_ITEM_MAX '%d'", SKA_RENDER_LAYER_BATCH_ITEM_MAX);
-    SpriteBatchItem* currentItem = &textureLayer->spriteBatchItems[textureLayer->spriteBatchItemCount++];
-    memcpy(currentItem, item, sizeof(SpriteBatchItem));
-    // Update active render layer indices
-    update_active_render_layer_index(arrayZIndex);
+    return &spriteBatchItems[spriteBatchItemCount];
+}
+
+static inline void ska_renderer_push_sprite_batch_item(int32 zIndex) {
+    const SpriteBatchItem* item = &spriteBatchItems[spriteBatchItemCount];
+    ska_render_queue_push_sprite(renderQueue, ska_renderer_get_array_z_index(zIndex), item->shaderInstance, item->texture->id, (uint32)spriteBatchItemCount);
+    spriteBatchItemCount++;
 }
 
 void ska_renderer_queue_sprite_draw(SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, const SkaTransform2D* transform2D, int32 zIndex, SkaShaderInstance* shaderInstance) {
@@ -193,9 +233,10 @@ void ska_renderer_queue_sprite_draw(SkaTexture* texture, SkaRect2 sourceRect, Sk
         ska_logger_error("NULL texture, not submitting draw call!");
         return;
     }
-    SpriteBatchItem item = (SpriteBatchItem){ .texture = texture, .sourceRect = sourceRect, .destSize = destSize, .color = color, .flipH = flipH, .flipV = flipV, .transform2D = { .model = {{0}} }, .shaderInstance = shaderInstance };
-    ska_transform2d_transform_to_mat4(transform2D, item.transform2D.model);
-    ska_renderer_queue_sprite_draw_call(&item, zIndex);
+    SpriteBatchItem* item = ska_renderer_get_next_sprite_batch_item();
+    *item = (SpriteBatchItem){ .texture = texture, .sourceRect = sourceRect, .destSize = destSize, .color = color, .flipH = flipH, .flipV = flipV, .shaderInstance = shaderInstance };
+    ska_affine2d_from_transform(transform2D, &item->model);
+    ska_renderer_push_sprite_batch_item(zIndex);
 }
 
 void ska_renderer_queue_sprite_draw2(SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, mat4 trsMatrix, int32 zIndex, SkaShaderInstance* shaderInstance) {
@@ -203,9 +244,31 @@ void ska_renderer_queue_sprite_draw2(SkaTexture* texture, SkaRect2 sourceRect, S
         ska_logger_error("NULL texture, not submitting draw call!");
         return;
     }
-    SpriteBatchItem item = (SpriteBatchItem){ .texture = texture, .sourceRect = sourceRect, .destSize = destSize, .color = color, .flipH = flipH, .flipV = flipV, .transform2D = { .model = {{0}} }, .shaderInstance = shaderInstance };
-    glm_mat4_copy(trsMatrix, item.transform2D.model);
-    ska_renderer_queue_sprite_draw_call(&item, zIndex);
+    SpriteBatchItem* item = ska_renderer_get_next_sprite_batch_item();
+    *item = (SpriteBatchItem){ .texture = texture, .sourceRect = sourceRect, .destSize = destSize, .color = color, .flipH = flipH, .flipV = flipV, .shaderInstance = shaderInstance };
+    ska_affine2d_from_mat4(trsMatrix, &item->model);
+    ska_renderer_push_sprite_batch_item(zIndex);
+}
+
+void ska_renderer_queue_sprite_draw_buffers(SkaSpriteDrawBuffer* const* drawBuffers, usize drawBufferCount) {
+    // The render queue sorts by z index and batch, so commands are queued as is in buffer order
+    for (usize bufferIndex = 0; bufferIndex < drawBufferCount; bufferIndex++) {
+        SkaSpriteDrawBuffer* drawBuffer = drawBuffers[bufferIndex];
+        for (usize i = 0; i < drawBuffer->count; i++) {
+            const SkaSpriteDrawCommand* command = &drawBuffer->commands[i];
+            SpriteBatchItem* item = ska_renderer_get_next_sprite_batch_item();
+            item->texture = command->texture;
+            item->sourceRect = command->sourceRect;
+            item->destSize = command->destSize;
+            item->color = command->color;
+            item->flipH = command->flipH;
+            item->flipV = command->flipV;
+            item->model = command->model;
+            item->shaderInstance = command->shaderInstance;
+            ska_renderer_push_sprite_batch_item(command->zIndex);
+        }
+        ska_sprite_draw_buffer_clear(drawBuffer);
+    }
 }
 
 void ska_renderer_queue_font_draw_call(SkaFont* font, const char* text, f32 x, f32 y, f32 scale, SkaColor color, int32 zIndex) {
@@ -213,41 +276,116 @@ void ska_renderer_queue_font_draw_call(SkaFont* font, const char* text, f32 x, f
         ska_logger_error("NULL font, not submitting draw call!");
         return;
     }
+    if (!font->isValid) {
+        ska_logger_error("Invalid font, not submitting draw call!");
+        return;
+    }
+
+    if (fontBatchItemCount >= fontBatchItemCapacity) {
+        fontBatchItemCapacity *= 2;
+        fontBatchItems = (FontBatchItem*)ska_mem_reallocate(fontBatchItems, fontBatchItemCapacity * sizeof(FontBatchItem));
+    }
+    fontBatchItems[fontBatchItemCount] = (FontBatchItem){ .font = font, .text = text, .x = x, .y = y, .scale = scale, .color = color };
+    ska_render_queue_push_font(renderQueue, ska_renderer_get_array_z_index(zIndex), font->atlasTextureId, (uint32)fontBatchItemCount);
+    fontBatchItemCount++;
+    fontBatchTextLength += strlen(text);
+}
+
+void ska_renderer_queue_text_layout_draw_call(SkaTextLayout* layout, int32 zIndex) {
+    if (layout == NULL || !layout->font->isValid) {
+        ska_logger_error("NULL text layout or invalid font, not submitting draw call!");
+        return;
+    }
+
+    if (fontBatchItemCount >= fontBatchItemCapacity) {
+        fontBatchItemCapacity *= 2;
+        fontBatchItems = (FontBatchItem*)ska_mem_reallocate(fontBatchItems, fontBatchItemCapacity * sizeof(FontBatchItem));
+    }
+    fontBatchItems[fontBatchItemCount] = (FontBatchItem){ .font = layout->font, .layout = layout };
+    ska_render_queue_push_font(renderQueue, ska_renderer_get_array_z_index(zIndex), layout->font->atlasTextureId, (uint32)fontBatchItemCount);
+    fontBatchItemCount++;
+}
+
+void ska_renderer_set_sprite_culling_enabled(bool enabled) {
+    isSpriteCullingEnabled = enabled;
+}
+
+SkaRendererStats ska_renderer_get_stats() {
+    return rendererStats;
+}
+
+// Removes sprites outside of the resolution's rect from the render queue before they are sorted and uploaded
+static void ska_renderer_cull_sprites() {
+    rendererStats.submittedSprites = spriteBatchItemCount;
+    rendererStats.drawnSprites = spriteBatchItemCount;
+    if (!isSpriteCullingEnabled || spriteBatchItemCount == 0) {
+        return;
+    }
+    ska_sprite_culling_bounds_clear(spriteCullingBounds);
+    for (usize i = 0; i < spriteBatchItemCount; i++) {
+        ska_sprite_culling_bounds_add(spriteCullingBounds, &spriteBatchItems[i].model, spriteBatchItems[i].destSize);
+    }
+    if (spriteVisibilityCapacity < spriteBatchItemCapacity) {
+        spriteVisibilityCapacity = spriteBatchItemCapacity;
+        spriteVisibility = (bool*)ska_mem_reallocate(spriteVisibility, spriteVisibilityCapacity * sizeof(bool));
+    }
+    const SkaRect2 view = { 0.0f, 0.0f, resolutionWidth, resolutionHeight };
+    rendererStats.drawnSprites = ska_sprite_culling_test_view(spriteCullingBounds, &view, spriteVisibility);
+    if (rendererStats.drawnSprites < spriteBatchItemCount) {
+        ska_render_queue_remove_hidden_sprites(renderQueue, spriteVisibility);
+    }
+}
 
-    FontBatchItem item = { .font = font, .text = text, .x = x, .y = y, .scale = scale, .color = color };
-    const int32 arrayZIndex = ska_math_clamp_int(zIndex + SKA_RENDERER_MAX_Z_INDEX / 2, 0, SKA_RENDERER_MAX_Z_INDEX - 1);
-    // Update font batch item on render layer
-    render_layer_items[arrayZIndex].fontBatchItems[render_layer_items[arrayZIndex].fontBatchItemCount++] = item;
-    // Update active render layer indices
-    update_active_render_layer_index(arrayZIndex);
+// Items past the render queue's shader or texture limit share a batch key, they only form a batch with the same handles
+static bool renderer_are_items_batched(uint64 key, uint64 otherKey) {
+    const uint32 index = ska_render_queue_key_get_index(key);
+    const uint32 otherIndex = ska_render_queue_key_get_index(otherKey);
+    if (ska_render_queue_key_get_type(key) == SkaRenderQueueItemType_FONT) {
+        return fontBatchItems[index].font->atlasTextureId == fontBatchItems[otherIndex].font->atlasTextureId;
+    }
+    return spriteBatchItems[index].texture->id == spriteBatchItems[otherIndex].texture->id
+        && spriteBatchItems[index].shaderInstance == spriteBatchItems[otherIndex].shaderInstance;
 }
 
 static void ska_renderer_flush_batches() {
-    for (usize i = 0; i < active_render_layer_items_indices_count; i++) {
-        const usize layerIndex = active_render_layer_items_indices[i];
-        // Sprite
-        for (usize renderTextureIndex = 0; renderTextureIndex < render_layer_items[layerIndex].renderTextureLayerCount; renderTextureIndex++) {
-            RenderTextureLayer* renderTextureLayer = &render_layer_items[layerIndex].renderTextureLayers[renderTextureIndex];
-            renderer_batching_draw_sprites(renderTextureLayer->spriteBatchItems, renderTextureLayer->spriteBatchItemCount);
-            renderTextureLayer->spriteBatchItemCount = 0;
+    ska_renderer_cull_sprites();
+    rendererStats.drawCalls = 0;
+    ska_render_queue_sort(renderQueue);
+    const bool areSpritesStreamed = sprite_renderer_stream_batch_sprites();
+    const bool isTextStreamed = font_renderer_stream_text();
+    GLint firstSprite = 0;
+    for (usize i = 0; i < renderQueue->count;) {
+        const uint64 key = renderQueue->keys[i];
+        const uint32 batch = ska_render_queue_key_get_batch(key);
+        const bool isOverflow = ska_render_queue_key_is_overflow(key);
+        usize batchEnd = i + 1;
+        while (batchEnd < renderQueue->count && ska_render_queue_key_get_batch(renderQueue->keys[batchEnd]) == batch
+               && (!isOverflow || renderer_are_items_batched(key, renderQueue->keys[batchEnd]))) {
+            batchEnd++;
+        }
+        if (ska_render_queue_key_get_type(key) == SkaRenderQueueItemType_FONT) {
+            // Text batch, all glyphs of the batch's text were streamed after each other
+            if (isTextStreamed) {
+                const FontBatchItem* firstItem = &fontBatchItems[ska_render_queue_key_get_index(key)];
+                const FontBatchItem* lastItem = &fontBatchItems[ska_render_queue_key_get_index(renderQueue->keys[batchEnd - 1])];
+                font_renderer_draw_text(firstItem->font, firstItem->firstGlyph, lastItem->firstGlyph + lastItem->glyphCount - firstItem->firstGlyph);
+            }
+            i = batchEnd;
+            continue;
         }
-        render_layer_items[layerIndex].renderTextureLayerCount = 0;
-        // Font
-        for (usize fontIndex = 0; fontIndex < render_layer_items[layerIndex].fontBatchItemCount; fontIndex++) {
-            font_renderer_draw_text(
-                render_layer_items[layerIndex].fontBatchItems[fontIndex].font,
-                render_layer_items[layerIndex].fontBatchItems[fontIndex].text,
-                render_layer_items[layerIndex].fontBatchItems[fontIndex].x,
-                render_layer_items[layerIndex].fontBatchItems[fontIndex].y,
-                render_layer_items[layerIndex].fontBatchItems[fontIndex].scale,
-                &render_layer_items[layerIndex].fontBatchItems[fontIndex].color
-            );
+        // Sprite batch, sprites were streamed in sorted order
+        const usize spriteCount = batchEnd - i;
+        if (areSpritesStreamed) {
+            renderer_batching_draw_sprites(&spriteBatchItems[ska_render_queue_key_get_index(key)], spriteCount, firstSprite);
         }
-        render_layer_items[layerIndex].fontBatchItemCount = 0;
+        firstSprite += (GLint)spriteCount;
+        i = batchEnd;
     }
 
-    SKA_STATIC_ARRAY_EMPTY(render_layer_items);
-    SKA_STATIC_ARRAY_EMPTY(active_render_layer_items_indices);
+    spriteBatchItemCount = 0;
+    fontBatchItemCount = 0;
+    fontBatchTextLength = 0;
+    ska_render_queue_clear(renderQueue);
 }
 
 void ska_renderer_process_and_flush_batches(const SkaColor* backgroundColor) {
@@ -302,43 +440,125 @@ void ska_renderer_process_and_flush_batches_just_framebuffer(const SkaColor *bac
 }
 #endif
 
+// --- Stream Buffer --- //
+// Each frame is appended after the previous one (unsynchronized mapping, the gpu may still be reading older ranges) and
+// the buffer storage is orphaned once the end is reached, so uploads never stall on draws still in flight.  Where buffers
+// can't be mapped (WebGL2) or mapping fails the range is written to a cpu copy and uploaded with 'glBufferSubData'.
+#if defined(PLATFORM_EMSCRIPTEN)
+#define RENDERER_STREAM_BUFFER_CAN_MAP 0
+#else
+#define RENDERER_STREAM_BUFFER_CAN_MAP 1
+#endif
+
+void renderer_stream_buffer_initialize(RendererStreamBuffer* buffer, GLsizeiptr initialSize) {
+    *buffer = (RendererStreamBuffer){0};
+    glGenBuffers(1, &buffer->vbo);
+    ska_stream_ring_initialize(&buffer->ring, (usize)initialSize);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)buffer->ring.size, NULL, GL_STREAM_DRAW);
+}
+
+void renderer_stream_buffer_finalize(RendererStreamBuffer* buffer) {
+    glDeleteBuffers(1, &buffer->vbo);
+    SKA_FREE(buffer->stagingData);
+    *buffer = (RendererStreamBuffer){0};
+}
+
+// Expects the stream buffer to be bound, 'outOffset' is the byte offset of the returned range.  Finish writing with
+// 'renderer_stream_buffer_unmap'.
+void* renderer_stream_buffer_map(RendererStreamBuffer* buffer, GLsizeiptr size, GLintptr* outOffset) {
+    const SkaStreamRingRange range = ska_stream_ring_reserve(&buffer->ring, (usize)size);
+    if (range.needsNewStorage) {
+        // Orphans the storage, the driver hands out new memory while draws still using the old storage finish
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)buffer->ring.size, NULL, GL_STREAM_DRAW);
+    }
+    buffer->writeOffset = (GLintptr)range.offset;
+    buffer->writeSize = size;
+    *outOffset = buffer->writeOffset;
+#if RENDERER_STREAM_BUFFER_CAN_MAP
+    void* data = glMapBufferRange(GL_ARRAY_BUFFER, buffer->writeOffset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (data != NULL) {
+        buffer->isStaged = false;
+        return data;
+    }
+    // Clear the error of the failed mapping so it isn't reported later on
+    while (glGetError() != GL_NO_ERROR) {}
+#endif
+    if (buffer->stagingCapacity < (usize)size) {
+        SKA_FREE(buffer->stagingData);
+        buffer->stagingData = (unsigned char*)SKA_ALLOC_BYTES((usize)size);
+        buffer->stagingCapacity = (usize)size;
+    }
+    buffer->isStaged = true;
+    return buffer->stagingData;
+}
+
+// Expects the stream buffer to be bound, returns false if the written range was lost and shouldn't be drawn
+bool renderer_stream_buffer_unmap(RendererStreamBuffer* buffer) {
+    if (buffer->isStaged) {
+        glBufferSubData(GL_ARRAY_BUFFER, buffer->writeOffset, buffer->writeSize, buffer->stagingData);
+        return true;
+    }
+#if RENDERER_STREAM_BUFFER_CAN_MAP
+    return glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+#else
+    return false;
+#endif
+}
+
+#undef RENDERER_STREAM_BUFFER_CAN_MAP
+
 // --- Sprite Renderer --- //
-#define VERTS_STRIDE 10
-void sprite_renderer_initialize() {
-    GLfloat vertices[] = {
-        //id (1) // positions (2) // texture coordinates (2) // color (4) // is pixel art (1)
-        0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-
-        0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f
-    };
+// Initial size of the sprite stream buffer, grows when a frame's sprites don't fit
+#define SPRITE_STREAM_BUFFER_INITIAL_SIZE (4 * 1024 * 1024)
+
+// Sprite data of all batches is written once per frame into a streaming buffer, as 'SKA_SPRITE_BATCH_VERTICES_PER_SPRITE'
+// vertices per sprite or a single instance per sprite for 'SkaRendererSpriteMode_INSTANCED'.
+static GLint spriteStreamFirstSprite = 0; // Stream index of the current frame's first sprite
+
+static inline GLsizeiptr sprite_renderer_get_sprite_stream_size() {
+    return spriteMode == SkaRendererSpriteMode_INSTANCED ? (GLsizeiptr)sizeof(SkaSpriteInstance) : (GLsizeiptr)(SKA_SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SkaSpriteVertex));
+}
+
+// Points the per sprite attributes at sprite data starting at 'offset' in the bound array buffer
+static void sprite_renderer_set_sprite_attributes(GLsizei stride, GLintptr offset) {
+    // texture rect attribute
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + offsetof(SkaSpriteInstance, uvRect)));
+    // color attribute
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + offsetof(SkaSpriteInstance, color)));
+    // is pixel art attribute
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + offsetof(SkaSpriteInstance, applyNearestNeighbor)));
+    // model attributes
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + offsetof(SkaSpriteInstance, modelBasis)));
+    glVertexAttribPointer(5, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + offsetof(SkaSpriteInstance, modelOrigin)));
+}
 
+void sprite_renderer_initialize() {
     // Initialize render data
     glGenVertexArrays(1, &spriteQuadVAO);
-    glGenBuffers(1, &spriteQuadVBO);
+    glBindVertexArray(spriteQuadVAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, spriteQuadVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
+    if (spriteMode == SkaRendererSpriteMode_INSTANCED) {
+        // Static unit quad, everything else is instance data
+        glGenBuffers(1, &spriteQuadVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, spriteQuadVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(SKA_SPRITE_BATCH_QUAD_CORNERS), SKA_SPRITE_BATCH_QUAD_CORNERS, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)NULL);
+    }
+
+    renderer_stream_buffer_initialize(&spriteStream, SPRITE_STREAM_BUFFER_INITIAL_SIZE);
 
-    glBindVertexArray(spriteQuadVAO);
-    // id attribute
-    glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, VERTS_STRIDE * sizeof(GLfloat), (void*) NULL);
-    glEnableVertexAttribArray(0);
     // position attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, VERTS_STRIDE * sizeof(GLfloat), (GLvoid*)(sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-    // texture coords attribute
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTS_STRIDE * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(2);
-    // color attribute
-    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, VERTS_STRIDE * sizeof(GLfloat), (GLvoid*)(5 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(3);
-    // is pixel art attribute
-    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, VERTS_STRIDE * sizeof(GLfloat), (GLvoid*)(9 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(4);
+    if (spriteMode == SkaRendererSpriteMode_VERTICES) {
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SkaSpriteVertex), (GLvoid*)offsetof(SkaSpriteVertex, position));
+        sprite_renderer_set_sprite_attributes(sizeof(SkaSpriteVertex), offsetof(SkaSpriteVertex, instance));
+    }
+    for (GLuint i = 0; i <= 5; i++) {
+        glEnableVertexAttribArray(i);
+        if (spriteMode == SkaRendererSpriteMode_INSTANCED && i > 0) {
+            glVertexAttribDivisor(i, 1);
+        }
+    }
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
@@ -350,7 +570,13 @@ void sprite_renderer_initialize() {
     ska_renderer_set_sprite_shader_default_params(spriteShader);
 }
 
-void sprite_renderer_finalize() {}
+void sprite_renderer_finalize() {
+    renderer_stream_buffer_finalize(&spriteStream);
+    if (spriteMode == SkaRendererSpriteMode_INSTANCED) {
+        glDeleteBuffers(1, &spriteQuadVBO);
+    }
+    glDeleteVertexArrays(1, &spriteQuadVAO);
+}
 
 void ska_renderer_set_sprite_shader_default_params(SkaShader* shader) {
     ska_shader_use(shader);
@@ -363,97 +589,133 @@ void sprite_renderer_update_resolution() {
     glm_ortho(0.0f, resolutionWidth, resolutionHeight, 0.0f, -1.0f, 1.0f, spriteProjection);
 }
 
-void renderer_batching_draw_sprites(SpriteBatchItem items[], usize spriteCount) {
-#define MAX_SPRITE_COUNT 2000
-#define NUMBER_OF_VERTICES 6
-#define VERTEX_BUFFER_SIZE (VERTS_STRIDE * NUMBER_OF_VERTICES * MAX_SPRITE_COUNT)
+// Writes the stream data of a sprite (vertices or an instance depending on the sprite mode), returns the bytes written
+static inline usize renderer_batching_write_sprite(const SpriteBatchItem* item, void* data) {
+    if (spriteMode == SkaRendererSpriteMode_INSTANCED) {
+        ska_sprite_batch_write_sprite_instance2((SkaSpriteInstance*)data, item->texture, &item->sourceRect, item->destSize, &item->color, item->flipH, item->flipV, &item->model);
+        return sizeof(SkaSpriteInstance);
+    }
+    ska_sprite_batch_write_sprite_vertices2((SkaSpriteVertex*)data, item->texture, &item->sourceRect, item->destSize, &item->color, item->flipH, item->flipV, &item->model);
+    return SKA_SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SkaSpriteVertex);
+}
+
+// Uploads the queued sprites in sorted order with a single mapping, so each batch is a contiguous range of the stream.
+// Returns false if the sprites couldn't be uploaded and shouldn't be drawn this frame.
+bool sprite_renderer_stream_batch_sprites() {
+    if (rendererStats.drawnSprites == 0) {
+        return true;
+    }
 
+    glBindBuffer(GL_ARRAY_BUFFER, spriteStream.vbo);
+    GLintptr streamOffset = 0;
+    unsigned char* data = (unsigned char*)renderer_stream_buffer_map(&spriteStream, (GLsizeiptr)rendererStats.drawnSprites * sprite_renderer_get_sprite_stream_size(), &streamOffset);
+    spriteStreamFirstSprite = (GLint)(streamOffset / sprite_renderer_get_sprite_stream_size());
+    for (usize i = 0; i < renderQueue->count; i++) {
+        const uint64 key = renderQueue->keys[i];
+        if (ska_render_queue_key_get_type(key) == SkaRenderQueueItemType_SPRITE) {
+            data += renderer_batching_write_sprite(&spriteBatchItems[ska_render_queue_key_get_index(key)], data);
+        }
+    }
+    const bool isUnmapped = renderer_stream_buffer_unmap(&spriteStream);
+    if (!isUnmapped) {
+        // Contents were lost (e.g. display mode change), skip the frame's sprites
+        ska_logger_error("Sprite stream buffer contents lost while mapped!");
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return isUnmapped;
+}
+
+// 'firstSprite' is relative to the frame's first sprite in the stream buffer
+void renderer_batching_draw_sprites(const SpriteBatchItem* firstItem, usize spriteCount, GLint firstSprite) {
     if (spriteCount <= 0) {
         return;
     }
 
-    SKA_ASSERT(spriteCount <= MAX_SPRITE_COUNT);
-
     glDepthMask(false);
 
     glBindVertexArray(spriteQuadVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, spriteQuadVBO);
 
-    SkaTexture* texture = items[0].texture;
-
-    GLfloat verts[VERTEX_BUFFER_SIZE];
-    for (usize i = 0; i < spriteCount; i++) {
-        if (items[i].shaderInstance != NULL) {
-            ska_shader_use(items[i].shaderInstance->shader);
-            renderer_set_shader_instance_params(items[i].shaderInstance);
-        } else {
-            ska_shader_use(spriteShader);
-        }
-
-        glm_scale(items[i].transform2D.model, (vec3) {
-            items[i].destSize.w, items[i].destSize.h, 1.0f
-        });
-        const f32 spriteId = (f32) i;
-        const f32 determinate = glm_mat4_det(items[i].transform2D.model);
-        const SkaTextureCoordinates textureCoords = renderer_get_texture_coordinates(texture, &items[i].sourceRect, items[i].flipH, items[i].flipV);
-        // concat CRE_MODELS[] string for uniform param
-        char modelsBuffer[24];
-        sprintf(modelsBuffer, "CRE_MODELS[%zu]", i);
-        ska_shader_set_mat4_float(spriteShader, modelsBuffer, &items[i].transform2D.model);
-
-        // Loop over vertices
-        for (int32 j = 0; j < NUMBER_OF_VERTICES; j++) {
-            bool isSMin;
-            bool isTMin;
-            if (determinate >= 0.0f) {
-                isSMin = j == 0 || j == 2 || j == 3;
-                isTMin = j == 1 || j == 2 || j == 5;
-            } else {
-                isSMin = j == 1 || j == 2 || j == 5;
-                isTMin = j == 0 || j == 2 || j == 3;
-            }
-            const int32 row = (j * VERTS_STRIDE) + ((int32) i * (VERTS_STRIDE * NUMBER_OF_VERTICES));
-            verts[row + 0] = spriteId;
-            verts[row + 1] = isSMin ? 0.0f : 1.0f;
-            verts[row + 2] = isTMin ? 0.0f : 1.0f;
-            verts[row + 3] = isSMin ? textureCoords.sMin : textureCoords.sMax;
-            verts[row + 4] = isTMin ? textureCoords.tMin : textureCoords.tMax;
-            verts[row + 5] = items[i].color.r;
-            verts[row + 6] = items[i].color.g;
-            verts[row + 7] = items[i].color.b;
-            verts[row + 8] = items[i].color.a;
-            verts[row + 9] = (f32)texture->applyNearestNeighbor;
-        }
+    // Sprites of a batch share texture and shader instance, transforms are part of the stream data
+    firstSprite += spriteStreamFirstSprite;
+    SkaTexture* texture = firstItem->texture;
+    if (firstItem->shaderInstance != NULL) {
+        ska_shader_use(firstItem->shaderInstance->shader);
+        renderer_set_shader_instance_params(firstItem->shaderInstance);
+    } else {
+        ska_shader_use(spriteShader);
     }
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, texture->id);
 
-    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) sizeof(verts), verts, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, (GLsizei) (spriteCount * NUMBER_OF_VERTICES));
+    if (spriteMode == SkaRendererSpriteMode_INSTANCED) {
+        // No base instance in gl 3.3, so instance attributes are pointed at the batch instead
+        glBindBuffer(GL_ARRAY_BUFFER, spriteStream.vbo);
+        sprite_renderer_set_sprite_attributes(sizeof(SkaSpriteInstance), (GLintptr)firstSprite * (GLintptr)sizeof(SkaSpriteInstance));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, SKA_SPRITE_BATCH_VERTICES_PER_SPRITE, (GLsizei)spriteCount);
+    } else {
+        glDrawArrays(GL_TRIANGLES, firstSprite * SKA_SPRITE_BATCH_VERTICES_PER_SPRITE, (GLsizei) (spriteCount * SKA_SPRITE_BATCH_VERTICES_PER_SPRITE));
+    }
+    rendererStats.drawCalls++;
 
     renderer_print_opengl_errors();
 
     glBindVertexArray(0);
     glDepthMask(true);
-
-#undef MAX_SPRITE_COUNT
-#undef NUMBER_OF_VERTICES
-#undef VERTEX_BUFFER_SIZE
 }
-#undef VERTS_STRIDE
+#undef SPRITE_STREAM_BUFFER_INITIAL_SIZE
 
 // --- Font Renderer --- //
+// Initial size of the font stream buffer, grows when a frame's glyphs don't fit
+#define FONT_STREAM_BUFFER_INITIAL_SIZE (256 * 1024)
+
+// Glyph quads of all queued text are written once per frame into a streaming buffer as one instance per glyph, in sorted
+// order so text sharing a font and z index is drawn with a single call.
+
+// Points the glyph quad attributes at quads starting at 'offset' in the bound array buffer
+static void font_renderer_set_glyph_quad_attributes(GLintptr offset) {
+    // rect attribute
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(SkaFontGlyphQuad), (GLvoid*)(offset + offsetof(SkaFontGlyphQuad, rect)));
+    // texture rect attribute
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(SkaFontGlyphQuad), (GLvoid*)(offset + offsetof(SkaFontGlyphQuad, uvRect)));
+    // color attribute
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SkaFontGlyphQuad), (GLvoid*)(offset + offsetof(SkaFontGlyphQuad, color)));
+}
+
 void font_renderer_initialize() {
     if (FT_Init_FreeType(&ska_render_context_get()->freeTypeLibrary)) {
         ska_logger_error("Unable to initialize FreeType library!");
     }
+    glGenVertexArrays(1, &fontVAO);
+    glBindVertexArray(fontVAO);
+    // Same unit quad as instanced sprites
+    glGenBuffers(1, &fontQuadVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, fontQuadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(SKA_SPRITE_BATCH_QUAD_CORNERS), SKA_SPRITE_BATCH_QUAD_CORNERS, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)NULL);
+    renderer_stream_buffer_initialize(&fontStream, FONT_STREAM_BUFFER_INITIAL_SIZE);
+    font_renderer_set_glyph_quad_attributes(0);
+    for (GLuint i = 0; i <= 3; i++) {
+        glEnableVertexAttribArray(i);
+        if (i > 0) {
+            glVertexAttribDivisor(i, 1);
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
     fontShader = ska_shader_compile_new_shader(SKA_OPENGL_SHADER_SOURCE_VERTEX_FONT,
                                                SKA_OPENGL_SHADER_SOURCE_FRAGMENT_FONT);
+    fontSdfShader = ska_shader_compile_new_shader(SKA_OPENGL_SHADER_SOURCE_VERTEX_FONT,
+                                                  SKA_OPENGL_SHADER_SOURCE_FRAGMENT_FONT_SDF);
     font_renderer_update_resolution();
 }
 
 void font_renderer_finalize() {
+    renderer_stream_buffer_finalize(&fontStream);
+    glDeleteBuffers(1, &fontQuadVBO);
+    glDeleteVertexArrays(1, &fontVAO);
     FT_Done_FreeType(ska_render_context_get()->freeTypeLibrary);
 }
 
@@ -467,81 +729,104 @@ void font_renderer_update_resolution() {
     glm_ortho(0.0f, resolutionWidth, -resolutionHeight, 0.0f, -1.0f, 1.0f, proj);
     ska_shader_use(fontShader);
     ska_shader_set_mat4_float(fontShader, "projection", &proj);
+    ska_shader_use(fontSdfShader);
+    ska_shader_set_mat4_float(fontSdfShader, "projection", &proj);
 }
 
-void font_renderer_draw_text(const SkaFont* font, const char* text, f32 x, f32 y, f32 scale, const SkaColor* color) {
-    SkaVector2 currentScale = {scale, scale };
-    ska_shader_use(fontShader);
-    ska_shader_set_vec4_float(fontShader, "textColor", color->r, color->g, color->b, color->a);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(font->VAO);
-
-    // Iterate through all characters
-    char* c = (char*) &text[0];
-    const usize textLength = strlen(text);
-    for (usize i = 0; i < textLength; i++) {
-        SkaFontCharacter ch = font->characters[(int32) *c];
-        const f32 xPos = x + (ch.bearing.x * currentScale.x);
-        const f32 yPos = -y - (ch.size.y - ch.bearing.y) * currentScale.x; // Invert Y because orthographic projection is flipped
-        const f32 w = ch.size.x * currentScale.x;
-        const f32 h = ch.size.y * currentScale.y;
-        // Update VBO for each characters
-        GLfloat verts[6][4] = {
-            {xPos,     yPos + h, 0.0f, 0.0f},
-            {xPos,     yPos,     0.0f, 1.0f},
-            {xPos + w, yPos,     1.0f, 1.0f},
-
-            {xPos,     yPos + h, 0.0f, 0.0f},
-            {xPos + w, yPos,     1.0f, 1.0f},
-            {xPos + w, yPos + h, 1.0f, 0.0f}
-        };
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.textureId);
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, font->VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
-        // Render
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        x += (f32) (ch.advance >> 6) * currentScale.x; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
-        ++c;
+// Uploads the glyphs of the queued text in sorted order with a single mapping and sets each item's glyph range.
+// Returns false if the text couldn't be uploaded and shouldn't be drawn this frame.
+bool font_renderer_stream_text() {
+    if (fontBatchItemCount == 0) {
+        return true;
+    }
+
+    // Glyphs are rasterized on first use, so none of the frame's glyphs can be evicted once their quads are written
+    for (usize i = 0; i < fontBatchItemCount; i++) {
+        ska_font_begin_frame(fontBatchItems[i].font);
+    }
+    // Layouts are brought up to date before any other text can evict their glyphs
+    usize maxGlyphCount = fontBatchTextLength;
+    for (usize i = 0; i < fontBatchItemCount; i++) {
+        SkaTextLayout* layout = fontBatchItems[i].layout;
+        if (layout != NULL) {
+            if (ska_text_layout_needs_update(layout)) {
+                ska_text_layout_update(layout);
+            } else {
+                ska_glyph_cache_mark_used(layout->font->glyphCache, layout->glyphIndices, layout->glyphCount);
+            }
+            maxGlyphCount += layout->glyphCount;
+        }
+    }
+    if (maxGlyphCount == 0) {
+        return true;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, fontStream.vbo);
+    GLintptr streamOffset = 0;
+    SkaFontGlyphQuad* quads = (SkaFontGlyphQuad*)renderer_stream_buffer_map(&fontStream, (GLsizeiptr)(maxGlyphCount * sizeof(SkaFontGlyphQuad)), &streamOffset);
+    GLint glyphIndex = (GLint)(streamOffset / (GLintptr)sizeof(SkaFontGlyphQuad));
+    for (usize i = 0; i < renderQueue->count; i++) {
+        const uint64 key = renderQueue->keys[i];
+        if (ska_render_queue_key_get_type(key) == SkaRenderQueueItemType_FONT) {
+            FontBatchItem* item = &fontBatchItems[ska_render_queue_key_get_index(key)];
+            usize glyphCount;
+            if (item->layout != NULL) {
+                glyphCount = item->layout->glyphCount;
+                // Quads are NULL until a layout with glyphs was built
+                if (glyphCount > 0) {
+                    memcpy(quads, item->layout->quads, glyphCount * sizeof(SkaFontGlyphQuad));
+                }
+            } else {
+                glyphCount = ska_font_write_text_quads(item->font, item->text, item->x, item->y, item->scale, &item->color, quads);
+            }
+            item->firstGlyph = glyphIndex;
+            item->glyphCount = (GLsizei)glyphCount;
+            quads += glyphCount;
+            glyphIndex += item->glyphCount;
+        }
+    }
+    // Glyphs of the layouts were in use all frame, so evictions by other text didn't touch them
+    for (usize i = 0; i < fontBatchItemCount; i++) {
+        SkaTextLayout* layout = fontBatchItems[i].layout;
+        if (layout != NULL) {
+            layout->glyphCacheEvictionCount = layout->font->glyphCache->evictionCount;
+        }
+    }
+    const bool isUnmapped = renderer_stream_buffer_unmap(&fontStream);
+    if (!isUnmapped) {
+        ska_logger_error("Font stream buffer contents lost while mapped!");
     }
-    // Unbind
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return isUnmapped;
+}
+
+// Draws a range of the font stream buffer, 'firstGlyph' is the stream index of the range's first glyph quad
+void font_renderer_draw_text(const SkaFont* font, GLint firstGlyph, GLsizei glyphCount) {
+    if (glyphCount <= 0) {
+        return;
+    }
+    // Batches are split by atlas texture, so all text of a batch uses the same font
+    ska_shader_use(font->renderMode == SkaFontRenderMode_SDF ? fontSdfShader : fontShader);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, font->atlasTextureId);
+    glBindVertexArray(fontVAO);
+    // No base instance in gl 3.3, so instance attributes are pointed at the range instead
+    glBindBuffer(GL_ARRAY_BUFFER, fontStream.vbo);
+    font_renderer_set_glyph_quad_attributes((GLintptr)firstGlyph * (GLintptr)sizeof(SkaFontGlyphQuad));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, SKA_SPRITE_BATCH_VERTICES_PER_SPRITE, glyphCount);
+    rendererStats.drawCalls++;
+    renderer_print_opengl_errors();
+    // Unbind
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
+#undef FONT_STREAM_BUFFER_INITIAL_SIZE
 
 // --- Misc --- //
-SkaTextureCoordinates renderer_get_texture_coordinates(const SkaTexture* texture, const SkaRect2* drawSource, bool flipH, bool flipV) {
-    GLfloat sMin = 0.0f;
-    GLfloat sMax = 1.0f;
-    GLfloat tMin = 0.0f;
-    GLfloat tMax = 1.0f;
-    // S
-    if (texture->width != (GLsizei)drawSource->w || texture->height != (GLsizei)drawSource->h) {
-        sMin = (drawSource->x + 0.5f) / (f32) texture->width;
-        sMax = (drawSource->x + drawSource->w - 0.5f) / (f32) texture->width;
-        tMin = (drawSource->y + 0.5f) / (f32) texture->height;
-        tMax = (drawSource->y + drawSource->h - 0.5f) / (f32) texture->height;
-    }
-    if (flipH) {
-        const GLfloat tempSMin = sMin;
-        sMin = sMax;
-        sMax = tempSMin;
-    }
-    if (flipV) {
-        const GLfloat tempTMin = tMin;
-        tMin = tMax;
-        tMax = tempTMin;
-    }
-    return (SkaTextureCoordinates) {
-        sMin, sMax, tMin, tMax
-    };
-}
-
 void renderer_set_shader_instance_params(SkaShaderInstance* shaderInstance) {
     // Set global shader params first
-    ska_shader_set_float(shaderInstance->shader, "TIME", globalShaderParamTime);
+    glUniform1f(shaderInstance->shader->timeLocation, globalShaderParamTime);
 
     // Now set shader params specific to the shader instance
     if (shaderInstance->paramsDirty && shaderInstance->paramMap->size > 0) {
@@ -10,25 +10,51 @@ extern "C" {
 
 #include "texture.h"
 #include "font.h"
+#include "text_layout.h"
 #include "shader/shader_instance.h"
+#include "sprite_draw_buffer.h"
 #include "seika/math/math.h"
 
 #define SKA_RENDERER_MAX_Z_INDEX 200
 
+// How sprite batches are sent to the gpu
+typedef enum SkaRendererSpriteMode {
+    SkaRendererSpriteMode_VERTICES, // 6 vertices per sprite
+    SkaRendererSpriteMode_INSTANCED, // A shared quad drawn once per sprite instance, less cpu work and bandwidth
+} SkaRendererSpriteMode;
+
+// Sprite and draw call counts of the last flushed frame
+typedef struct SkaRendererStats {
+    usize submittedSprites;
+    usize drawnSprites; // Submitted sprites left after culling
+    usize drawCalls; // Sprite batches and text batches drawn
+} SkaRendererStats;
+
 typedef struct SkaRendererTransform2D {
     mat4 model;
 } SkaRendererTransform2D;
 
 void ska_renderer_initialize(int32 inWindowWidth, int32 inWindowHeight, int32 inResolutionWidth, int32 inResolutionHeight, bool maintainAspectRatio);
+void ska_renderer_initialize2(int32 inWindowWidth, int32 inWindowHeight, int32 inResolutionWidth, int32 inResolutionHeight, bool maintainAspectRatio, SkaRendererSpriteMode inSpriteMode);
 void ska_renderer_finalize();
 void ska_renderer_update_window_size(int32 windowWidth, int32 windowHeight);
 void ska_renderer_set_sprite_shader_default_params(SkaShader* shader);
 void ska_renderer_queue_sprite_draw(SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, const SkaTransform2D* transform2D, int32 zIndex, SkaShaderInstance* shaderInstance);
 void ska_renderer_queue_sprite_draw2(SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, mat4 trsMatrix, int32 zIndex, SkaShaderInstance* shaderInstance);
+// Queues the sprites of draw buffers filled by other threads in buffer order, buffers are cleared afterwards.  Main thread only,
+// should be called once per frame after the threads writing to the buffers are done and before the batches are flushed.
+void ska_renderer_queue_sprite_draw_buffers(SkaSpriteDrawBuffer* const* drawBuffers, usize drawBufferCount);
 void ska_renderer_queue_font_draw_call(SkaFont* font, const char* text, f32 x, f32 y, f32 scale, SkaColor color, int32 zIndex);
+// Draws the layout's cached vertices, the layout is updated first if it changed.  It has to stay alive until the frame is flushed.
+void ska_renderer_queue_text_layout_draw_call(SkaTextLayout* layout, int32 zIndex);
 void ska_renderer_process_and_flush_batches(const SkaColor *backgroundColor);
 void ska_renderer_process_and_flush_batches_just_framebuffer(const SkaColor *backgroundColor);
 
+// Off by default.  When enabled, sprites with a quad outside of the resolution's rect are skipped before being uploaded.
+// Sprite shaders that move vertices outside of the quad in 'vertex()' shouldn't be used with culling.
+void ska_renderer_set_sprite_culling_enabled(bool enabled);
+SkaRendererStats ska_renderer_get_stats();
+
 // Shader params
 void ska_renderer_set_global_shader_param_time(f32 timeValue);
 
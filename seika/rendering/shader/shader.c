@@ -32,6 +32,7 @@ SkaShader* ska_shader_compile_new_shader(const char* vertexSource, const char* f
     }
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    shader->timeLocation = glGetUniformLocation(shader->id, "TIME");
     return shader;
 }
 
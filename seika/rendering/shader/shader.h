@@ -14,6 +14,8 @@ static const char* SKA_SHADER_PROGRAM_TYPE = "PROGRAM";
 
 typedef struct SkaShader {
     GLuint id;
+    // Built-in uniform locations, cached once the shader is linked (-1 if the shader doesn't use them)
+    GLint timeLocation;
 } SkaShader;
 
 SkaShader* ska_shader_compile_new_shader(const char* vertexSource, const char* fragmentSource);
@@ -5,11 +5,12 @@
 static const char* SKA_OPENGL_SHADER_SOURCE_VERTEX_SPRITE =
     "#version 330 core\n"
     "\n"
-    "layout (location = 0) in float ID;\n"
-    "layout (location = 1) in vec2 CRE_VERTEX;\n"
-    "layout (location = 2) in vec2 CRE_TEXTURE_COORDS;\n"
-    "layout (location = 3) in vec4 CRE_TEXTURE_MODULATE;\n"
-    "layout (location = 4) in float CRE_APPLY_NEAREST_NEIGHBOR;\n"
+    "layout (location = 0) in vec2 CRE_VERTEX;\n"
+    "layout (location = 1) in vec4 CRE_TEXTURE_RECT;\n"
+    "layout (location = 2) in vec4 CRE_TEXTURE_MODULATE;\n"
+    "layout (location = 3) in float CRE_APPLY_NEAREST_NEIGHBOR;\n"
+    "layout (location = 4) in vec4 CRE_MODEL_BASIS;\n"
+    "layout (location = 5) in vec2 CRE_MODEL_ORIGIN;\n"
     "\n"
     "out vec2 UV;\n"
     "out vec4 TEXTURE_MODULATE;\n"
@@ -17,7 +18,6 @@ static const char* SKA_OPENGL_SHADER_SOURCE_VERTEX_SPRITE =
     "\n"
     "uniform float TIME;\n"
     "uniform sampler2D TEXTURE;\n"
-    "uniform mat4 CRE_MODELS[100];\n"
     "uniform mat4 CRE_PROJECTION;\n"
     "\n"
     "//@@UNIFORMS\n"
@@ -25,13 +25,16 @@ static const char* SKA_OPENGL_SHADER_SOURCE_VERTEX_SPRITE =
     "//@@FUNCTIONS\n"
     "\n"
     "void main() {\n"
-    "    int CRE_SPRITE_INT_ID = int(ID);\n"
-    "    UV = CRE_TEXTURE_COORDS;\n"
+    "    // Mirrored transforms use the quad corners in reverse winding so they aren't culled\n"
+    "    bool CRE_IS_MIRRORED = CRE_MODEL_BASIS.x * CRE_MODEL_BASIS.w - CRE_MODEL_BASIS.y * CRE_MODEL_BASIS.z < 0.0f;\n"
+    "    vec2 CRE_CORNER = CRE_IS_MIRRORED ? CRE_VERTEX.yx : CRE_VERTEX;\n"
+    "    UV = mix(CRE_TEXTURE_RECT.xy, CRE_TEXTURE_RECT.zw, CRE_CORNER);\n"
     "    TEXTURE_MODULATE = CRE_TEXTURE_MODULATE;\n"
     "    USING_NEAREST_NEIGHBOR = CRE_APPLY_NEAREST_NEIGHBOR;\n"
-    "    vec2 VERTEX = CRE_VERTEX;\n"
+    "    vec2 VERTEX = CRE_CORNER;\n"
     "    //@@vertex()\n"
-    "    gl_Position = CRE_PROJECTION * CRE_MODELS[CRE_SPRITE_INT_ID] * vec4(VERTEX, 0.0f, 1.0f);\n"
+    "    vec2 CRE_WORLD_VERTEX = CRE_MODEL_BASIS.xy * VERTEX.x + CRE_MODEL_BASIS.zw * VERTEX.y + CRE_MODEL_ORIGIN;\n"
+    "    gl_Position = CRE_PROJECTION * vec4(CRE_WORLD_VERTEX, 0.0f, 1.0f);\n"
     "}\n";
 
 static const char* SKA_OPENGL_SHADER_SOURCE_FRAGMENT_SPRITE =
@@ -67,28 +70,52 @@ static const char* SKA_OPENGL_SHADER_SOURCE_FRAGMENT_SPRITE =
 
 static const char* SKA_OPENGL_SHADER_SOURCE_VERTEX_FONT =
     "#version 330 core\n"
-    "layout (location = 0) in vec4 vertex; // (pos, tex)\n"
+    "layout (location = 0) in vec2 corner; // unit quad, y pointing down\n"
+    "layout (location = 1) in vec4 glyphRect; // bottom left corner and size\n"
+    "layout (location = 2) in vec4 glyphTextureRect; // in atlas pixels\n"
+    "layout (location = 3) in vec4 textColor;\n"
     "\n"
     "out vec2 texCoords;\n"
+    "out vec4 color;\n"
     "\n"
     "uniform mat4 projection;\n"
+    "uniform sampler2D textValue;\n"
     "\n"
     "void main() {\n"
-    "    gl_Position = projection * vec4(vertex.xy, 0.0f, 1.0f);\n"
-    "    texCoords = vertex.zw;\n"
+    "    gl_Position = projection * vec4(glyphRect.xy + vec2(corner.x, 1.0f - corner.y) * glyphRect.zw, 0.0f, 1.0f);\n"
+    "    // Glyph rects are in atlas pixels, the atlas grows as glyphs are added\n"
+    "    texCoords = mix(glyphTextureRect.xy, glyphTextureRect.zw, corner) / vec2(textureSize(textValue, 0));\n"
+    "    color = textColor;\n"
     "}\n";
 
 static const char* SKA_OPENGL_SHADER_SOURCE_FRAGMENT_FONT =
     "#version 330 core\n"
     "in vec2 texCoords;\n"
-    "out vec4 color;\n"
+    "in vec4 color;\n"
+    "out vec4 fragColor;\n"
     "\n"
     "uniform sampler2D textValue;\n"
-    "uniform vec4 textColor;\n"
     "\n"
     "void main() {\n"
     "    vec4 sampled = vec4(1.0f, 1.0f, 1.0f, texture(textValue, texCoords).r);\n"
-    "    color = textColor * sampled;\n"
+    "    fragColor = color * sampled;\n"
+    "}\n";
+
+// Used with the font vertex shader for 'SkaFontRenderMode_SDF' fonts
+static const char* SKA_OPENGL_SHADER_SOURCE_FRAGMENT_FONT_SDF =
+    "#version 330 core\n"
+    "in vec2 texCoords;\n"
+    "in vec4 color;\n"
+    "out vec4 fragColor;\n"
+    "\n"
+    "uniform sampler2D textValue;\n"
+    "\n"
+    "void main() {\n"
+    "    // 0.5 is the outline, the edge is smoothed over about a screen pixel whatever the scale\n"
+    "    float distance = texture(textValue, texCoords).r;\n"
+    "    float edgeWidth = max(fwidth(distance), 0.0001f);\n"
+    "    float alpha = clamp((distance - 0.5f) / edgeWidth + 0.5f, 0.0f, 1.0f);\n"
+    "    fragColor = vec4(color.rgb, color.a * alpha);\n"
     "}\n";
 
 static const char* SKA_OPENGL_SHADER_SOURCE_VERTEX_SCREEN =
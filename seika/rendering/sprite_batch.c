@@ -0,0 +1,99 @@
+#if SKA_RENDERING
+
+#include "sprite_batch.h"
+
+typedef struct SkaTextureCoordinates {
+    f32 sMin;
+    f32 sMax;
+    f32 tMin;
+    f32 tMax;
+} SkaTextureCoordinates;
+
+const f32 SKA_SPRITE_BATCH_QUAD_CORNERS[SKA_SPRITE_BATCH_VERTICES_PER_SPRITE][2] = {
+    { 0.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f },
+    { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }
+};
+
+static inline SkaTextureCoordinates sprite_batch_get_texture_coordinates(const SkaTexture* texture, const SkaRect2* drawSource, bool flipH, bool flipV) {
+    f32 sMin = 0.0f;
+    f32 sMax = 1.0f;
+    f32 tMin = 0.0f;
+    f32 tMax = 1.0f;
+    // Atlased textures are remapped into their page, the page has transparent padding so full texture coordinates don't bleed
+    f32 offsetX = 0.0f;
+    f32 offsetY = 0.0f;
+    f32 pageWidth = (f32)texture->width;
+    f32 pageHeight = (f32)texture->height;
+    if (texture->isAtlased) {
+        offsetX = (f32)texture->atlasOffsetX;
+        offsetY = (f32)texture->atlasOffsetY;
+        pageWidth = (f32)texture->atlasPageWidth;
+        pageHeight = (f32)texture->atlasPageHeight;
+        sMin = offsetX / pageWidth;
+        sMax = (offsetX + (f32)texture->width) / pageWidth;
+        tMin = offsetY / pageHeight;
+        tMax = (offsetY + (f32)texture->height) / pageHeight;
+    }
+    // S
+    if (texture->width != (GLsizei)drawSource->w || texture->height != (GLsizei)drawSource->h) {
+        sMin = (offsetX + drawSource->x + 0.5f) / pageWidth;
+        sMax = (offsetX + drawSource->x + drawSource->w - 0.5f) / pageWidth;
+        tMin = (offsetY + drawSource->y + 0.5f) / pageHeight;
+        tMax = (offsetY + drawSource->y + drawSource->h - 0.5f) / pageHeight;
+    }
+    if (flipH) {
+        const f32 tempSMin = sMin;
+        sMin = sMax;
+        sMax = tempSMin;
+    }
+    if (flipV) {
+        const f32 tempTMin = tMin;
+        tMin = tMax;
+        tMax = tempTMin;
+    }
+    return (SkaTextureCoordinates) {
+        sMin, sMax, tMin, tMax
+    };
+}
+
+void ska_sprite_batch_write_sprite_instance(SkaSpriteInstance* outInstance, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, mat4 model) {
+    SkaAffine2D affine;
+    ska_affine2d_from_mat4(model, &affine);
+    ska_sprite_batch_write_sprite_instance2(outInstance, texture, sourceRect, destSize, color, flipH, flipV, &affine);
+}
+
+void ska_sprite_batch_write_sprite_instance2(SkaSpriteInstance* outInstance, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, const SkaAffine2D* model) {
+    const SkaTextureCoordinates textureCoords = sprite_batch_get_texture_coordinates(texture, sourceRect, flipH, flipV);
+    outInstance->uvRect[0] = textureCoords.sMin;
+    outInstance->uvRect[1] = textureCoords.tMin;
+    outInstance->uvRect[2] = textureCoords.sMax;
+    outInstance->uvRect[3] = textureCoords.tMax;
+    outInstance->color = *color;
+    outInstance->applyNearestNeighbor = (f32)texture->applyNearestNeighbor;
+    // Model axes scaled by the destination size
+    outInstance->modelBasis[0] = model->xAxis[0] * destSize.w;
+    outInstance->modelBasis[1] = model->xAxis[1] * destSize.w;
+    outInstance->modelBasis[2] = model->yAxis[0] * destSize.h;
+    outInstance->modelBasis[3] = model->yAxis[1] * destSize.h;
+    outInstance->modelOrigin[0] = model->origin[0];
+    outInstance->modelOrigin[1] = model->origin[1];
+}
+
+void ska_sprite_batch_write_sprite_vertices(SkaSpriteVertex* outVertices, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, mat4 model) {
+    SkaAffine2D affine;
+    ska_affine2d_from_mat4(model, &affine);
+    ska_sprite_batch_write_sprite_vertices2(outVertices, texture, sourceRect, destSize, color, flipH, flipV, &affine);
+}
+
+void ska_sprite_batch_write_sprite_vertices2(SkaSpriteVertex* outVertices, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, const SkaAffine2D* model) {
+    ska_sprite_batch_write_sprite_instance2(&outVertices[0].instance, texture, sourceRect, destSize, color, flipH, flipV, model);
+    for (int32 j = 0; j < SKA_SPRITE_BATCH_VERTICES_PER_SPRITE; j++) {
+        outVertices[j].position[0] = SKA_SPRITE_BATCH_QUAD_CORNERS[j][0];
+        outVertices[j].position[1] = SKA_SPRITE_BATCH_QUAD_CORNERS[j][1];
+        if (j > 0) {
+            outVertices[j].instance = outVertices[0].instance;
+        }
+    }
+}
+
+#endif // #if SKA_RENDERING
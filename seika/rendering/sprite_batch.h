@@ -0,0 +1,44 @@
+#pragma once
+
+#if SKA_RENDERING
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "texture.h"
+#include "seika/math/math.h"
+
+#define SKA_SPRITE_BATCH_VERTICES_PER_SPRITE 6
+
+// Per sprite data with the sprite's model transform baked in, so batches need no per sprite uniforms.  Used as instance
+// data by the instanced path and repeated for each vertex otherwise.
+typedef struct SkaSpriteInstance {
+    f32 uvRect[4]; // Texture coordinates of the quad's (0, 0) and (1, 1) corners, flips already applied
+    SkaColor color;
+    f32 applyNearestNeighbor;
+    f32 modelBasis[4]; // 2D affine columns (x axis, y axis), scaled by the sprite's destination size
+    f32 modelOrigin[2];
+} SkaSpriteInstance;
+
+// The quad corner stays in local space (0 - 1) for the 'vertex()' function of sprite shaders and is transformed in the shader
+typedef struct SkaSpriteVertex {
+    f32 position[2];
+    SkaSpriteInstance instance;
+} SkaSpriteVertex;
+
+// Quad corners in draw order, the sprite shader swaps x and y for mirrored transforms to keep the winding front facing
+extern const f32 SKA_SPRITE_BATCH_QUAD_CORNERS[SKA_SPRITE_BATCH_VERTICES_PER_SPRITE][2];
+
+// 'model' is the sprite's transform without the destination size applied
+void ska_sprite_batch_write_sprite_instance(SkaSpriteInstance* outInstance, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, mat4 model);
+void ska_sprite_batch_write_sprite_instance2(SkaSpriteInstance* outInstance, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, const SkaAffine2D* model);
+// Writes 'SKA_SPRITE_BATCH_VERTICES_PER_SPRITE' vertices of a sprite
+void ska_sprite_batch_write_sprite_vertices(SkaSpriteVertex* outVertices, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, mat4 model);
+void ska_sprite_batch_write_sprite_vertices2(SkaSpriteVertex* outVertices, const SkaTexture* texture, const SkaRect2* sourceRect, SkaSize2D destSize, const SkaColor* color, bool flipH, bool flipV, const SkaAffine2D* model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #if SKA_RENDERING
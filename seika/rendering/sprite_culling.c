@@ -0,0 +1,100 @@
+#include "sprite_culling.h"
+
+#include "seika/memory.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SKA_SPRITE_CULLING_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SKA_SPRITE_CULLING_SSE2
+#endif
+
+SkaSpriteCullingBounds* ska_sprite_culling_bounds_create(usize initialCapacity) {
+    SkaSpriteCullingBounds* bounds = SKA_ALLOC_ZEROED(SkaSpriteCullingBounds);
+    bounds->capacity = initialCapacity > 0 ? initialCapacity : 1;
+    bounds->minX = (f32*)SKA_ALLOC_BYTES(bounds->capacity * sizeof(f32));
+    bounds->minY = (f32*)SKA_ALLOC_BYTES(bounds->capacity * sizeof(f32));
+    bounds->maxX = (f32*)SKA_ALLOC_BYTES(bounds->capacity * sizeof(f32));
+    bounds->maxY = (f32*)SKA_ALLOC_BYTES(bounds->capacity * sizeof(f32));
+    return bounds;
+}
+
+void ska_sprite_culling_bounds_destroy(SkaSpriteCullingBounds* bounds) {
+    SKA_FREE(bounds->minX);
+    SKA_FREE(bounds->minY);
+    SKA_FREE(bounds->maxX);
+    SKA_FREE(bounds->maxY);
+    SKA_FREE(bounds);
+}
+
+void ska_sprite_culling_bounds_clear(SkaSpriteCullingBounds* bounds) {
+    bounds->count = 0;
+}
+
+void ska_sprite_culling_bounds_add(SkaSpriteCullingBounds* bounds, const SkaAffine2D* model, SkaSize2D destSize) {
+    if (bounds->count >= bounds->capacity) {
+        bounds->capacity *= 2;
+        bounds->minX = (f32*)ska_mem_reallocate(bounds->minX, bounds->capacity * sizeof(f32));
+        bounds->minY = (f32*)ska_mem_reallocate(bounds->minY, bounds->capacity * sizeof(f32));
+        bounds->maxX = (f32*)ska_mem_reallocate(bounds->maxX, bounds->capacity * sizeof(f32));
+        bounds->maxY = (f32*)ska_mem_reallocate(bounds->maxY, bounds->capacity * sizeof(f32));
+    }
+    // Corners are origin + u * xAxis + v * yAxis for u, v in [0, 1], same as in the sprite shader
+    const f32 xAxisX = model->xAxis[0] * destSize.w;
+    const f32 xAxisY = model->xAxis[1] * destSize.w;
+    const f32 yAxisX = model->yAxis[0] * destSize.h;
+    const f32 yAxisY = model->yAxis[1] * destSize.h;
+    const usize i = bounds->count++;
+    bounds->minX[i] = model->origin[0] + SKA_MATH_MIN(xAxisX, 0.0f) + SKA_MATH_MIN(yAxisX, 0.0f);
+    bounds->maxX[i] = model->origin[0] + SKA_MATH_MAX(xAxisX, 0.0f) + SKA_MATH_MAX(yAxisX, 0.0f);
+    bounds->minY[i] = model->origin[1] + SKA_MATH_MIN(xAxisY, 0.0f) + SKA_MATH_MIN(yAxisY, 0.0f);
+    bounds->maxY[i] = model->origin[1] + SKA_MATH_MAX(xAxisY, 0.0f) + SKA_MATH_MAX(yAxisY, 0.0f);
+}
+
+usize ska_sprite_culling_test_view(const SkaSpriteCullingBounds* bounds, const SkaRect2* view, bool* outVisible) {
+    const f32 viewMinX = view->x;
+    const f32 viewMinY = view->y;
+    const f32 viewMaxX = view->x + view->w;
+    const f32 viewMaxY = view->y + view->h;
+    usize visibleCount = 0;
+    usize i = 0;
+#if defined(SKA_SPRITE_CULLING_AVX)
+    const __m256 viewMinX8 = _mm256_set1_ps(viewMinX);
+    const __m256 viewMinY8 = _mm256_set1_ps(viewMinY);
+    const __m256 viewMaxX8 = _mm256_set1_ps(viewMaxX);
+    const __m256 viewMaxY8 = _mm256_set1_ps(viewMaxY);
+    for (; i + 8 <= bounds->count; i += 8) {
+        const __m256 overlapX = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&bounds->maxX[i]), viewMinX8, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&bounds->minX[i]), viewMaxX8, _CMP_LE_OQ));
+        const __m256 overlapY = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&bounds->maxY[i]), viewMinY8, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&bounds->minY[i]), viewMaxY8, _CMP_LE_OQ));
+        const int32 mask = _mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY));
+        for (int32 lane = 0; lane < 8; lane++) {
+            outVisible[i + lane] = (mask >> lane) & 1;
+            visibleCount += outVisible[i + lane];
+        }
+    }
+#elif defined(SKA_SPRITE_CULLING_SSE2)
+    const __m128 viewMinX4 = _mm_set1_ps(viewMinX);
+    const __m128 viewMinY4 = _mm_set1_ps(viewMinY);
+    const __m128 viewMaxX4 = _mm_set1_ps(viewMaxX);
+    const __m128 viewMaxY4 = _mm_set1_ps(viewMaxY);
+    for (; i + 4 <= bounds->count; i += 4) {
+        const __m128 overlapX = _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&bounds->maxX[i]), viewMinX4), _mm_cmple_ps(_mm_loadu_ps(&bounds->minX[i]), viewMaxX4));
+        const __m128 overlapY = _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&bounds->maxY[i]), viewMinY4), _mm_cmple_ps(_mm_loadu_ps(&bounds->minY[i]), viewMaxY4));
+        const int32 mask = _mm_movemask_ps(_mm_and_ps(overlapX, overlapY));
+        for (int32 lane = 0; lane < 4; lane++) {
+            outVisible[i + lane] = (mask >> lane) & 1;
+            visibleCount += outVisible[i + lane];
+        }
+    }
+#endif
+    // Scalar fallback and remainder
+    for (; i < bounds->count; i++) {
+        outVisible[i] = bounds->maxX[i] >= viewMinX && bounds->minX[i] <= viewMaxX && bounds->maxY[i] >= viewMinY && bounds->minY[i] <= viewMaxY;
+        visibleCount += outVisible[i];
+    }
+    return visibleCount;
+}
+
+#undef SKA_SPRITE_CULLING_AVX
+#undef SKA_SPRITE_CULLING_SSE2
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/math/math.h"
+
+// Axis aligned bounds of sprite quads kept in separate arrays, so they can be tested against a view several at a time
+typedef struct SkaSpriteCullingBounds {
+    f32* minX;
+    f32* minY;
+    f32* maxX;
+    f32* maxY;
+    usize count;
+    usize capacity;
+} SkaSpriteCullingBounds;
+
+SkaSpriteCullingBounds* ska_sprite_culling_bounds_create(usize initialCapacity);
+void ska_sprite_culling_bounds_destroy(SkaSpriteCullingBounds* bounds);
+void ska_sprite_culling_bounds_clear(SkaSpriteCullingBounds* bounds);
+// Adds the bounds of a sprite's quad, 'model' is the sprite's transform without the destination size applied
+void ska_sprite_culling_bounds_add(SkaSpriteCullingBounds* bounds, const SkaAffine2D* model, SkaSize2D destSize);
+// Sets 'outVisible[i]' to true if bounds 'i' overlap 'view' (touching counts) and to false otherwise, returns the amount of
+// visible bounds.  Bounds are tested 8 (avx) or 4 (sse2) at a time when the target supports it.
+usize ska_sprite_culling_test_view(const SkaSpriteCullingBounds* bounds, const SkaRect2* view, bool* outVisible);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+#if SKA_RENDERING
+
+#include "sprite_draw_buffer.h"
+
+#include "seika/memory.h"
+
+SkaSpriteDrawBuffer* ska_sprite_draw_buffer_create(usize capacity) {
+    SkaSpriteDrawBuffer* drawBuffer = SKA_ALLOC(SkaSpriteDrawBuffer);
+    drawBuffer->commands = (SkaSpriteDrawCommand*)SKA_ALLOC_BYTES(capacity * sizeof(SkaSpriteDrawCommand));
+    drawBuffer->count = 0;
+    drawBuffer->capacity = capacity;
+    return drawBuffer;
+}
+
+void ska_sprite_draw_buffer_destroy(SkaSpriteDrawBuffer* drawBuffer) {
+    SKA_FREE(drawBuffer->commands);
+    SKA_FREE(drawBuffer);
+}
+
+static SkaSpriteDrawCommand* sprite_draw_buffer_push_command(SkaSpriteDrawBuffer* drawBuffer, SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, int32 zIndex, SkaShaderInstance* shaderInstance) {
+    if (texture == NULL || drawBuffer->count >= drawBuffer->capacity) {
+        return NULL;
+    }
+    SkaSpriteDrawCommand* command = &drawBuffer->commands[drawBuffer->count++];
+    command->texture = texture;
+    command->shaderInstance = shaderInstance;
+    command->sourceRect = sourceRect;
+    command->destSize = destSize;
+    command->color = color;
+    command->zIndex = zIndex;
+    command->flipH = flipH;
+    command->flipV = flipV;
+    return command;
+}
+
+bool ska_sprite_draw_buffer_queue_sprite(SkaSpriteDrawBuffer* drawBuffer, SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, const SkaTransform2D* transform2D, int32 zIndex, SkaShaderInstance* shaderInstance) {
+    SkaSpriteDrawCommand* command = sprite_draw_buffer_push_command(drawBuffer, texture, sourceRect, destSize, color, flipH, flipV, zIndex, shaderInstance);
+    if (command == NULL) {
+        return false;
+    }
+    ska_affine2d_from_transform(transform2D, &command->model);
+    return true;
+}
+
+bool ska_sprite_draw_buffer_queue_sprite2(SkaSpriteDrawBuffer* drawBuffer, SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, mat4 trsMatrix, int32 zIndex, SkaShaderInstance* shaderInstance) {
+    SkaSpriteDrawCommand* command = sprite_draw_buffer_push_command(drawBuffer, texture, sourceRect, destSize, color, flipH, flipV, zIndex, shaderInstance);
+    if (command == NULL) {
+        return false;
+    }
+    ska_affine2d_from_mat4(trsMatrix, &command->model);
+    return true;
+}
+
+void ska_sprite_draw_buffer_clear(SkaSpriteDrawBuffer* drawBuffer) {
+    drawBuffer->count = 0;
+}
+
+#endif // #if SKA_RENDERING
@@ -0,0 +1,46 @@
+#pragma once
+
+#if SKA_RENDERING
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "texture.h"
+#include "shader/shader_instance.h"
+#include "seika/math/math.h"
+
+// Sprite draw call recorded on any thread, the transform is already resolved into a 2D affine model
+typedef struct SkaSpriteDrawCommand {
+    SkaTexture* texture;
+    SkaShaderInstance* shaderInstance;
+    SkaRect2 sourceRect;
+    SkaSize2D destSize;
+    SkaColor color;
+    SkaAffine2D model;
+    int32 zIndex;
+    bool flipH;
+    bool flipV;
+} SkaSpriteDrawCommand;
+
+// Fixed capacity command buffer, meant to be owned by one thread (e.g. one per job system worker) so sprites can be queued
+// without synchronization.  Buffers are merged with 'ska_renderer_queue_sprite_draw_buffers' on the main thread.
+typedef struct SkaSpriteDrawBuffer {
+    SkaSpriteDrawCommand* commands;
+    usize count;
+    usize capacity;
+} SkaSpriteDrawBuffer;
+
+// Create and destroy allocate, so they should be called from the main thread
+SkaSpriteDrawBuffer* ska_sprite_draw_buffer_create(usize capacity);
+void ska_sprite_draw_buffer_destroy(SkaSpriteDrawBuffer* drawBuffer);
+// Returns false if the buffer is full
+bool ska_sprite_draw_buffer_queue_sprite(SkaSpriteDrawBuffer* drawBuffer, SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, const SkaTransform2D* transform2D, int32 zIndex, SkaShaderInstance* shaderInstance);
+bool ska_sprite_draw_buffer_queue_sprite2(SkaSpriteDrawBuffer* drawBuffer, SkaTexture* texture, SkaRect2 sourceRect, SkaSize2D destSize, SkaColor color, bool flipH, bool flipV, mat4 trsMatrix, int32 zIndex, SkaShaderInstance* shaderInstance);
+void ska_sprite_draw_buffer_clear(SkaSpriteDrawBuffer* drawBuffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #if SKA_RENDERING
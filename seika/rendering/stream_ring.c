@@ -0,0 +1,25 @@
+#include "stream_ring.h"
+
+#include "seika/assert.h"
+
+void ska_stream_ring_initialize(SkaStreamRing* ring, usize size) {
+    SKA_ASSERT_FMT(size > 0, "Invalid stream ring size '%zu'", size);
+    ring->size = size;
+    ring->offset = 0;
+}
+
+SkaStreamRingRange ska_stream_ring_reserve(SkaStreamRing* ring, usize size) {
+    SkaStreamRingRange range = { .offset = 0, .needsNewStorage = false };
+    if (size > ring->size) {
+        while (ring->size < size) {
+            ring->size *= 2;
+        }
+        range.needsNewStorage = true;
+    } else if (ring->offset + size > ring->size) {
+        range.needsNewStorage = true;
+    } else {
+        range.offset = ring->offset;
+    }
+    ring->offset = range.offset + size;
+    return range;
+}
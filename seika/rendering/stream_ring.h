@@ -0,0 +1,27 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/defines.h"
+
+// Hands out the byte ranges of a streaming buffer that is written to every frame.  Each range is placed right after the
+// previous one so it never overlaps data the gpu may still be reading, once the end is reached the buffer needs new
+// storage (orphaned, or grown when the range is larger than the whole buffer) and ranges start over from the beginning.
+typedef struct SkaStreamRing {
+    usize size;
+    usize offset; // Start of the next range
+} SkaStreamRing;
+
+typedef struct SkaStreamRingRange {
+    usize offset;
+    bool needsNewStorage; // Buffer storage has to be respecified with the ring's size before writing the range
+} SkaStreamRingRange;
+
+void ska_stream_ring_initialize(SkaStreamRing* ring, usize size);
+SkaStreamRingRange ska_stream_ring_reserve(SkaStreamRing* ring, usize size);
+
+#ifdef __cplusplus
+}
+#endif
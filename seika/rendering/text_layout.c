@@ -0,0 +1,163 @@
+#if SKA_RENDERING
+
+#include "text_layout.h"
+
+#include <string.h>
+
+#include "seika/memory.h"
+#include "seika/string.h"
+
+#define SKA_TEXT_LAYOUT_NO_BREAK ((usize)-1)
+
+SkaTextLayout* ska_text_layout_create(SkaFont* font, const char* text, f32 scale, f32 maxWidth) {
+    SkaTextLayout* layout = SKA_ALLOC_ZEROED(SkaTextLayout);
+    layout->font = font;
+    layout->text = ska_strdup(text);
+    layout->scale = scale;
+    layout->maxWidth = maxWidth;
+    layout->color = (SkaColor){ 1.0f, 1.0f, 1.0f, 1.0f };
+    layout->isDirty = true;
+    return layout;
+}
+
+void ska_text_layout_destroy(SkaTextLayout* layout) {
+    SKA_FREE(layout->text);
+    SKA_FREE(layout->quads);
+    SKA_FREE(layout->glyphIndices);
+    SKA_FREE(layout);
+}
+
+void ska_text_layout_set_text(SkaTextLayout* layout, const char* text) {
+    if (strcmp(layout->text, text) != 0) {
+        SKA_FREE(layout->text);
+        layout->text = ska_strdup(text);
+        layout->isDirty = true;
+    }
+}
+
+void ska_text_layout_set_scale(SkaTextLayout* layout, f32 scale) {
+    if (layout->scale != scale) {
+        layout->scale = scale;
+        layout->isDirty = true;
+    }
+}
+
+void ska_text_layout_set_max_width(SkaTextLayout* layout, f32 maxWidth) {
+    if (layout->maxWidth != maxWidth) {
+        layout->maxWidth = maxWidth;
+        layout->isDirty = true;
+    }
+}
+
+void ska_text_layout_set_position(SkaTextLayout* layout, SkaVector2 position) {
+    // Quads have y pointing up, see 'ska_font_write_text_quads'
+    const f32 offsetX = position.x - layout->position.x;
+    const f32 offsetY = layout->position.y - position.y;
+    layout->position = position;
+    for (usize i = 0; i < layout->glyphCount; i++) {
+        layout->quads[i].rect[0] += offsetX;
+        layout->quads[i].rect[1] += offsetY;
+    }
+}
+
+void ska_text_layout_set_color(SkaTextLayout* layout, SkaColor color) {
+    layout->color = color;
+    unsigned char packedColor[4];
+    ska_font_pack_quad_color(&color, packedColor);
+    for (usize i = 0; i < layout->glyphCount; i++) {
+        memcpy(layout->quads[i].color, packedColor, sizeof(packedColor));
+    }
+}
+
+bool ska_text_layout_needs_update(const SkaTextLayout* layout) {
+    return layout->isDirty || layout->glyphCacheEvictionCount != layout->font->glyphCache->evictionCount;
+}
+
+// Moves the glyphs from 'firstGlyph' on by 'offsetX' and down by 'offsetY'
+static void text_layout_move_glyphs(SkaTextLayout* layout, usize firstGlyph, f32 offsetX, f32 offsetY) {
+    for (usize i = firstGlyph; i < layout->glyphCount; i++) {
+        layout->quads[i].rect[0] += offsetX;
+        layout->quads[i].rect[1] -= offsetY;
+    }
+}
+
+void ska_text_layout_update(SkaTextLayout* layout) {
+    if (!ska_text_layout_needs_update(layout)) {
+        return;
+    }
+    // Each glyph takes at least one byte
+    const usize maxGlyphCount = strlen(layout->text);
+    if (maxGlyphCount > layout->glyphCapacity) {
+        layout->glyphCapacity = maxGlyphCount;
+        layout->quads = (SkaFontGlyphQuad*)ska_mem_reallocate(layout->quads, layout->glyphCapacity * sizeof(SkaFontGlyphQuad));
+        layout->glyphIndices = (uint32*)ska_mem_reallocate(layout->glyphIndices, layout->glyphCapacity * sizeof(uint32));
+    }
+
+    SkaFont* font = layout->font;
+    const f32 scale = layout->scale;
+    const f32 lineHeight = ska_font_get_line_height(font) * scale;
+    f32 penX = 0.0f;
+    f32 baselineY = 0.0f;
+    f32 widestLine = 0.0f;
+    usize lineCount = 1;
+    // Wrapping moves everything after the line's last space to the next line
+    usize breakGlyph = SKA_TEXT_LAYOUT_NO_BREAK;
+    f32 breakPenX = 0.0f;
+    f32 breakLineWidth = 0.0f;
+    uint32 prevCodepoint = 0;
+    bool isGlyphMissing = false;
+    layout->glyphCount = 0;
+    const char* text = layout->text;
+    while (*text != '\0') {
+        const uint32 codepoint = ska_str_utf8_decode_next(&text);
+        if (codepoint == '\n') {
+            widestLine = SKA_MATH_MAX(widestLine, penX);
+            penX = 0.0f;
+            baselineY += lineHeight;
+            lineCount++;
+            breakGlyph = SKA_TEXT_LAYOUT_NO_BREAK;
+            prevCodepoint = 0;
+            continue;
+        }
+        const SkaFontCharacter* ch = ska_font_get_character(font, codepoint);
+        if (ch == NULL) {
+            // Glyph cache is full of glyphs in use this frame
+            isGlyphMissing = true;
+            continue;
+        }
+        if (prevCodepoint != 0) {
+            penX += ska_font_get_kerning(font, prevCodepoint, codepoint) * scale;
+        }
+        prevCodepoint = codepoint;
+        if (codepoint == ' ') {
+            breakLineWidth = penX;
+            penX += (f32)(ch->advance >> 6) * scale;
+            breakGlyph = layout->glyphCount;
+            breakPenX = penX;
+            continue;
+        }
+        if (ch->size.x > 0.0f && ch->size.y > 0.0f) {
+            const f32 glyphRight = penX + (ch->bearing.x + ch->size.x) * scale;
+            if (layout->maxWidth > 0.0f && glyphRight > layout->maxWidth && breakGlyph != SKA_TEXT_LAYOUT_NO_BREAK) {
+                widestLine = SKA_MATH_MAX(widestLine, breakLineWidth);
+                text_layout_move_glyphs(layout, breakGlyph, -breakPenX, lineHeight);
+                penX -= breakPenX;
+                baselineY += lineHeight;
+                lineCount++;
+                breakGlyph = SKA_TEXT_LAYOUT_NO_BREAK;
+            }
+            ska_font_write_glyph_quad(ch, layout->position.x + penX, layout->position.y + baselineY, scale, &layout->color, &layout->quads[layout->glyphCount]);
+            layout->glyphIndices[layout->glyphCount] = ska_font_get_character_index(font, ch);
+            layout->glyphCount++;
+        }
+        penX += (f32)(ch->advance >> 6) * scale;
+    }
+    layout->size = (SkaSize2D){ SKA_MATH_MAX(widestLine, penX), (f32)lineCount * lineHeight };
+    layout->glyphCacheEvictionCount = font->glyphCache->evictionCount;
+    // Laid out again next time so the missing glyphs show up once there's room for them
+    layout->isDirty = isGlyphMissing;
+}
+
+#undef SKA_TEXT_LAYOUT_NO_BREAK
+
+#endif // #if SKA_RENDERING
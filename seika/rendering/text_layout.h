@@ -0,0 +1,47 @@
+#pragma once
+
+#if SKA_RENDERING
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "font.h"
+
+// Text laid out once into a cached block of glyph quads (with kerning, '\n' line breaks and optional word wrapping at
+// 'maxWidth').  The block is reused by the renderer until the text, scale or wrap width changes or the font's glyph cache
+// evicts a glyph, so drawing unchanged text costs a single copy.  Moving or recoloring the text updates the block in place.
+typedef struct SkaTextLayout {
+    SkaFont* font;
+    char* text;
+    f32 scale;
+    f32 maxWidth; // Lines are wrapped at spaces to fit, 0 to only break at '\n'
+    SkaVector2 position; // Pen position at the first line's baseline
+    SkaColor color;
+    SkaSize2D size; // Width of the widest line and height of all lines, with the scale applied
+    SkaFontGlyphQuad* quads;
+    uint32* glyphIndices; // Glyph cache entry of each quad, marked as used whenever the block is reused
+    usize glyphCount;
+    usize glyphCapacity;
+    uint32 glyphCacheEvictionCount; // Of the font's glyph cache when laid out
+    bool isDirty;
+} SkaTextLayout;
+
+SkaTextLayout* ska_text_layout_create(SkaFont* font, const char* text, f32 scale, f32 maxWidth);
+void ska_text_layout_destroy(SkaTextLayout* layout);
+// Setters only mark the layout for a rebuild when the value changes
+void ska_text_layout_set_text(SkaTextLayout* layout, const char* text);
+void ska_text_layout_set_scale(SkaTextLayout* layout, f32 scale);
+void ska_text_layout_set_max_width(SkaTextLayout* layout, f32 maxWidth);
+void ska_text_layout_set_position(SkaTextLayout* layout, SkaVector2 position);
+void ska_text_layout_set_color(SkaTextLayout* layout, SkaColor color);
+// Returns true if the cached quads are stale and 'ska_text_layout_update' has to lay out the text again
+bool ska_text_layout_needs_update(const SkaTextLayout* layout);
+// Lays out the text again if needed, the renderer does this for queued layouts
+void ska_text_layout_update(SkaTextLayout* layout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #if SKA_RENDERING
@@ -23,7 +23,12 @@ static const struct SkaTexture DEFAULT_TEXTURE_REF = {
     .wrapS = GL_CLAMP_TO_BORDER,
     .wrapT = GL_CLAMP_TO_BORDER,
     .applyNearestNeighbor = true,
-    .fileName = NULL
+    .fileName = NULL,
+    .isAtlased = false,
+    .atlasOffsetX = 0,
+    .atlasOffsetY = 0,
+    .atlasPageWidth = 0,
+    .atlasPageHeight = 0
 };
 
 static inline bool ska_texture_is_texture_valid(const SkaTexture* texture) {
@@ -27,6 +27,13 @@ typedef struct SkaTexture {
     GLint wrapT;
     bool applyNearestNeighbor;
     char* fileName;
+    // Set for textures packed into a 'SkaTextureAtlas' page, 'id' is then the page's texture and the texture's pixels start
+    // at 'atlasOffsetX', 'atlasOffsetY' within the page
+    bool isAtlased;
+    GLsizei atlasOffsetX;
+    GLsizei atlasOffsetY;
+    GLsizei atlasPageWidth;
+    GLsizei atlasPageHeight;
 } SkaTexture;
 
 SkaTexture* ska_texture_create_texture(const char* filePath);
@@ -0,0 +1,144 @@
+#if SKA_RENDERING
+
+#include "texture_atlas.h"
+
+#include "seika/asset/asset_file_loader.h"
+#include "seika/memory.h"
+#include "seika/string.h"
+#include "seika/assert.h"
+
+SkaTextureAtlas* ska_texture_atlas_create(GLsizei pageSize) {
+    SKA_ASSERT_FMT(pageSize > SKA_TEXTURE_ATLAS_PADDING, "Invalid texture atlas page size '%d'", pageSize);
+    SkaTextureAtlas* atlas = SKA_ALLOC_ZEROED(SkaTextureAtlas);
+    atlas->pageSize = pageSize;
+    return atlas;
+}
+
+void ska_texture_atlas_destroy(SkaTextureAtlas* atlas) {
+    for (usize i = 0; i < atlas->pageCount; i++) {
+        glDeleteTextures(1, &atlas->pages[i].id);
+        ska_rect_packer_destroy(atlas->pages[i].packer);
+    }
+    SKA_FREE(atlas);
+}
+
+static SkaTextureAtlasPage* texture_atlas_add_page(SkaTextureAtlas* atlas) {
+    if (atlas->pageCount >= SKA_TEXTURE_ATLAS_MAX_PAGES) {
+        return NULL;
+    }
+    SkaTextureAtlasPage* page = &atlas->pages[atlas->pageCount++];
+    page->packer = ska_rect_packer_create(atlas->pageSize, atlas->pageSize);
+    // Pages start out transparent, which is what padding between textures relies on
+    const usize pageDataSize = (usize)atlas->pageSize * (usize)atlas->pageSize * 4;
+    unsigned char* pageData = (unsigned char*)SKA_ALLOC_BYTES_ZEROED(pageDataSize);
+    glGenTextures(1, &page->id);
+    glBindTexture(GL_TEXTURE_2D, page->id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlas->pageSize, atlas->pageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, pageData);
+    // Same wrap and filter modes as standalone textures, nearest neighbor is applied per sprite in the shader
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    SKA_FREE(pageData);
+    return page;
+}
+
+SkaTexture* ska_texture_atlas_add_image(SkaTextureAtlas* atlas, const unsigned char* data, GLsizei width, GLsizei height, int32 nrChannels, bool applyNearestNeighbor) {
+    if (nrChannels < 1 || nrChannels > 4) {
+        SKA_ASSERT_FMT(false, "Unsupported texture atlas image channel count '%d'", nrChannels);
+        return NULL;
+    }
+    const GLsizei paddedWidth = width + SKA_TEXTURE_ATLAS_PADDING;
+    const GLsizei paddedHeight = height + SKA_TEXTURE_ATLAS_PADDING;
+    if (width <= 0 || height <= 0 || paddedWidth > atlas->pageSize || paddedHeight > atlas->pageSize) {
+        return NULL;
+    }
+    // Padding goes right and below, the page's border covers the left and top edges
+    SkaTextureAtlasPage* page = NULL;
+    int32 x = 0;
+    int32 y = 0;
+    for (usize i = 0; i < atlas->pageCount; i++) {
+        if (ska_rect_packer_pack(atlas->pages[i].packer, paddedWidth, paddedHeight, &x, &y)) {
+            page = &atlas->pages[i];
+            break;
+        }
+    }
+    if (page == NULL) {
+        page = texture_atlas_add_page(atlas);
+        if (page == NULL || !ska_rect_packer_pack(page->packer, paddedWidth, paddedHeight, &x, &y)) {
+            return NULL;
+        }
+    }
+
+    // Pages are rgba, expand other formats the same way sampling them standalone would
+    const usize pixelCount = (usize)width * (usize)height;
+    unsigned char* rgbaData = (unsigned char*)data;
+    if (nrChannels != 4) {
+        rgbaData = (unsigned char*)SKA_ALLOC_BYTES(pixelCount * 4);
+        for (usize i = 0; i < pixelCount; i++) {
+            const unsigned char* pixel = &data[i * (usize)nrChannels];
+            unsigned char* rgbaPixel = &rgbaData[i * 4];
+            switch (nrChannels) {
+                case 1: {
+                    rgbaPixel[0] = pixel[0];
+                    rgbaPixel[1] = 0;
+                    rgbaPixel[2] = 0;
+                    rgbaPixel[3] = 255;
+                    break;
+                }
+                case 2: {
+                    // Grey + alpha (e.g. from stb_image)
+                    rgbaPixel[0] = pixel[0];
+                    rgbaPixel[1] = pixel[0];
+                    rgbaPixel[2] = pixel[0];
+                    rgbaPixel[3] = pixel[1];
+                    break;
+                }
+                default: {
+                    rgbaPixel[0] = pixel[0];
+                    rgbaPixel[1] = pixel[1];
+                    rgbaPixel[2] = pixel[2];
+                    rgbaPixel[3] = 255;
+                    break;
+                }
+            }
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, page->id);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgbaData);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (rgbaData != data) {
+        SKA_FREE(rgbaData);
+    }
+
+    SkaTexture* texture = SKA_ALLOC_ZEROED(SkaTexture);
+    texture->id = page->id;
+    texture->width = width;
+    texture->height = height;
+    texture->nrChannels = 4;
+    texture->internalFormat = GL_RGBA;
+    texture->imageFormat = GL_RGBA;
+    texture->wrapS = GL_CLAMP_TO_BORDER;
+    texture->wrapT = GL_CLAMP_TO_BORDER;
+    texture->applyNearestNeighbor = applyNearestNeighbor;
+    texture->isAtlased = true;
+    texture->atlasOffsetX = x;
+    texture->atlasOffsetY = y;
+    texture->atlasPageWidth = atlas->pageSize;
+    texture->atlasPageHeight = atlas->pageSize;
+    return texture;
+}
+
+SkaTexture* ska_texture_atlas_load_texture(SkaTextureAtlas* atlas, const char* filePath, bool applyNearestNeighbor) {
+    SkaAssetFileImageData* fileImageData = ska_asset_file_loader_load_image_data(filePath);
+    SKA_ASSERT_FMT(fileImageData != NULL, "Failed to load texture image at file path '%s'", filePath);
+    SkaTexture* texture = ska_texture_atlas_add_image(atlas, fileImageData->data, fileImageData->width, fileImageData->height, fileImageData->nrChannels, applyNearestNeighbor);
+    ska_asset_file_loader_free_image_data(fileImageData);
+    if (texture != NULL) {
+        texture->fileName = ska_strdup(filePath);
+    }
+    return texture;
+}
+
+#endif // #if SKA_RENDERING
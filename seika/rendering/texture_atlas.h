@@ -0,0 +1,43 @@
+#pragma once
+
+#if SKA_RENDERING
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "texture.h"
+#include "rect_packer.h"
+
+#define SKA_TEXTURE_ATLAS_MAX_PAGES 16
+// Transparent pixels kept between packed textures, so filtering at a texture's edge matches a standalone clamp to border texture
+#define SKA_TEXTURE_ATLAS_PADDING 1
+
+typedef struct SkaTextureAtlasPage {
+    GLuint id;
+    SkaRectPacker* packer;
+} SkaTextureAtlasPage;
+
+// Packs textures into shared rgba pages at runtime.  Textures from the same page share a texture id, so the renderer
+// batches sprites using different atlased textures together.  Textures that repeat can't be atlased.
+typedef struct SkaTextureAtlas {
+    SkaTextureAtlasPage pages[SKA_TEXTURE_ATLAS_MAX_PAGES];
+    usize pageCount;
+    GLsizei pageSize;
+} SkaTextureAtlas;
+
+SkaTextureAtlas* ska_texture_atlas_create(GLsizei pageSize);
+// Deletes the pages, textures created from the atlas can no longer be drawn afterwards
+void ska_texture_atlas_destroy(SkaTextureAtlas* atlas);
+// Packs the image's pixels into a page (a new one is created when needed) and returns a texture for the region.
+// 'nrChannels' is 1 to 4, grey + alpha images are expanded to (grey, grey, grey, alpha).
+// Returns NULL if the image is larger than a page, all pages are full or the channel count is unsupported.
+SkaTexture* ska_texture_atlas_add_image(SkaTextureAtlas* atlas, const unsigned char* data, GLsizei width, GLsizei height, int32 nrChannels, bool applyNearestNeighbor);
+// Same as 'ska_texture_atlas_add_image' with the image loaded from 'filePath'
+SkaTexture* ska_texture_atlas_load_texture(SkaTextureAtlas* atlas, const char* filePath, bool applyNearestNeighbor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #if SKA_RENDERING
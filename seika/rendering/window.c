@@ -56,7 +56,7 @@ bool ska_window_initialize(SkaWindowProperties props) {
     }
 
     // Initialize rendering
-    ska_renderer_initialize(props.windowWidth, props.windowHeight, props.resolutionWidth, props.resolutionHeight, props.maintainAspectRatio);
+    ska_renderer_initialize2(props.windowWidth, props.windowHeight, props.resolutionWidth, props.resolutionHeight, props.maintainAspectRatio, props.spriteMode);
 
     isWindowActive = true;
     return true;
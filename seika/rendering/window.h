@@ -7,6 +7,7 @@ extern "C" {
 #endif
 
 #include "seika/defines.h"
+#include "renderer.h"
 
 struct SkaColor;
 
@@ -17,6 +18,7 @@ typedef struct SkaWindowProperties {
     int32 resolutionWidth;
     int32 resolutionHeight;
     bool maintainAspectRatio;
+    SkaRendererSpriteMode spriteMode;
 } SkaWindowProperties;
 
 bool ska_window_initialize(SkaWindowProperties props);
@@ -138,6 +138,47 @@ void ska_str_remove_char(char* string, char charToRemove) {
     *dest = '\0';
 }
 
+uint32 ska_str_utf8_decode_next(const char** text) {
+    const unsigned char* bytes = (const unsigned char*)*text;
+    const uint32 lead = bytes[0];
+    uint32 codepoint;
+    usize length;
+    uint32 minCodepoint;
+    if (lead < 0x80) {
+        *text += 1;
+        return lead;
+    } else if ((lead & 0xE0) == 0xC0) {
+        codepoint = lead & 0x1F;
+        length = 2;
+        minCodepoint = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        codepoint = lead & 0x0F;
+        length = 3;
+        minCodepoint = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        codepoint = lead & 0x07;
+        length = 4;
+        minCodepoint = 0x10000;
+    } else {
+        *text += 1;
+        return SKA_STR_UTF8_REPLACEMENT_CHARACTER;
+    }
+    // Stops at the null terminator as it isn't a continuation byte
+    for (usize i = 1; i < length; i++) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            *text += 1;
+            return SKA_STR_UTF8_REPLACEMENT_CHARACTER;
+        }
+        codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+    }
+    if (codepoint < minCodepoint || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        *text += 1;
+        return SKA_STR_UTF8_REPLACEMENT_CHARACTER;
+    }
+    *text += length;
+    return codepoint;
+}
+
 char* get_project_archive_name(const char* startingPath) {
     if (startingPath == NULL) {
         return NULL;
@@ -25,3 +25,10 @@ void ska_str_trim_by_size(const char* value, char* output, usize size);
 char* ska_str_trim_and_replace(const char* value, char delimiter, const char* replacementValue);
 // Removes all instances of the passed in char from the string
 void ska_str_remove_char(char* string, char charToRemove);
+
+// Unicode
+#define SKA_STR_UTF8_REPLACEMENT_CHARACTER 0xFFFD
+
+// Decodes the UTF-8 codepoint at '*text' and moves '*text' past it.  Malformed sequences (invalid, overlong, surrogates,
+// truncated) decode as 'SKA_STR_UTF8_REPLACEMENT_CHARACTER' and skip a single byte.
+uint32 ska_str_utf8_decode_next(const char** text);
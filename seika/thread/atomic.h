@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdatomic.h>
+
+#include "seika/defines.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// Thin wrappers over C11 atomics with explicit memory orders, so call sites read the same on every platform
+
+#define SKA_ATOMIC(TYPE) _Atomic(TYPE)
+
+typedef enum SkaMemoryOrder {
+    SkaMemoryOrder_RELAXED = memory_order_relaxed,
+    SkaMemoryOrder_ACQUIRE = memory_order_acquire,
+    SkaMemoryOrder_RELEASE = memory_order_release,
+    SkaMemoryOrder_ACQ_REL = memory_order_acq_rel,
+    SkaMemoryOrder_SEQ_CST = memory_order_seq_cst,
+} SkaMemoryOrder;
+
+#define ska_atomic_init(PTR, VALUE) atomic_init((PTR), (VALUE))
+#define ska_atomic_load(PTR, ORDER) atomic_load_explicit((PTR), (memory_order)(ORDER))
+#define ska_atomic_store(PTR, VALUE, ORDER) atomic_store_explicit((PTR), (VALUE), (memory_order)(ORDER))
+#define ska_atomic_exchange(PTR, VALUE, ORDER) atomic_exchange_explicit((PTR), (VALUE), (memory_order)(ORDER))
+#define ska_atomic_fetch_add(PTR, VALUE, ORDER) atomic_fetch_add_explicit((PTR), (VALUE), (memory_order)(ORDER))
+#define ska_atomic_fetch_sub(PTR, VALUE, ORDER) atomic_fetch_sub_explicit((PTR), (VALUE), (memory_order)(ORDER))
+#define ska_atomic_fetch_or(PTR, VALUE, ORDER) atomic_fetch_or_explicit((PTR), (VALUE), (memory_order)(ORDER))
+#define ska_atomic_fetch_and(PTR, VALUE, ORDER) atomic_fetch_and_explicit((PTR), (VALUE), (memory_order)(ORDER))
+// 'EXPECTED_PTR' is updated with the current value on failure
+#define ska_atomic_compare_exchange(PTR, EXPECTED_PTR, DESIRED, SUCCESS_ORDER, FAILURE_ORDER) \
+atomic_compare_exchange_strong_explicit((PTR), (EXPECTED_PTR), (DESIRED), (memory_order)(SUCCESS_ORDER), (memory_order)(FAILURE_ORDER))
+// Can fail spuriously, meant for loops
+#define ska_atomic_compare_exchange_weak(PTR, EXPECTED_PTR, DESIRED, SUCCESS_ORDER, FAILURE_ORDER) \
+atomic_compare_exchange_weak_explicit((PTR), (EXPECTED_PTR), (DESIRED), (memory_order)(SUCCESS_ORDER), (memory_order)(FAILURE_ORDER))
+#define ska_atomic_thread_fence(ORDER) atomic_thread_fence((memory_order)(ORDER))
+
+// Hint to the cpu that the thread is spinning
+static inline void ska_cpu_relax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,182 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // sched_getaffinity, pthread_setaffinity_np
+#endif
+
+#include "cpu_topology.h"
+
+#include <stdio.h>
+
+#if defined(PLATFORM_LINUX)
+#include <sched.h>
+#endif
+
+static void cpu_topology_set_unknown(SkaCpuTopology* topology) {
+    const unsigned int procCount = pcthread_get_num_procs();
+    topology->cpuCount = procCount == 0 ? 1 : procCount > SKA_CPU_TOPOLOGY_MAX_CPUS ? SKA_CPU_TOPOLOGY_MAX_CPUS : (usize)procCount;
+    topology->physicalCoreCount = topology->cpuCount;
+    for (usize i = 0; i < topology->cpuCount; i++) {
+        topology->cpuIds[i] = (uint32)i;
+        topology->coreIds[i] = (uint32)i;
+    }
+}
+
+#if defined(PLATFORM_LINUX)
+static bool cpu_topology_read_sys_value(uint32 cpuId, const char* name, uint32* outValue) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/%s", cpuId, name);
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+    const bool wasRead = fscanf(file, "%u", outValue) == 1;
+    fclose(file);
+    return wasRead;
+}
+#endif
+
+// Maps platform core keys (e.g. package and core id) to dense core ids
+static void cpu_topology_assign_core_ids(SkaCpuTopology* topology, const uint64* coreKeys) {
+    topology->physicalCoreCount = 0;
+    for (usize i = 0; i < topology->cpuCount; i++) {
+        topology->coreIds[i] = (uint32)topology->physicalCoreCount;
+        for (usize j = 0; j < i; j++) {
+            if (coreKeys[j] == coreKeys[i]) {
+                topology->coreIds[i] = topology->coreIds[j];
+                break;
+            }
+        }
+        if (topology->coreIds[i] == (uint32)topology->physicalCoreCount) {
+            topology->physicalCoreCount++;
+        }
+    }
+}
+
+void ska_cpu_topology_query(SkaCpuTopology* outTopology) {
+    *outTopology = (SkaCpuTopology){0};
+#if defined(PLATFORM_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        cpu_topology_set_unknown(outTopology);
+        return;
+    }
+    uint64 coreKeys[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    for (uint32 cpuId = 0; cpuId < CPU_SETSIZE && outTopology->cpuCount < SKA_CPU_TOPOLOGY_MAX_CPUS; cpuId++) {
+        if (!CPU_ISSET(cpuId, &cpuSet)) {
+            continue;
+        }
+        uint32 packageId = 0;
+        uint32 coreId = cpuId;
+        if (!cpu_topology_read_sys_value(cpuId, "physical_package_id", &packageId) || !cpu_topology_read_sys_value(cpuId, "core_id", &coreId)) {
+            packageId = 0;
+            coreId = cpuId;
+        }
+        coreKeys[outTopology->cpuCount] = ((uint64)packageId << 32) | coreId;
+        outTopology->cpuIds[outTopology->cpuCount++] = cpuId;
+    }
+    if (outTopology->cpuCount == 0) {
+        cpu_topology_set_unknown(outTopology);
+        return;
+    }
+    cpu_topology_assign_core_ids(outTopology, coreKeys);
+#elif defined(PLATFORM_WINDOWS)
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION infos[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    DWORD infosSize = sizeof(infos);
+    if (!GetLogicalProcessorInformation(infos, &infosSize)) {
+        cpu_topology_set_unknown(outTopology);
+        return;
+    }
+    uint64 coreKeys[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    const usize infoCount = infosSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+    for (usize i = 0; i < infoCount; i++) {
+        if (infos[i].Relationship != RelationProcessorCore) {
+            continue;
+        }
+        for (uint32 cpuId = 0; cpuId < sizeof(ULONG_PTR) * 8 && outTopology->cpuCount < SKA_CPU_TOPOLOGY_MAX_CPUS; cpuId++) {
+            if (infos[i].ProcessorMask & ((ULONG_PTR)1 << cpuId)) {
+                coreKeys[outTopology->cpuCount] = (uint64)i;
+                outTopology->cpuIds[outTopology->cpuCount++] = cpuId;
+            }
+        }
+    }
+    if (outTopology->cpuCount == 0) {
+        cpu_topology_set_unknown(outTopology);
+        return;
+    }
+    cpu_topology_assign_core_ids(outTopology, coreKeys);
+#else
+    cpu_topology_set_unknown(outTopology);
+#endif
+}
+
+usize ska_cpu_topology_get_spread_order(const SkaCpuTopology* topology, uint32* outCpuIds, usize capacity) {
+    // Pass 'n' takes the 'n'th cpu of each core
+    usize count = 0;
+    for (usize pass = 0; count < topology->cpuCount && count < capacity; pass++) {
+        for (uint32 coreId = 0; coreId < (uint32)topology->physicalCoreCount && count < capacity; coreId++) {
+            usize coreCpuIndex = 0;
+            for (usize i = 0; i < topology->cpuCount; i++) {
+                if (topology->coreIds[i] != coreId) {
+                    continue;
+                }
+                if (coreCpuIndex++ == pass) {
+                    outCpuIds[count++] = topology->cpuIds[i];
+                    break;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+static uint32 cpu_topology_get_core_id(const SkaCpuTopology* topology, uint32 cpuId) {
+    for (usize i = 0; i < topology->cpuCount; i++) {
+        if (topology->cpuIds[i] == cpuId) {
+            return topology->coreIds[i];
+        }
+    }
+    return 0;
+}
+
+usize ska_cpu_topology_get_reserved_spread_order(const SkaCpuTopology* topology, usize reservedCoreCount, uint32* outCpuIds, usize capacity, usize* outReservedCpuCount) {
+    uint32 spreadCpuIds[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    const usize cpuCount = ska_cpu_topology_get_spread_order(topology, spreadCpuIds, SKA_CPU_TOPOLOGY_MAX_CPUS);
+    // Core ids are dense and the spread order visits them in order, so the first cores are the ones with the lowest ids
+    usize count = 0;
+    for (usize i = 0; i < cpuCount && count < capacity; i++) {
+        if (cpu_topology_get_core_id(topology, spreadCpuIds[i]) < reservedCoreCount) {
+            outCpuIds[count++] = spreadCpuIds[i];
+        }
+    }
+    *outReservedCpuCount = count;
+    for (usize i = 0; i < cpuCount && count < capacity; i++) {
+        if (cpu_topology_get_core_id(topology, spreadCpuIds[i]) >= reservedCoreCount) {
+            outCpuIds[count++] = spreadCpuIds[i];
+        }
+    }
+    return count;
+}
+
+bool ska_cpu_pin_thread(pthread_t thread, uint32 cpuId) {
+#if defined(PLATFORM_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpuId, &cpuSet);
+    return pthread_setaffinity_np(thread, sizeof(cpuSet), &cpuSet) == 0;
+#elif defined(PLATFORM_WINDOWS)
+    return cpuId < sizeof(DWORD_PTR) * 8 && SetThreadAffinityMask(thread, (DWORD_PTR)1 << cpuId) != 0;
+#else
+    return false;
+#endif
+}
+
+bool ska_cpu_pin_current_thread(uint32 cpuId) {
+#if defined(PLATFORM_WINDOWS)
+    // 'pthread_self' of the windows shim doesn't return a handle
+    return ska_cpu_pin_thread(GetCurrentThread(), cpuId);
+#elif defined(PLATFORM_LINUX)
+    return ska_cpu_pin_thread(pthread_self(), cpuId);
+#else
+    return false;
+#endif
+}
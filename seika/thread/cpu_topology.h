@@ -0,0 +1,32 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/thread/pthread.h"
+
+#define SKA_CPU_TOPOLOGY_MAX_CPUS 256
+
+// Logical cpus the process is allowed to run on and the physical core each belongs to (SMT siblings share a core)
+typedef struct SkaCpuTopology {
+    usize cpuCount;
+    usize physicalCoreCount;
+    uint32 cpuIds[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    uint32 coreIds[SKA_CPU_TOPOLOGY_MAX_CPUS];
+} SkaCpuTopology;
+
+// Falls back to every logical cpu being its own core if the platform doesn't expose the topology
+void ska_cpu_topology_query(SkaCpuTopology* outTopology);
+// Writes cpu ids with one cpu per physical core first followed by the SMT siblings, returns the amount written
+usize ska_cpu_topology_get_spread_order(const SkaCpuTopology* topology, uint32* outCpuIds, usize capacity);
+// Same as 'ska_cpu_topology_get_spread_order' except the cpus of the first 'reservedCoreCount' physical cores, including all
+// of their SMT siblings, come first.  'outReservedCpuCount' is set to the amount of those cpus.
+usize ska_cpu_topology_get_reserved_spread_order(const SkaCpuTopology* topology, usize reservedCoreCount, uint32* outCpuIds, usize capacity, usize* outReservedCpuCount);
+// Pins a thread to a logical cpu, returns false if unsupported or it failed
+bool ska_cpu_pin_thread(pthread_t thread, uint32 cpuId);
+bool ska_cpu_pin_current_thread(uint32 cpuId);
+
+#ifdef __cplusplus
+}
+#endif
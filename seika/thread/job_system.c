@@ -0,0 +1,876 @@
+#include "job_system.h"
+
+#include "seika/thread/atomic.h"
+#include <string.h>
+#include <time.h>
+
+#include "seika/memory.h"
+#include "seika/assert.h"
+#include "seika/logger.h"
+#include "seika/thread/sync.h"
+
+// Both sizes must be a power of 2
+#define SKA_JOB_DEQUE_CAPACITY 4096
+#define SKA_JOB_INJECTION_QUEUE_CAPACITY 8192
+// How many times an idle worker looks for work (yielding in between) before parking
+#define SKA_JOB_WORKER_SPIN_COUNT 64
+// Counters and continuations come from fixed pools so they can be created from any thread without the allocator
+#define SKA_JOB_SYSTEM_MAX_COUNTERS 1024
+#define SKA_JOB_SYSTEM_MAX_CONTINUATIONS 4096
+#define SKA_JOB_SYSTEM_MAX_COROUTINES 1024
+// Keeps frequently written atomics of different workers on separate cache lines
+#define SKA_JOB_CACHE_LINE_SIZE 64
+
+#if defined(_MSC_VER)
+#define SKA_JOB_THREAD_LOCAL __declspec(thread)
+#else
+#define SKA_JOB_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct JobSystemJob {
+    SkaJobFunc func;
+    void* arg;
+    SkaJobCounter* counter; // Signaled once the job finishes, can be NULL
+    uint64 queueTime; // Nanoseconds, only set while stats are enabled
+} JobSystemJob;
+
+// --- Job Stats --- //
+// Each worker only writes its own stats, atomics are so they can be read from any thread
+typedef struct JobWorkerStats {
+    SKA_ATOMIC(uint64) jobsRun;
+    SKA_ATOMIC(uint64) busyTime;
+    SKA_ATOMIC(uint64) idleTime;
+    SKA_ATOMIC(uint64) stealAttempts;
+    SKA_ATOMIC(uint64) steals;
+    SKA_ATOMIC(usize) peakQueueDepth;
+    SKA_ATOMIC(uint64) latencyHistogram[SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT];
+    SKA_ATOMIC(uint64) runTimeHistogram[SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT];
+} JobWorkerStats;
+
+static uint64 job_stats_get_time_ns() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64)ts.tv_sec * 1000000000ull + (uint64)ts.tv_nsec;
+}
+
+static usize job_stats_get_histogram_bucket(uint64 durationNs) {
+    usize bucket = 0;
+    while (durationNs > 1 && bucket < SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT - 1) {
+        durationNs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// Relaxed add for stats that can be written by more than one thread (external stats)
+static void job_stats_add(SKA_ATOMIC(uint64)* stat, uint64 amount) {
+    ska_atomic_fetch_add(stat, amount, SkaMemoryOrder_RELAXED);
+}
+
+static void job_stats_update_peak(SKA_ATOMIC(usize)* peak, usize value) {
+    usize currentPeak = ska_atomic_load(peak, SkaMemoryOrder_RELAXED);
+    while (value > currentPeak && !ska_atomic_compare_exchange_weak(peak, &currentPeak, value, SkaMemoryOrder_RELAXED, SkaMemoryOrder_RELAXED)) {}
+}
+
+static void job_stats_reset(JobWorkerStats* stats) {
+    ska_atomic_store(&stats->jobsRun, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&stats->busyTime, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&stats->idleTime, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&stats->stealAttempts, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&stats->steals, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&stats->peakQueueDepth, 0, SkaMemoryOrder_SEQ_CST);
+    for (usize i = 0; i < SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT; i++) {
+        ska_atomic_store(&stats->latencyHistogram[i], 0, SkaMemoryOrder_SEQ_CST);
+        ska_atomic_store(&stats->runTimeHistogram[i], 0, SkaMemoryOrder_SEQ_CST);
+    }
+}
+
+static void job_stats_read(const JobWorkerStats* stats, SkaJobWorkerStats* outStats, uint64* outLatencyHistogram, uint64* outRunTimeHistogram) {
+    JobWorkerStats* mutableStats = (JobWorkerStats*)stats;
+    outStats->jobsRun = ska_atomic_load(&mutableStats->jobsRun, SkaMemoryOrder_RELAXED);
+    outStats->busyTimeNs = ska_atomic_load(&mutableStats->busyTime, SkaMemoryOrder_RELAXED);
+    outStats->idleTimeNs = ska_atomic_load(&mutableStats->idleTime, SkaMemoryOrder_RELAXED);
+    outStats->stealAttempts = ska_atomic_load(&mutableStats->stealAttempts, SkaMemoryOrder_RELAXED);
+    outStats->steals = ska_atomic_load(&mutableStats->steals, SkaMemoryOrder_RELAXED);
+    outStats->peakQueueDepth = ska_atomic_load(&mutableStats->peakQueueDepth, SkaMemoryOrder_RELAXED);
+    for (usize i = 0; i < SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT; i++) {
+        outLatencyHistogram[i] += ska_atomic_load(&mutableStats->latencyHistogram[i], SkaMemoryOrder_RELAXED);
+        outRunTimeHistogram[i] += ska_atomic_load(&mutableStats->runTimeHistogram[i], SkaMemoryOrder_RELAXED);
+    }
+}
+
+// --- Job Deque --- //
+// Chase-Lev work stealing deque with a fixed capacity.  Only the owning worker pushes and pops at the bottom,
+// any thread can steal from the top.
+typedef struct JobDequeSlot {
+    SKA_ATOMIC(SkaJobFunc) func;
+    SKA_ATOMIC(void*) arg;
+    SKA_ATOMIC(SkaJobCounter*) counter;
+    SKA_ATOMIC(uint64) queueTime;
+} JobDequeSlot;
+
+typedef struct JobDeque {
+    SKA_ATOMIC(int64) top;
+    char topPadding[SKA_JOB_CACHE_LINE_SIZE - sizeof(int64)];
+    SKA_ATOMIC(int64) bottom;
+    char bottomPadding[SKA_JOB_CACHE_LINE_SIZE - sizeof(int64)];
+    JobDequeSlot* slots;
+} JobDeque;
+
+typedef enum JobDequeStealResult {
+    JobDequeStealResult_SUCCESS,
+    JobDequeStealResult_EMPTY,
+    JobDequeStealResult_ABORT, // Lost a race with another thief or the owner, deque may still have jobs
+} JobDequeStealResult;
+
+static void job_deque_initialize(JobDeque* deque) {
+    ska_atomic_init(&deque->top, 0);
+    ska_atomic_init(&deque->bottom, 0);
+    deque->slots = (JobDequeSlot*)SKA_ALLOC_BYTES_ZEROED(SKA_JOB_DEQUE_CAPACITY * sizeof(JobDequeSlot));
+}
+
+static void job_deque_finalize(JobDeque* deque) {
+    SKA_FREE(deque->slots);
+    deque->slots = NULL;
+}
+
+static bool job_deque_push(JobDeque* deque, JobSystemJob job) {
+    const int64 bottom = ska_atomic_load(&deque->bottom, SkaMemoryOrder_RELAXED);
+    const int64 top = ska_atomic_load(&deque->top, SkaMemoryOrder_ACQUIRE);
+    if (bottom - top >= SKA_JOB_DEQUE_CAPACITY) {
+        return false;
+    }
+    JobDequeSlot* slot = &deque->slots[bottom & (SKA_JOB_DEQUE_CAPACITY - 1)];
+    ska_atomic_store(&slot->func, job.func, SkaMemoryOrder_RELAXED);
+    ska_atomic_store(&slot->arg, job.arg, SkaMemoryOrder_RELAXED);
+    ska_atomic_store(&slot->counter, job.counter, SkaMemoryOrder_RELAXED);
+    ska_atomic_store(&slot->queueTime, job.queueTime, SkaMemoryOrder_RELAXED);
+    ska_atomic_thread_fence(SkaMemoryOrder_RELEASE);
+    ska_atomic_store(&deque->bottom, bottom + 1, SkaMemoryOrder_RELAXED);
+    return true;
+}
+
+static bool job_deque_pop(JobDeque* deque, JobSystemJob* outJob) {
+    const int64 bottom = ska_atomic_load(&deque->bottom, SkaMemoryOrder_RELAXED) - 1;
+    ska_atomic_store(&deque->bottom, bottom, SkaMemoryOrder_RELAXED);
+    ska_atomic_thread_fence(SkaMemoryOrder_SEQ_CST);
+    int64 top = ska_atomic_load(&deque->top, SkaMemoryOrder_RELAXED);
+    if (top > bottom) {
+        ska_atomic_store(&deque->bottom, bottom + 1, SkaMemoryOrder_RELAXED);
+        return false;
+    }
+    JobDequeSlot* slot = &deque->slots[bottom & (SKA_JOB_DEQUE_CAPACITY - 1)];
+    outJob->func = ska_atomic_load(&slot->func, SkaMemoryOrder_RELAXED);
+    outJob->arg = ska_atomic_load(&slot->arg, SkaMemoryOrder_RELAXED);
+    outJob->counter = ska_atomic_load(&slot->counter, SkaMemoryOrder_RELAXED);
+    outJob->queueTime = ska_atomic_load(&slot->queueTime, SkaMemoryOrder_RELAXED);
+    if (top == bottom) {
+        // Last job, race thieves for it
+        const bool wonRace = ska_atomic_compare_exchange(&deque->top, &top, top + 1, SkaMemoryOrder_SEQ_CST, SkaMemoryOrder_RELAXED);
+        ska_atomic_store(&deque->bottom, bottom + 1, SkaMemoryOrder_RELAXED);
+        return wonRace;
+    }
+    return true;
+}
+
+static JobDequeStealResult job_deque_steal(JobDeque* deque, JobSystemJob* outJob) {
+    int64 top = ska_atomic_load(&deque->top, SkaMemoryOrder_ACQUIRE);
+    ska_atomic_thread_fence(SkaMemoryOrder_SEQ_CST);
+    const int64 bottom = ska_atomic_load(&deque->bottom, SkaMemoryOrder_ACQUIRE);
+    if (top >= bottom) {
+        return JobDequeStealResult_EMPTY;
+    }
+    JobDequeSlot* slot = &deque->slots[top & (SKA_JOB_DEQUE_CAPACITY - 1)];
+    outJob->func = ska_atomic_load(&slot->func, SkaMemoryOrder_RELAXED);
+    outJob->arg = ska_atomic_load(&slot->arg, SkaMemoryOrder_RELAXED);
+    outJob->counter = ska_atomic_load(&slot->counter, SkaMemoryOrder_RELAXED);
+    outJob->queueTime = ska_atomic_load(&slot->queueTime, SkaMemoryOrder_RELAXED);
+    if (!ska_atomic_compare_exchange(&deque->top, &top, top + 1, SkaMemoryOrder_SEQ_CST, SkaMemoryOrder_RELAXED)) {
+        return JobDequeStealResult_ABORT;
+    }
+    return JobDequeStealResult_SUCCESS;
+}
+
+static bool job_deque_is_empty(JobDeque* deque) {
+    return ska_atomic_load(&deque->top, SkaMemoryOrder_SEQ_CST) >= ska_atomic_load(&deque->bottom, SkaMemoryOrder_SEQ_CST);
+}
+
+static usize job_deque_get_depth(JobDeque* deque) {
+    const int64 top = ska_atomic_load(&deque->top, SkaMemoryOrder_SEQ_CST);
+    const int64 bottom = ska_atomic_load(&deque->bottom, SkaMemoryOrder_SEQ_CST);
+    return bottom > top ? (usize)(bottom - top) : 0;
+}
+
+// --- Job Injection Queue --- //
+// Jobs submitted from threads that aren't workers (or from workers with a full deque)
+#define SKA_MPMC_RING_BUFFER_TEMPLATE JobSystemJob
+#include "seika/data_structures/mpmc_ring_buffer_template.h"
+
+typedef SkaMPMCRingBuffer_JobSystemJob JobInjectionQueue;
+
+// --- Job Pool Free List --- //
+// Lock free stack of free pool indices.  The head packs a tag (upper 32 bits) with the index + 1 (lower 32 bits, 0 is empty)
+// so a head that was popped and pushed back in between can't be mistaken as unchanged.
+typedef struct JobPoolFreeList {
+    SKA_ATOMIC(uint64) head;
+    SKA_ATOMIC(uint32)* nextIndices;
+} JobPoolFreeList;
+
+#define SKA_JOB_POOL_INVALID_INDEX ((uint32)-1)
+
+static void job_pool_free_list_initialize(JobPoolFreeList* freeList, uint32 capacity) {
+    freeList->nextIndices = (SKA_ATOMIC(uint32)*)SKA_ALLOC_BYTES(capacity * sizeof(SKA_ATOMIC(uint32)));
+    for (uint32 i = 0; i < capacity; i++) {
+        ska_atomic_init(&freeList->nextIndices[i], i + 1 < capacity ? i + 2 : 0);
+    }
+    ska_atomic_init(&freeList->head, capacity > 0 ? 1 : 0);
+}
+
+static void job_pool_free_list_finalize(JobPoolFreeList* freeList) {
+    SKA_FREE((void*)freeList->nextIndices);
+    freeList->nextIndices = NULL;
+}
+
+static uint32 job_pool_free_list_pop(JobPoolFreeList* freeList) {
+    uint64 head = ska_atomic_load(&freeList->head, SkaMemoryOrder_SEQ_CST);
+    while ((uint32)head != 0) {
+        const uint32 index = (uint32)head - 1;
+        const uint64 newHead = (((head >> 32) + 1) << 32) | ska_atomic_load(&freeList->nextIndices[index], SkaMemoryOrder_RELAXED);
+        if (ska_atomic_compare_exchange_weak(&freeList->head, &head, newHead, SkaMemoryOrder_SEQ_CST, SkaMemoryOrder_SEQ_CST)) {
+            return index;
+        }
+    }
+    return SKA_JOB_POOL_INVALID_INDEX;
+}
+
+static void job_pool_free_list_push(JobPoolFreeList* freeList, uint32 index) {
+    uint64 head = ska_atomic_load(&freeList->head, SkaMemoryOrder_SEQ_CST);
+    uint64 newHead;
+    do {
+        ska_atomic_store(&freeList->nextIndices[index], (uint32)head, SkaMemoryOrder_RELAXED);
+        newHead = (((head >> 32) + 1) << 32) | (uint64)(index + 1);
+    } while (!ska_atomic_compare_exchange_weak(&freeList->head, &head, newHead, SkaMemoryOrder_SEQ_CST, SkaMemoryOrder_SEQ_CST));
+}
+
+// --- Job Counter --- //
+typedef struct JobContinuation {
+    JobSystemJob job;
+    struct JobContinuation* next;
+} JobContinuation;
+
+struct SkaJobCounter {
+    struct SkaJobSystem* jobSystem;
+    SKA_ATOMIC(usize) value;
+    SKA_ATOMIC(usize) signalingCount; // Threads currently signaling, the counter can't be released until this is zero
+    SKA_ATOMIC(JobContinuation*) continuations; // Lock free stack of jobs waiting for the counter to reach zero
+};
+
+// --- Job Coroutine --- //
+typedef struct JobCoroutine {
+    SkaJobCoroutine coroutine;
+    SkaJobCoroutineFunc func;
+    void* arg;
+    SkaJobCounter* counter;
+    struct SkaJobSystem* jobSystem;
+} JobCoroutine;
+
+// --- Job System --- //
+typedef struct JobWorker {
+    JobDeque deque;
+    struct SkaJobSystem* jobSystem;
+    usize index;
+    uint32 randomState;
+    pthread_t thread;
+    // Parking
+    SkaThreadEvent parkEvent;
+    int32 cpuId; // -1 if not pinned
+    JobWorkerStats stats;
+} JobWorker;
+
+struct SkaJobSystem {
+    JobInjectionQueue injectionQueue;
+    JobWorker* workers;
+    usize workerCount;
+    SKA_ATOMIC(uint64) parkedWorkerMask; // Bit per worker that is parked (or about to park)
+    SKA_ATOMIC(usize) pendingJobCount; // Jobs submitted that haven't finished running, including continuations waiting on a counter
+    SKA_ATOMIC(bool) shouldStop;
+    SkaJobCounter* counters;
+    JobPoolFreeList counterFreeList;
+    JobContinuation* continuations;
+    JobPoolFreeList continuationFreeList;
+    JobCoroutine* coroutines;
+    JobPoolFreeList coroutineFreeList;
+    // Stats
+    SKA_ATOMIC(bool) isStatsEnabled;
+    JobWorkerStats externalStats; // Jobs run by threads that aren't workers
+    SKA_ATOMIC(usize) peakInjectionQueueDepth;
+    // Topology
+    uint32 reservedCpuIds[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    usize reservedCpuCount;
+};
+
+static void job_system_queue_job(SkaJobSystem* jobSystem, JobSystemJob job);
+
+// Takes all continuations so each is only queued by one thread
+static void job_counter_queue_continuations(SkaJobCounter* counter) {
+    SkaJobSystem* jobSystem = counter->jobSystem;
+    JobContinuation* continuation = ska_atomic_exchange(&counter->continuations, NULL, SkaMemoryOrder_SEQ_CST);
+    while (continuation != NULL) {
+        JobContinuation* nextContinuation = continuation->next;
+        const JobSystemJob job = continuation->job;
+        job_pool_free_list_push(&jobSystem->continuationFreeList, (uint32)(continuation - jobSystem->continuations));
+        job_system_queue_job(jobSystem, job);
+        // Queued job now counts as pending in place of the continuation, released after so the count can't touch zero in between
+        ska_atomic_fetch_sub(&jobSystem->pendingJobCount, 1, SkaMemoryOrder_ACQ_REL);
+        continuation = nextContinuation;
+    }
+}
+
+static void job_counter_signal(SkaJobCounter* counter) {
+    ska_atomic_fetch_add(&counter->signalingCount, 1, SkaMemoryOrder_SEQ_CST);
+    if (ska_atomic_fetch_sub(&counter->value, 1, SkaMemoryOrder_SEQ_CST) == 1) {
+        job_counter_queue_continuations(counter);
+    }
+    ska_atomic_fetch_sub(&counter->signalingCount, 1, SkaMemoryOrder_SEQ_CST);
+}
+
+static void job_counter_add_continuation(SkaJobCounter* counter, JobContinuation* continuation) {
+    continuation->next = ska_atomic_load(&counter->continuations, SkaMemoryOrder_SEQ_CST);
+    while (!ska_atomic_compare_exchange_weak(&counter->continuations, &continuation->next, continuation, SkaMemoryOrder_SEQ_CST, SkaMemoryOrder_SEQ_CST)) {}
+    // Counter may have reached zero before the continuation was added
+    if (ska_atomic_load(&counter->value, SkaMemoryOrder_SEQ_CST) == 0) {
+        job_counter_queue_continuations(counter);
+    }
+}
+
+// Worker of the current thread, NULL for threads that aren't job system workers
+static SKA_JOB_THREAD_LOCAL JobWorker* currentWorker = NULL;
+
+static uint32 job_worker_next_random(JobWorker* worker) {
+    // xorshift32
+    uint32 value = worker->randomState;
+    value ^= value << 13;
+    value ^= value >> 17;
+    value ^= value << 5;
+    worker->randomState = value;
+    return value;
+}
+
+static usize job_system_get_lowest_bit_index(uint64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (usize)__builtin_ctzll(value);
+#else
+    usize index = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+static void job_system_notify_worker(JobWorker* worker) {
+    ska_thread_event_set(&worker->parkEvent);
+}
+
+// Wakes a single parked worker (if any)
+static void job_system_wake_one_worker(SkaJobSystem* jobSystem) {
+    // Pairs with the parking worker announcing itself before checking for jobs a final time
+    ska_atomic_thread_fence(SkaMemoryOrder_SEQ_CST);
+    uint64 parkedMask = ska_atomic_load(&jobSystem->parkedWorkerMask, SkaMemoryOrder_RELAXED);
+    while (parkedMask != 0) {
+        const uint64 workerBit = parkedMask & (~parkedMask + 1);
+        if (ska_atomic_compare_exchange_weak(&jobSystem->parkedWorkerMask, &parkedMask, parkedMask & ~workerBit, SkaMemoryOrder_SEQ_CST, SkaMemoryOrder_SEQ_CST)) {
+            job_system_notify_worker(&jobSystem->workers[job_system_get_lowest_bit_index(workerBit)]);
+            return;
+        }
+    }
+}
+
+static bool job_system_has_queued_jobs(SkaJobSystem* jobSystem) {
+    if (!ska_mpmc_ring_buffer_JobSystemJob_is_empty(&jobSystem->injectionQueue)) {
+        return true;
+    }
+    for (usize i = 0; i < jobSystem->workerCount; i++) {
+        if (!job_deque_is_empty(&jobSystem->workers[i].deque)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool job_system_steal_job(SkaJobSystem* jobSystem, JobWorker* thief, JobSystemJob* outJob) {
+    const usize startIndex = thief ? (usize)job_worker_next_random(thief) % jobSystem->workerCount : 0;
+    for (usize i = 0; i < jobSystem->workerCount; i++) {
+        JobWorker* victim = &jobSystem->workers[(startIndex + i) % jobSystem->workerCount];
+        if (victim == thief) {
+            continue;
+        }
+        JobDequeStealResult result;
+        do {
+            result = job_deque_steal(&victim->deque, outJob);
+        } while (result == JobDequeStealResult_ABORT);
+        if (thief && ska_atomic_load(&jobSystem->isStatsEnabled, SkaMemoryOrder_RELAXED)) {
+            job_stats_add(&thief->stats.stealAttempts, 1);
+            job_stats_add(&thief->stats.steals, result == JobDequeStealResult_SUCCESS ? 1 : 0);
+        }
+        if (result == JobDequeStealResult_SUCCESS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Looks for a job in the worker's own deque first, then the injection queue and finally steals from other workers
+static bool job_system_find_job(SkaJobSystem* jobSystem, JobWorker* worker, JobSystemJob* outJob) {
+    if (worker && job_deque_pop(&worker->deque, outJob)) {
+        return true;
+    }
+    if (ska_mpmc_ring_buffer_JobSystemJob_try_pop(&jobSystem->injectionQueue, outJob)) {
+        return true;
+    }
+    return job_system_steal_job(jobSystem, worker, outJob);
+}
+
+static void job_system_run_job_with_stats(SkaJobSystem* jobSystem, JobSystemJob job) {
+    JobWorkerStats* stats = currentWorker != NULL && currentWorker->jobSystem == jobSystem ? &currentWorker->stats : &jobSystem->externalStats;
+    const uint64 startTime = job_stats_get_time_ns();
+    // Jobs queued before stats were enabled don't have a queue time
+    if (job.queueTime != 0) {
+        const uint64 latency = startTime > job.queueTime ? startTime - job.queueTime : 0;
+        job_stats_add(&stats->latencyHistogram[job_stats_get_histogram_bucket(latency)], 1);
+    }
+    job.func(job.arg);
+    const uint64 runTime = job_stats_get_time_ns() - startTime;
+    job_stats_add(&stats->runTimeHistogram[job_stats_get_histogram_bucket(runTime)], 1);
+    job_stats_add(&stats->busyTime, runTime);
+    job_stats_add(&stats->jobsRun, 1);
+}
+
+static void job_system_run_job(SkaJobSystem* jobSystem, JobSystemJob job) {
+    if (ska_atomic_load(&jobSystem->isStatsEnabled, SkaMemoryOrder_RELAXED)) {
+        job_system_run_job_with_stats(jobSystem, job);
+    } else {
+        job.func(job.arg);
+    }
+    if (job.counter) {
+        job_counter_signal(job.counter);
+    }
+    ska_atomic_fetch_sub(&jobSystem->pendingJobCount, 1, SkaMemoryOrder_ACQ_REL);
+}
+
+static void job_worker_park(JobWorker* worker) {
+    SkaJobSystem* jobSystem = worker->jobSystem;
+    const uint64 workerBit = (uint64)1 << worker->index;
+    ska_atomic_fetch_or(&jobSystem->parkedWorkerMask, workerBit, SkaMemoryOrder_SEQ_CST);
+    // Check again after announcing so a job submitted right before isn't missed
+    if (job_system_has_queued_jobs(jobSystem) || ska_atomic_load(&jobSystem->shouldStop, SkaMemoryOrder_SEQ_CST)) {
+        ska_atomic_fetch_and(&jobSystem->parkedWorkerMask, ~workerBit, SkaMemoryOrder_SEQ_CST);
+        return;
+    }
+    // A notification left over from before the worker went looking for jobs only causes an extra wake up
+    ska_thread_event_wait(&worker->parkEvent);
+}
+
+static void* job_worker_thread(void* arg) {
+    JobWorker* worker = (JobWorker*)arg;
+    SkaJobSystem* jobSystem = worker->jobSystem;
+    currentWorker = worker;
+    usize idleCount = 0;
+    uint64 idleStartTime = 0;
+    while (!ska_atomic_load(&jobSystem->shouldStop, SkaMemoryOrder_ACQUIRE)) {
+        JobSystemJob job;
+        if (job_system_find_job(jobSystem, worker, &job)) {
+            if (idleStartTime != 0) {
+                job_stats_add(&worker->stats.idleTime, job_stats_get_time_ns() - idleStartTime);
+                idleStartTime = 0;
+            }
+            job_system_run_job(jobSystem, job);
+            idleCount = 0;
+            continue;
+        }
+        if (idleStartTime == 0 && ska_atomic_load(&jobSystem->isStatsEnabled, SkaMemoryOrder_RELAXED)) {
+            idleStartTime = job_stats_get_time_ns();
+        }
+        if (++idleCount < SKA_JOB_WORKER_SPIN_COUNT) {
+            pcthread_yield();
+        } else {
+            job_worker_park(worker);
+            idleCount = 0;
+        }
+    }
+    currentWorker = NULL;
+    return NULL;
+}
+
+SkaJobSystem* ska_job_system_create(usize workerCount) {
+    return ska_job_system_create_with_config(&(SkaJobSystemConfig){
+        .workerCount = workerCount,
+        .reservedCoreCount = SKA_JOB_SYSTEM_DEFAULT_RESERVED_CORE_COUNT,
+        .pinWorkers = false
+    });
+}
+
+SkaJobSystem* ska_job_system_create_with_config(const SkaJobSystemConfig* config) {
+    SkaCpuTopology topology;
+    ska_cpu_topology_query(&topology);
+    uint32 cpuOrder[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    usize reservedCpuCount = 0;
+    const usize cpuCount = ska_cpu_topology_get_reserved_spread_order(&topology, config->reservedCoreCount, cpuOrder, SKA_CPU_TOPOLOGY_MAX_CPUS, &reservedCpuCount);
+    usize workerCount = config->workerCount;
+    if (workerCount == 0) {
+        workerCount = cpuCount > reservedCpuCount ? cpuCount - reservedCpuCount : 1;
+        workerCount = workerCount < SKA_JOB_SYSTEM_MAX_WORKERS ? workerCount : SKA_JOB_SYSTEM_MAX_WORKERS;
+    }
+    SKA_ASSERT_FMT(workerCount <= SKA_JOB_SYSTEM_MAX_WORKERS, "Job system worker count '%zu' is over the max of '%d'", workerCount, SKA_JOB_SYSTEM_MAX_WORKERS);
+    SkaJobSystem* jobSystem = SKA_ALLOC_ZEROED(SkaJobSystem);
+    ska_mpmc_ring_buffer_JobSystemJob_initialize(&jobSystem->injectionQueue, SKA_JOB_INJECTION_QUEUE_CAPACITY);
+    ska_atomic_init(&jobSystem->parkedWorkerMask, 0);
+    ska_atomic_init(&jobSystem->pendingJobCount, 0);
+    ska_atomic_init(&jobSystem->shouldStop, false);
+    ska_atomic_init(&jobSystem->isStatsEnabled, false);
+    jobSystem->counters = (SkaJobCounter*)SKA_ALLOC_BYTES_ZEROED(SKA_JOB_SYSTEM_MAX_COUNTERS * sizeof(SkaJobCounter));
+    job_pool_free_list_initialize(&jobSystem->counterFreeList, SKA_JOB_SYSTEM_MAX_COUNTERS);
+    jobSystem->continuations = (JobContinuation*)SKA_ALLOC_BYTES_ZEROED(SKA_JOB_SYSTEM_MAX_CONTINUATIONS * sizeof(JobContinuation));
+    job_pool_free_list_initialize(&jobSystem->continuationFreeList, SKA_JOB_SYSTEM_MAX_CONTINUATIONS);
+    jobSystem->coroutines = (JobCoroutine*)SKA_ALLOC_BYTES_ZEROED(SKA_JOB_SYSTEM_MAX_COROUTINES * sizeof(JobCoroutine));
+    job_pool_free_list_initialize(&jobSystem->coroutineFreeList, SKA_JOB_SYSTEM_MAX_COROUTINES);
+    jobSystem->workerCount = workerCount;
+    jobSystem->reservedCpuCount = reservedCpuCount;
+    memcpy(jobSystem->reservedCpuIds, cpuOrder, reservedCpuCount * sizeof(uint32));
+    jobSystem->workers = (JobWorker*)SKA_ALLOC_BYTES_ZEROED(workerCount * sizeof(JobWorker));
+    for (usize i = 0; i < workerCount; i++) {
+        JobWorker* worker = &jobSystem->workers[i];
+        job_deque_initialize(&worker->deque);
+        worker->jobSystem = jobSystem;
+        worker->index = i;
+        worker->randomState = (uint32)(i * 2654435761u) | 1;
+        ska_thread_event_initialize(&worker->parkEvent);
+        worker->cpuId = -1;
+    }
+    // Start threads once all workers are initialized since they steal from each other
+    for (usize i = 0; i < workerCount; i++) {
+        JobWorker* worker = &jobSystem->workers[i];
+        pthread_create(&worker->thread, NULL, job_worker_thread, worker);
+        if (config->pinWorkers) {
+            // Workers share the unreserved cpus, or all cpus if every cpu is reserved
+            const usize workerCpuCount = cpuCount > reservedCpuCount ? cpuCount - reservedCpuCount : cpuCount;
+            const uint32 cpuId = cpuOrder[(cpuCount - workerCpuCount) + i % workerCpuCount];
+            if (ska_cpu_pin_thread(worker->thread, cpuId)) {
+                worker->cpuId = (int32)cpuId;
+            }
+        }
+    }
+    return jobSystem;
+}
+
+void ska_job_system_destroy(SkaJobSystem* jobSystem) {
+    if (jobSystem == NULL) {
+        return;
+    }
+    ska_job_system_wait_idle(jobSystem);
+    ska_atomic_store(&jobSystem->shouldStop, true, SkaMemoryOrder_SEQ_CST);
+    for (usize i = 0; i < jobSystem->workerCount; i++) {
+        job_system_notify_worker(&jobSystem->workers[i]);
+    }
+    for (usize i = 0; i < jobSystem->workerCount; i++) {
+        JobWorker* worker = &jobSystem->workers[i];
+        pthread_join(worker->thread, NULL);
+        ska_thread_event_finalize(&worker->parkEvent);
+        job_deque_finalize(&worker->deque);
+    }
+    ska_mpmc_ring_buffer_JobSystemJob_finalize(&jobSystem->injectionQueue);
+    job_pool_free_list_finalize(&jobSystem->counterFreeList);
+    SKA_FREE(jobSystem->counters);
+    job_pool_free_list_finalize(&jobSystem->continuationFreeList);
+    SKA_FREE(jobSystem->continuations);
+    job_pool_free_list_finalize(&jobSystem->coroutineFreeList);
+    SKA_FREE(jobSystem->coroutines);
+    SKA_FREE(jobSystem->workers);
+    SKA_FREE(jobSystem);
+}
+
+// Stamps the queue time and samples the depth of the queue the job is about to go in
+static void job_system_record_queue_stats(SkaJobSystem* jobSystem, JobWorker* worker, JobSystemJob* job) {
+    job->queueTime = job_stats_get_time_ns();
+    if (worker) {
+        job_stats_update_peak(&worker->stats.peakQueueDepth, job_deque_get_depth(&worker->deque) + 1);
+    } else {
+        job_stats_update_peak(&jobSystem->peakInjectionQueueDepth, ska_mpmc_ring_buffer_JobSystemJob_get_size(&jobSystem->injectionQueue) + 1);
+    }
+}
+
+static void job_system_queue_job(SkaJobSystem* jobSystem, JobSystemJob job) {
+    ska_atomic_fetch_add(&jobSystem->pendingJobCount, 1, SkaMemoryOrder_RELAXED);
+    JobWorker* worker = currentWorker != NULL && currentWorker->jobSystem == jobSystem ? currentWorker : NULL;
+    if (ska_atomic_load(&jobSystem->isStatsEnabled, SkaMemoryOrder_RELAXED)) {
+        job_system_record_queue_stats(jobSystem, worker, &job);
+    }
+    const bool wasQueued = worker ? job_deque_push(&worker->deque, job) || ska_mpmc_ring_buffer_JobSystemJob_try_push(&jobSystem->injectionQueue, job)
+                                  : ska_mpmc_ring_buffer_JobSystemJob_try_push(&jobSystem->injectionQueue, job);
+    if (!wasQueued) {
+        // Queues are full, running it now also throttles the submitting thread
+        job_system_run_job(jobSystem, job);
+        return;
+    }
+    job_system_wake_one_worker(jobSystem);
+}
+
+// Queues behind jobs that are already queued instead of at the front of the worker's own deque
+static void job_system_queue_job_at_back(SkaJobSystem* jobSystem, JobSystemJob job) {
+    ska_atomic_fetch_add(&jobSystem->pendingJobCount, 1, SkaMemoryOrder_RELAXED);
+    if (ska_atomic_load(&jobSystem->isStatsEnabled, SkaMemoryOrder_RELAXED)) {
+        job_system_record_queue_stats(jobSystem, NULL, &job);
+    }
+    if (!ska_mpmc_ring_buffer_JobSystemJob_try_push(&jobSystem->injectionQueue, job)) {
+        ska_atomic_fetch_sub(&jobSystem->pendingJobCount, 1, SkaMemoryOrder_RELAXED);
+        job_system_queue_job(jobSystem, job);
+        return;
+    }
+    job_system_wake_one_worker(jobSystem);
+}
+
+bool ska_job_system_submit(SkaJobSystem* jobSystem, SkaJobFunc func, void* arg) {
+    return ska_job_system_submit_with_counter(jobSystem, func, arg, NULL);
+}
+
+bool ska_job_system_submit_with_counter(SkaJobSystem* jobSystem, SkaJobFunc func, void* arg, SkaJobCounter* counter) {
+    if (jobSystem == NULL || func == NULL) {
+        return false;
+    }
+    if (counter) {
+        ska_atomic_fetch_add(&counter->value, 1, SkaMemoryOrder_SEQ_CST);
+    }
+    job_system_queue_job(jobSystem, (JobSystemJob){ .func = func, .arg = arg, .counter = counter });
+    return true;
+}
+
+bool ska_job_system_submit_after(SkaJobSystem* jobSystem, SkaJobFunc func, void* arg, SkaJobCounter* dependency, SkaJobCounter* counter) {
+    if (dependency == NULL) {
+        return ska_job_system_submit_with_counter(jobSystem, func, arg, counter);
+    }
+    if (jobSystem == NULL || func == NULL) {
+        return false;
+    }
+    const uint32 continuationIndex = job_pool_free_list_pop(&jobSystem->continuationFreeList);
+    if (continuationIndex == SKA_JOB_POOL_INVALID_INDEX) {
+        SKA_ASSERT_FMT(false, "Job system is out of continuations, max is '%d'", SKA_JOB_SYSTEM_MAX_CONTINUATIONS);
+        return false;
+    }
+    if (counter) {
+        ska_atomic_fetch_add(&counter->value, 1, SkaMemoryOrder_SEQ_CST);
+    }
+    JobContinuation* continuation = &jobSystem->continuations[continuationIndex];
+    continuation->job = (JobSystemJob){ .func = func, .arg = arg, .counter = counter };
+    // Pending until it has run so waiting for idle (and destroy) doesn't return while it is still parked on 'dependency'
+    ska_atomic_fetch_add(&jobSystem->pendingJobCount, 1, SkaMemoryOrder_RELAXED);
+    job_counter_add_continuation(dependency, continuation);
+    return true;
+}
+
+static void job_coroutine_resume(void* arg) {
+    JobCoroutine* coroutine = (JobCoroutine*)arg;
+    SkaJobSystem* jobSystem = coroutine->jobSystem;
+    const JobSystemJob resumeJob = { .func = job_coroutine_resume, .arg = coroutine, .counter = NULL };
+    switch (coroutine->func(&coroutine->coroutine, coroutine->arg)) {
+        case SkaJobCoroutineResult_YIELD: {
+            job_system_queue_job_at_back(jobSystem, resumeJob);
+            break;
+        }
+        case SkaJobCoroutineResult_AWAIT: {
+            SkaJobCounter* awaitCounter = coroutine->coroutine.awaitCounter;
+            coroutine->coroutine.awaitCounter = NULL;
+            if (!ska_job_system_submit_after(jobSystem, job_coroutine_resume, coroutine, awaitCounter, NULL)) {
+                // Out of continuations, wait here while helping run other jobs instead of losing the coroutine
+                ska_job_system_wait_for_counter(jobSystem, awaitCounter);
+                job_system_queue_job_at_back(jobSystem, resumeJob);
+            }
+            break;
+        }
+        case SkaJobCoroutineResult_DONE: {
+            SkaJobCounter* counter = coroutine->counter;
+            job_pool_free_list_push(&jobSystem->coroutineFreeList, (uint32)(coroutine - jobSystem->coroutines));
+            if (counter) {
+                job_counter_signal(counter);
+            }
+            break;
+        }
+    }
+}
+
+bool ska_job_system_submit_coroutine(SkaJobSystem* jobSystem, SkaJobCoroutineFunc func, void* arg, SkaJobCounter* counter) {
+    if (jobSystem == NULL || func == NULL) {
+        return false;
+    }
+    const uint32 coroutineIndex = job_pool_free_list_pop(&jobSystem->coroutineFreeList);
+    if (coroutineIndex == SKA_JOB_POOL_INVALID_INDEX) {
+        SKA_ASSERT_FMT(false, "Job system is out of coroutines, max is '%d'", SKA_JOB_SYSTEM_MAX_COROUTINES);
+        return false;
+    }
+    JobCoroutine* coroutine = &jobSystem->coroutines[coroutineIndex];
+    *coroutine = (JobCoroutine){ .coroutine = { .resumePoint = 0, .awaitCounter = NULL }, .func = func, .arg = arg, .counter = counter, .jobSystem = jobSystem };
+    if (counter) {
+        ska_atomic_fetch_add(&counter->value, 1, SkaMemoryOrder_SEQ_CST);
+    }
+    job_system_queue_job(jobSystem, (JobSystemJob){ .func = job_coroutine_resume, .arg = coroutine, .counter = NULL });
+    return true;
+}
+
+void ska_job_system_wait_for_counter(SkaJobSystem* jobSystem, SkaJobCounter* counter) {
+    while (!ska_job_counter_is_done(counter)) {
+        if (!ska_job_system_run_pending_job(jobSystem)) {
+            pcthread_yield();
+        }
+    }
+}
+
+bool ska_job_system_run_pending_job(SkaJobSystem* jobSystem) {
+    JobWorker* worker = currentWorker != NULL && currentWorker->jobSystem == jobSystem ? currentWorker : NULL;
+    JobSystemJob job;
+    if (job_system_find_job(jobSystem, worker, &job)) {
+        job_system_run_job(jobSystem, job);
+        return true;
+    }
+    return false;
+}
+
+void ska_job_system_wait_idle(SkaJobSystem* jobSystem) {
+    if (jobSystem == NULL) {
+        return;
+    }
+    while (ska_atomic_load(&jobSystem->pendingJobCount, SkaMemoryOrder_ACQUIRE) > 0) {
+        if (!ska_job_system_run_pending_job(jobSystem)) {
+            pcthread_yield();
+        }
+    }
+}
+
+usize ska_job_system_get_worker_count(const SkaJobSystem* jobSystem) {
+    return jobSystem->workerCount;
+}
+
+int32 ska_job_system_get_worker_cpu(const SkaJobSystem* jobSystem, usize workerIndex) {
+    SKA_ASSERT_FMT(workerIndex < jobSystem->workerCount, "Invalid worker index '%zu'", workerIndex);
+    return jobSystem->workers[workerIndex].cpuId;
+}
+
+usize ska_job_system_get_reserved_cpus(const SkaJobSystem* jobSystem, uint32* outCpuIds, usize capacity) {
+    const usize count = jobSystem->reservedCpuCount < capacity ? jobSystem->reservedCpuCount : capacity;
+    memcpy(outCpuIds, jobSystem->reservedCpuIds, count * sizeof(uint32));
+    return count;
+}
+
+usize ska_job_system_get_pending_job_count(const SkaJobSystem* jobSystem) {
+    return ska_atomic_load(&((SkaJobSystem*)jobSystem)->pendingJobCount, SkaMemoryOrder_RELAXED);
+}
+
+SkaJobCounter* ska_job_counter_create(SkaJobSystem* jobSystem) {
+    const uint32 counterIndex = job_pool_free_list_pop(&jobSystem->counterFreeList);
+    if (counterIndex == SKA_JOB_POOL_INVALID_INDEX) {
+        SKA_ASSERT_FMT(false, "Job system is out of counters, max is '%d'", SKA_JOB_SYSTEM_MAX_COUNTERS);
+        return NULL;
+    }
+    SkaJobCounter* counter = &jobSystem->counters[counterIndex];
+    counter->jobSystem = jobSystem;
+    ska_atomic_store(&counter->value, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&counter->signalingCount, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&counter->continuations, NULL, SkaMemoryOrder_SEQ_CST);
+    return counter;
+}
+
+void ska_job_counter_destroy(SkaJobCounter* counter) {
+    SKA_ASSERT_FMT(ska_job_counter_is_done(counter) && ska_atomic_load(&counter->continuations, SkaMemoryOrder_SEQ_CST) == NULL, "Destroying job counter that still has pending jobs!");
+    SkaJobSystem* jobSystem = counter->jobSystem;
+    job_pool_free_list_push(&jobSystem->counterFreeList, (uint32)(counter - jobSystem->counters));
+}
+
+bool ska_job_counter_is_done(const SkaJobCounter* counter) {
+    SkaJobCounter* mutableCounter = (SkaJobCounter*)counter;
+    // Value is checked first, a signaling thread increments 'signalingCount' before decrementing the value
+    return ska_atomic_load(&mutableCounter->value, SkaMemoryOrder_SEQ_CST) == 0 && ska_atomic_load(&mutableCounter->signalingCount, SkaMemoryOrder_SEQ_CST) == 0;
+}
+
+usize ska_job_counter_get_value(const SkaJobCounter* counter) {
+    return ska_atomic_load(&((SkaJobCounter*)counter)->value, SkaMemoryOrder_SEQ_CST);
+}
+
+void ska_job_counter_add(SkaJobCounter* counter, usize amount) {
+    ska_atomic_fetch_add(&counter->value, amount, SkaMemoryOrder_SEQ_CST);
+}
+
+void ska_job_counter_signal(SkaJobCounter* counter) {
+    job_counter_signal(counter);
+}
+
+#undef SKA_JOB_THREAD_LOCAL
+
+// --- Stats --- //
+void ska_job_system_set_stats_enabled(SkaJobSystem* jobSystem, bool isEnabled) {
+    ska_atomic_store(&jobSystem->isStatsEnabled, isEnabled, SkaMemoryOrder_SEQ_CST);
+}
+
+bool ska_job_system_is_stats_enabled(const SkaJobSystem* jobSystem) {
+    return ska_atomic_load(&((SkaJobSystem*)jobSystem)->isStatsEnabled, SkaMemoryOrder_SEQ_CST);
+}
+
+void ska_job_system_get_stats(const SkaJobSystem* jobSystem, SkaJobSystemStats* outStats) {
+    SkaJobSystem* mutableJobSystem = (SkaJobSystem*)jobSystem;
+    *outStats = (SkaJobSystemStats){0};
+    outStats->workerCount = jobSystem->workerCount;
+    for (usize i = 0; i < jobSystem->workerCount; i++) {
+        JobWorker* worker = &mutableJobSystem->workers[i];
+        job_stats_read(&worker->stats, &outStats->workers[i], outStats->latencyHistogram, outStats->runTimeHistogram);
+        outStats->workers[i].queueDepth = job_deque_get_depth(&worker->deque);
+    }
+    job_stats_read(&jobSystem->externalStats, &outStats->external, outStats->latencyHistogram, outStats->runTimeHistogram);
+    outStats->external.queueDepth = ska_mpmc_ring_buffer_JobSystemJob_get_size(&mutableJobSystem->injectionQueue);
+    outStats->external.peakQueueDepth = ska_atomic_load(&mutableJobSystem->peakInjectionQueueDepth, SkaMemoryOrder_SEQ_CST);
+    outStats->pendingJobCount = ska_job_system_get_pending_job_count(jobSystem);
+}
+
+void ska_job_system_reset_stats(SkaJobSystem* jobSystem) {
+    for (usize i = 0; i < jobSystem->workerCount; i++) {
+        job_stats_reset(&jobSystem->workers[i].stats);
+    }
+    job_stats_reset(&jobSystem->externalStats);
+    ska_atomic_store(&jobSystem->peakInjectionQueueDepth, 0, SkaMemoryOrder_SEQ_CST);
+}
+
+uint64 ska_job_stats_get_histogram_percentile(const uint64* histogram, f32 percentile) {
+    uint64 totalCount = 0;
+    for (usize i = 0; i < SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT; i++) {
+        totalCount += histogram[i];
+    }
+    if (totalCount == 0) {
+        return 0;
+    }
+    const uint64 targetCount = (uint64)((f64)totalCount * (f64)percentile);
+    uint64 count = 0;
+    for (usize i = 0; i < SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT; i++) {
+        count += histogram[i];
+        if (count > targetCount || count == totalCount) {
+            return (uint64)1 << (i + 1);
+        }
+    }
+    return (uint64)1 << SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT;
+}
+
+void ska_job_system_log_stats(const SkaJobSystem* jobSystem) {
+    SkaJobSystemStats stats;
+    ska_job_system_get_stats(jobSystem, &stats);
+    ska_logger_info("[job system] pending = %zu, injection queue depth = %zu (peak %zu), latency p50 = %llu ns, p99 = %llu ns, run time p50 = %llu ns, p99 = %llu ns",
+        stats.pendingJobCount, stats.external.queueDepth, stats.external.peakQueueDepth,
+        (unsigned long long)ska_job_stats_get_histogram_percentile(stats.latencyHistogram, 0.5f),
+        (unsigned long long)ska_job_stats_get_histogram_percentile(stats.latencyHistogram, 0.99f),
+        (unsigned long long)ska_job_stats_get_histogram_percentile(stats.runTimeHistogram, 0.5f),
+        (unsigned long long)ska_job_stats_get_histogram_percentile(stats.runTimeHistogram, 0.99f));
+    for (usize i = 0; i < stats.workerCount; i++) {
+        const SkaJobWorkerStats* workerStats = &stats.workers[i];
+        const uint64 totalTime = workerStats->busyTimeNs + workerStats->idleTimeNs;
+        const f64 utilization = totalTime > 0 ? (f64)workerStats->busyTimeNs / (f64)totalTime * 100.0 : 0.0;
+        ska_logger_info("[job system] worker %zu: jobs = %llu, utilization = %.1f%%, steals = %llu/%llu, queue depth = %zu (peak %zu)",
+            i, (unsigned long long)workerStats->jobsRun, utilization, (unsigned long long)workerStats->steals,
+            (unsigned long long)workerStats->stealAttempts, workerStats->queueDepth, workerStats->peakQueueDepth);
+    }
+    ska_logger_info("[job system] external: jobs = %llu", (unsigned long long)stats.external.jobsRun);
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/thread/cpu_topology.h"
+
+#define SKA_JOB_SYSTEM_MAX_WORKERS 64
+// Physical cores left for the main thread when the worker count is sized automatically
+#define SKA_JOB_SYSTEM_DEFAULT_RESERVED_CORE_COUNT 1
+// Bucket 'i' of a stats histogram counts durations in [2^i, 2^(i + 1)) nanoseconds, the last bucket also counts anything longer
+#define SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT 32
+
+typedef void (*SkaJobFunc)(void* arg);
+
+// Work stealing job scheduler.  Each worker owns a deque it pushes to and pops from (LIFO), idle workers steal from the
+// other end of other workers' deques (FIFO).  Jobs submitted from outside of the workers go through a lock free
+// injection queue.  Idle workers park individually and only one is woken per submitted job.
+typedef struct SkaJobSystem SkaJobSystem;
+
+// Counts unfinished jobs that were submitted with it and acts as the handle for a group of jobs.  Jobs can be submitted to
+// run only once a counter reaches zero ('ska_job_system_submit_after'), e.g. "run B after A and C" is A and C signaling
+// the same counter that B depends on.  Counters can be reused once they reach zero.
+typedef struct SkaJobCounter SkaJobCounter;
+
+typedef struct SkaJobSystemConfig {
+    usize workerCount; // 0 sizes to the available cpus minus the reserved ones (at least 1 worker)
+    // Physical cores no worker is pinned to, for the main thread and latency sensitive threads (audio, network).  All SMT
+    // siblings of a reserved core are reserved with it so workers don't compete with the reserved threads for the core.
+    usize reservedCoreCount;
+    bool pinWorkers; // Pins each worker to a cpu, spread over physical cores before using SMT siblings
+} SkaJobSystemConfig;
+
+// Creates job system with 'workerCount' worker threads, 0 sizes to the available cpus minus the cpus of 'SKA_JOB_SYSTEM_DEFAULT_RESERVED_CORE_COUNT' cores
+SkaJobSystem* ska_job_system_create(usize workerCount);
+SkaJobSystem* ska_job_system_create_with_config(const SkaJobSystemConfig* config);
+// Finishes all pending jobs before stopping the workers, including jobs and coroutines still waiting on a counter
+void ska_job_system_destroy(SkaJobSystem* jobSystem);
+// Queues a job, jobs submitted from a worker go to that worker's deque.  If the queue is full the job is run immediately.
+bool ska_job_system_submit(SkaJobSystem* jobSystem, SkaJobFunc func, void* arg);
+// Same as 'ska_job_system_submit' but 'counter' (can be NULL) is incremented now and decremented once the job finishes
+bool ska_job_system_submit_with_counter(SkaJobSystem* jobSystem, SkaJobFunc func, void* arg, SkaJobCounter* counter);
+// Queues the job once 'dependency' reaches zero (immediately if it already is), 'counter' is incremented now.
+// Returns false without submitting if all 'SKA_JOB_SYSTEM_MAX_CONTINUATIONS' continuations are in use.
+bool ska_job_system_submit_after(SkaJobSystem* jobSystem, SkaJobFunc func, void* arg, SkaJobCounter* dependency, SkaJobCounter* counter);
+// Blocks until 'counter' reaches zero, the calling thread helps run jobs while waiting.  Can be called from within a job.
+void ska_job_system_wait_for_counter(SkaJobSystem* jobSystem, SkaJobCounter* counter);
+// Runs a single pending job on the calling thread, returns false if no job was found
+bool ska_job_system_run_pending_job(SkaJobSystem* jobSystem);
+// Blocks until there are no pending jobs, the calling thread helps run jobs while waiting.  Shouldn't be called from within a job.
+// Jobs submitted with 'ska_job_system_submit_after' and awaiting coroutines are pending until they run, so their dependency must get signaled.
+void ska_job_system_wait_idle(SkaJobSystem* jobSystem);
+usize ska_job_system_get_worker_count(const SkaJobSystem* jobSystem);
+usize ska_job_system_get_pending_job_count(const SkaJobSystem* jobSystem);
+// Cpu id the worker is pinned to, -1 if it isn't pinned
+int32 ska_job_system_get_worker_cpu(const SkaJobSystem* jobSystem, usize workerIndex);
+// Cpus kept free of workers, dedicated threads can be pinned to them with 'ska_cpu_pin_current_thread'.  Returns the amount written.
+usize ska_job_system_get_reserved_cpus(const SkaJobSystem* jobSystem, uint32* outCpuIds, usize capacity);
+
+// Counters come from a fixed size pool owned by the job system and can be created and destroyed from any thread.
+// Returns NULL if all 'SKA_JOB_SYSTEM_MAX_COUNTERS' counters are in use.
+SkaJobCounter* ska_job_counter_create(SkaJobSystem* jobSystem);
+// Counter must not have pending jobs or continuations
+void ska_job_counter_destroy(SkaJobCounter* counter);
+bool ska_job_counter_is_done(const SkaJobCounter* counter);
+usize ska_job_counter_get_value(const SkaJobCounter* counter);
+// Manually adds pending work to a counter, e.g. to represent an I/O request another thread completes with 'ska_job_counter_signal'
+void ska_job_counter_add(SkaJobCounter* counter, usize amount);
+void ska_job_counter_signal(SkaJobCounter* counter);
+
+// --- Coroutine Jobs --- //
+// Stackless coroutines that run as jobs and can give up their worker mid task, either to let other jobs run (yield) or
+// until a counter reaches zero (await).  Locals are not preserved across yields, keep state in 'arg'.
+//
+// static SkaJobCoroutineResult load_job(SkaJobCoroutine* co, void* arg) {
+//     LoadState* state = (LoadState*)arg;
+//     SKA_JOB_COROUTINE_BEGIN(co);
+//     ska_job_system_submit_with_counter(jobSystem, decode_chunk, state, state->decodeCounter);
+//     SKA_JOB_COROUTINE_AWAIT(co, state->decodeCounter);
+//     SKA_JOB_COROUTINE_END(co);
+// }
+
+typedef enum SkaJobCoroutineResult {
+    SkaJobCoroutineResult_DONE,
+    SkaJobCoroutineResult_YIELD,
+    SkaJobCoroutineResult_AWAIT,
+} SkaJobCoroutineResult;
+
+typedef struct SkaJobCoroutine {
+    int32 resumePoint;
+    SkaJobCounter* awaitCounter;
+} SkaJobCoroutine;
+
+typedef SkaJobCoroutineResult (*SkaJobCoroutineFunc)(SkaJobCoroutine* coroutine, void* arg);
+
+#define SKA_JOB_COROUTINE_BEGIN(CO) switch ((CO)->resumePoint) { case 0:
+
+// Queues the coroutine behind already queued jobs and returns
+#define SKA_JOB_COROUTINE_YIELD(CO) \
+do { (CO)->resumePoint = __LINE__; return SkaJobCoroutineResult_YIELD; case __LINE__:; } while (false)
+
+// Resumes once 'COUNTER' reaches zero, the worker is free to run other jobs in the meantime
+#define SKA_JOB_COROUTINE_AWAIT(CO, COUNTER) \
+do { (CO)->awaitCounter = (COUNTER); (CO)->resumePoint = __LINE__; return SkaJobCoroutineResult_AWAIT; case __LINE__:; } while (false)
+
+#define SKA_JOB_COROUTINE_END(CO) } (CO)->resumePoint = -1; return SkaJobCoroutineResult_DONE
+
+// Starts a coroutine job, 'counter' (can be NULL) is incremented now and decremented once the coroutine is done.
+// Returns false without submitting if all 'SKA_JOB_SYSTEM_MAX_COROUTINES' coroutines are in use.
+bool ska_job_system_submit_coroutine(SkaJobSystem* jobSystem, SkaJobCoroutineFunc func, void* arg, SkaJobCounter* counter);
+
+// --- Stats --- //
+// Collected only while enabled, stays close to free otherwise.  Meant to be read (or logged) and reset once per frame.
+
+typedef struct SkaJobWorkerStats {
+    uint64 jobsRun;
+    uint64 busyTimeNs;
+    uint64 idleTimeNs; // Time spent looking for work or parked
+    uint64 stealAttempts;
+    uint64 steals;
+    usize queueDepth; // At the time the stats were read
+    usize peakQueueDepth;
+} SkaJobWorkerStats;
+
+typedef struct SkaJobSystemStats {
+    usize workerCount;
+    SkaJobWorkerStats workers[SKA_JOB_SYSTEM_MAX_WORKERS];
+    // Jobs run by threads that aren't workers (e.g. while waiting), queue depths are of the injection queue
+    SkaJobWorkerStats external;
+    usize pendingJobCount;
+    // Time from a job being queued (or its dependency finishing) until it starts running
+    uint64 latencyHistogram[SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT];
+    uint64 runTimeHistogram[SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT];
+} SkaJobSystemStats;
+
+void ska_job_system_set_stats_enabled(SkaJobSystem* jobSystem, bool isEnabled);
+bool ska_job_system_is_stats_enabled(const SkaJobSystem* jobSystem);
+void ska_job_system_get_stats(const SkaJobSystem* jobSystem, SkaJobSystemStats* outStats);
+void ska_job_system_reset_stats(SkaJobSystem* jobSystem);
+// Returns the upper bound (in nanoseconds) of the bucket the percentile (0.0 - 1.0) falls in, 0 for empty histograms
+uint64 ska_job_stats_get_histogram_percentile(const uint64* histogram, f32 percentile);
+// Logs a summary and a line per worker at info level
+void ska_job_system_log_stats(const SkaJobSystem* jobSystem);
+
+#ifdef __cplusplus
+}
+#endif
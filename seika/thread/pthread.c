@@ -238,12 +238,21 @@ unsigned int pcthread_get_num_procs() {
     return sysinfo.dwNumberOfProcessors;
 }
 
+void pcthread_yield() {
+    SwitchToThread();
+}
+
 #else
 
 #include <unistd.h>
+#include <sched.h>
 unsigned int pcthread_get_num_procs() {
     return (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
 }
+
+void pcthread_yield() {
+    sched_yield();
+}
 #endif
 
 void ms_to_timespec(struct timespec *ts, uint32 ms) {
@@ -58,5 +58,7 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock);
 
 // Helper functions
 unsigned int pcthread_get_num_procs();
+// Gives up the rest of the calling thread's time slice
+void pcthread_yield();
 
 void ms_to_timespec(struct timespec *ts, uint32 ms);
@@ -0,0 +1,210 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall
+#endif
+
+#include "sync.h"
+
+#if defined(PLATFORM_LINUX)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Spins before backoff maxes out and the lock starts yielding the thread
+#define SKA_SPIN_LOCK_MAX_BACKOFF 64
+
+#if defined(PLATFORM_LINUX)
+// Sleeps only if '*address' still equals 'expectedValue', spurious wake ups are possible
+static void sync_futex_wait(SKA_ATOMIC(uint32)* address, uint32 expectedValue) {
+    syscall(SYS_futex, (uint32*)address, FUTEX_WAIT_PRIVATE, expectedValue, NULL, NULL, 0);
+}
+
+static void sync_futex_wake(SKA_ATOMIC(uint32)* address, int32 wakeCount) {
+    syscall(SYS_futex, (uint32*)address, FUTEX_WAKE_PRIVATE, wakeCount, NULL, NULL, 0);
+}
+#endif
+
+// --- Spin Lock --- //
+void ska_spin_lock_initialize(SkaSpinLock* spinLock) {
+    ska_atomic_init(&spinLock->isLocked, false);
+}
+
+void ska_spin_lock_lock(SkaSpinLock* spinLock) {
+    uint32 backoff = 1;
+    while (ska_atomic_exchange(&spinLock->isLocked, true, SkaMemoryOrder_ACQUIRE)) {
+        // Wait on a plain load so the cache line isn't bounced between waiting cores
+        while (ska_atomic_load(&spinLock->isLocked, SkaMemoryOrder_RELAXED)) {
+            if (backoff < SKA_SPIN_LOCK_MAX_BACKOFF) {
+                for (uint32 i = 0; i < backoff; i++) {
+                    ska_cpu_relax();
+                }
+                backoff <<= 1;
+            } else {
+                pcthread_yield();
+            }
+        }
+    }
+}
+
+bool ska_spin_lock_try_lock(SkaSpinLock* spinLock) {
+    return !ska_atomic_load(&spinLock->isLocked, SkaMemoryOrder_RELAXED) && !ska_atomic_exchange(&spinLock->isLocked, true, SkaMemoryOrder_ACQUIRE);
+}
+
+void ska_spin_lock_unlock(SkaSpinLock* spinLock) {
+    ska_atomic_store(&spinLock->isLocked, false, SkaMemoryOrder_RELEASE);
+}
+
+// --- Thread Event --- //
+#if defined(PLATFORM_LINUX)
+typedef enum SyncThreadEventState {
+    SyncThreadEventState_UNSET = 0,
+    SyncThreadEventState_SET = 1,
+    SyncThreadEventState_WAITING = 2, // Unset with a thread sleeping on it
+} SyncThreadEventState;
+
+void ska_thread_event_initialize(SkaThreadEvent* event) {
+    ska_atomic_init(&event->state, SyncThreadEventState_UNSET);
+}
+
+void ska_thread_event_finalize(SkaThreadEvent* event) {}
+
+void ska_thread_event_set(SkaThreadEvent* event) {
+    if (ska_atomic_exchange(&event->state, SyncThreadEventState_SET, SkaMemoryOrder_RELEASE) == SyncThreadEventState_WAITING) {
+        sync_futex_wake(&event->state, 1);
+    }
+}
+
+void ska_thread_event_wait(SkaThreadEvent* event) {
+    while (true) {
+        uint32 state = SyncThreadEventState_SET;
+        if (ska_atomic_compare_exchange(&event->state, &state, SyncThreadEventState_UNSET, SkaMemoryOrder_ACQUIRE, SkaMemoryOrder_RELAXED)) {
+            return;
+        }
+        if (state == SyncThreadEventState_UNSET && !ska_atomic_compare_exchange(&event->state, &state, SyncThreadEventState_WAITING, SkaMemoryOrder_RELAXED, SkaMemoryOrder_RELAXED)) {
+            continue; // Was set in between
+        }
+        sync_futex_wait(&event->state, SyncThreadEventState_WAITING);
+    }
+}
+
+bool ska_thread_event_try_wait(SkaThreadEvent* event) {
+    uint32 state = SyncThreadEventState_SET;
+    return ska_atomic_compare_exchange(&event->state, &state, SyncThreadEventState_UNSET, SkaMemoryOrder_ACQUIRE, SkaMemoryOrder_RELAXED);
+}
+#else
+void ska_thread_event_initialize(SkaThreadEvent* event) {
+    pthread_mutex_init(&event->mutex, NULL);
+    pthread_cond_init(&event->cond, NULL);
+    event->isSet = false;
+}
+
+void ska_thread_event_finalize(SkaThreadEvent* event) {
+    pthread_mutex_destroy(&event->mutex);
+    pthread_cond_destroy(&event->cond);
+}
+
+void ska_thread_event_set(SkaThreadEvent* event) {
+    pthread_mutex_lock(&event->mutex);
+    event->isSet = true;
+    pthread_cond_signal(&event->cond);
+    pthread_mutex_unlock(&event->mutex);
+}
+
+void ska_thread_event_wait(SkaThreadEvent* event) {
+    pthread_mutex_lock(&event->mutex);
+    while (!event->isSet) {
+        pthread_cond_wait(&event->cond, &event->mutex);
+    }
+    event->isSet = false;
+    pthread_mutex_unlock(&event->mutex);
+}
+
+bool ska_thread_event_try_wait(SkaThreadEvent* event) {
+    pthread_mutex_lock(&event->mutex);
+    const bool wasSet = event->isSet;
+    event->isSet = false;
+    pthread_mutex_unlock(&event->mutex);
+    return wasSet;
+}
+#endif
+
+// --- Semaphore --- //
+#if defined(PLATFORM_LINUX)
+void ska_semaphore_initialize(SkaSemaphore* semaphore, uint32 initialCount) {
+    ska_atomic_init(&semaphore->count, initialCount);
+    ska_atomic_init(&semaphore->waiterCount, 0);
+}
+
+void ska_semaphore_finalize(SkaSemaphore* semaphore) {}
+
+void ska_semaphore_post(SkaSemaphore* semaphore, uint32 count) {
+    ska_atomic_fetch_add(&semaphore->count, count, SkaMemoryOrder_RELEASE);
+    // Pairs with the waiter registering before its final check of the count
+    ska_atomic_thread_fence(SkaMemoryOrder_SEQ_CST);
+    if (ska_atomic_load(&semaphore->waiterCount, SkaMemoryOrder_RELAXED) > 0) {
+        sync_futex_wake(&semaphore->count, count > INT_MAX ? INT_MAX : (int32)count);
+    }
+}
+
+bool ska_semaphore_try_wait(SkaSemaphore* semaphore) {
+    uint32 count = ska_atomic_load(&semaphore->count, SkaMemoryOrder_RELAXED);
+    while (count > 0) {
+        if (ska_atomic_compare_exchange_weak(&semaphore->count, &count, count - 1, SkaMemoryOrder_ACQUIRE, SkaMemoryOrder_RELAXED)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ska_semaphore_wait(SkaSemaphore* semaphore) {
+    while (!ska_semaphore_try_wait(semaphore)) {
+        ska_atomic_fetch_add(&semaphore->waiterCount, 1, SkaMemoryOrder_RELAXED);
+        ska_atomic_thread_fence(SkaMemoryOrder_SEQ_CST);
+        // Only sleeps if the count is still zero
+        sync_futex_wait(&semaphore->count, 0);
+        ska_atomic_fetch_sub(&semaphore->waiterCount, 1, SkaMemoryOrder_RELAXED);
+    }
+}
+#else
+void ska_semaphore_initialize(SkaSemaphore* semaphore, uint32 initialCount) {
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->cond, NULL);
+    semaphore->count = initialCount;
+}
+
+void ska_semaphore_finalize(SkaSemaphore* semaphore) {
+    pthread_mutex_destroy(&semaphore->mutex);
+    pthread_cond_destroy(&semaphore->cond);
+}
+
+void ska_semaphore_post(SkaSemaphore* semaphore, uint32 count) {
+    pthread_mutex_lock(&semaphore->mutex);
+    semaphore->count += count;
+    if (count == 1) {
+        pthread_cond_signal(&semaphore->cond);
+    } else {
+        pthread_cond_broadcast(&semaphore->cond);
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+}
+
+bool ska_semaphore_try_wait(SkaSemaphore* semaphore) {
+    pthread_mutex_lock(&semaphore->mutex);
+    const bool wasAcquired = semaphore->count > 0;
+    if (wasAcquired) {
+        semaphore->count--;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return wasAcquired;
+}
+
+void ska_semaphore_wait(SkaSemaphore* semaphore) {
+    pthread_mutex_lock(&semaphore->mutex);
+    while (semaphore->count == 0) {
+        pthread_cond_wait(&semaphore->cond, &semaphore->mutex);
+    }
+    semaphore->count--;
+    pthread_mutex_unlock(&semaphore->mutex);
+}
+#endif
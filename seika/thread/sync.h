@@ -0,0 +1,66 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "seika/thread/atomic.h"
+#include "seika/thread/pthread.h"
+
+// Lightweight synchronization primitives.  Thread event and semaphore are futex based on linux and only enter the kernel when a
+// thread actually has to sleep or be woken, other platforms fall back to a mutex and condition variable.
+
+// --- Spin Lock --- //
+// For very short critical sections, spins with exponential backoff and yields the thread once backoff maxes out
+typedef struct SkaSpinLock {
+    SKA_ATOMIC(bool) isLocked;
+} SkaSpinLock;
+
+#define SKA_SPIN_LOCK_INIT { false }
+
+void ska_spin_lock_initialize(SkaSpinLock* spinLock);
+void ska_spin_lock_lock(SkaSpinLock* spinLock);
+bool ska_spin_lock_try_lock(SkaSpinLock* spinLock);
+void ska_spin_lock_unlock(SkaSpinLock* spinLock);
+
+// --- Thread Event --- //
+// Auto reset event for a single waiting thread, setting an already set event does nothing
+typedef struct SkaThreadEvent {
+#if defined(PLATFORM_LINUX)
+    SKA_ATOMIC(uint32) state;
+#else
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool isSet;
+#endif
+} SkaThreadEvent;
+
+void ska_thread_event_initialize(SkaThreadEvent* event);
+void ska_thread_event_finalize(SkaThreadEvent* event);
+void ska_thread_event_set(SkaThreadEvent* event);
+// Blocks until the event is set and then resets it
+void ska_thread_event_wait(SkaThreadEvent* event);
+// Resets the event and returns true if it was set
+bool ska_thread_event_try_wait(SkaThreadEvent* event);
+
+// --- Semaphore --- //
+typedef struct SkaSemaphore {
+#if defined(PLATFORM_LINUX)
+    SKA_ATOMIC(uint32) count;
+    SKA_ATOMIC(uint32) waiterCount;
+#else
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32 count;
+#endif
+} SkaSemaphore;
+
+void ska_semaphore_initialize(SkaSemaphore* semaphore, uint32 initialCount);
+void ska_semaphore_finalize(SkaSemaphore* semaphore);
+void ska_semaphore_post(SkaSemaphore* semaphore, uint32 count);
+void ska_semaphore_wait(SkaSemaphore* semaphore);
+bool ska_semaphore_try_wait(SkaSemaphore* semaphore);
+
+#ifdef __cplusplus
+}
+#endif
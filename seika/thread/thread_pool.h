@@ -1,24 +1,13 @@
 #pragma once
 
-#include "seika/thread/pthread.h"
+#include "seika/thread/job_system.h"
 
-typedef void (*SkaThreadFunc)(void* arg);
-
-typedef struct SkaThreadPoolWork {
-    SkaThreadFunc func;
-    void* arg;
-    struct SkaThreadPoolWork* next;
-} SkaThreadPoolWork;
+typedef SkaJobFunc SkaThreadFunc;
 
+// Compatibility layer over 'SkaJobSystem', prefer using the job system directly for new code
 typedef struct SkaThreadPool {
-    SkaThreadPoolWork* workFirst;
-    SkaThreadPoolWork* workLast;
-    pthread_mutex_t workMutex;
-    pthread_cond_t workCond;
-    pthread_cond_t workingCond;
-    usize workingCount;
+    SkaJobSystem* jobSystem;
     usize threadCount;
-    bool shouldStop;
 } SkaThreadPool;
 
 SkaThreadPool* ska_tpool_create(usize num);
@@ -0,0 +1,1213 @@
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include "seika/thread/atomic.h"
+
+#include "seika/defines.h"
+#include "seika/memory.h"
+#include "seika/thread/job_system.h"
+#include "seika/thread/sync.h"
+
+#define SKA_SPSC_RING_BUFFER_TEMPLATE uint32
+#include "seika/data_structures/spsc_ring_buffer_template.h"
+#define SKA_MPMC_RING_BUFFER_TEMPLATE uint32
+#include "seika/data_structures/mpmc_ring_buffer_template.h"
+
+#if SKA_ECS
+#include "seika/ecs/ecs.h"
+#endif
+
+#if SKA_RENDERING
+#include "seika/rendering/sprite_draw_buffer.h"
+#include "seika/rendering/sprite_batch.h"
+#include "seika/rendering/render_queue.h"
+#include "seika/rendering/sprite_culling.h"
+#include "seika/rendering/renderer.h"
+#include "seika/data_structures/array_utils.h"
+#endif
+
+#if SKA_RENDERING && SKA_BENCHMARK_HEADLESS_GL
+#include <stdlib.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include "seika/rendering/renderer.h"
+#include "seika/rendering/texture_atlas.h"
+#include "seika/rendering/font.h"
+#include "seika/rendering/text_layout.h"
+#endif
+
+// Simple benchmark runner, benchmarks are timed with a wall clock between 'benchmark_start' and 'benchmark_stop'
+
+static f64 benchmarkStartTime = 0.0;
+
+static f64 benchmark_get_time_ms() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (f64)ts.tv_sec * 1000.0 + (f64)ts.tv_nsec / 1000000.0;
+}
+
+static void benchmark_start() {
+    benchmarkStartTime = benchmark_get_time_ms();
+}
+
+static f64 benchmark_stop(const char* name) {
+    const f64 elapsedTime = benchmark_get_time_ms() - benchmarkStartTime;
+    printf("[benchmark] %-56s %10.3f ms\n", name, elapsedTime);
+    return elapsedTime;
+}
+
+#if SKA_ECS
+#define ENTITY_CHURN_CYCLES 1000000
+
+static void benchmark_ecs_entity_churn(void) {
+    ska_ecs_initialize();
+    benchmark_start();
+    SkaEntity lastEntity = SKA_NULL_ENTITY;
+    for (usize i = 0; i < ENTITY_CHURN_CYCLES; i++) {
+        const SkaEntity entity = ska_ecs_entity_create();
+        ska_ecs_entity_return(entity);
+        lastEntity = entity;
+    }
+    benchmark_stop("ecs entity create/return 1M cycles");
+    printf("[benchmark] entity churn last id = %u (index = %u, generation = %u)\n", lastEntity, SKA_ENTITY_GET_INDEX(lastEntity), SKA_ENTITY_GET_GENERATION(lastEntity));
+    ska_ecs_finalize();
+}
+
+static void benchmark_ecs_entity_is_alive(void) {
+    ska_ecs_initialize();
+    SkaEntity entities[1000];
+    for (usize i = 0; i < 1000; i++) {
+        entities[i] = ska_ecs_entity_create();
+    }
+    benchmark_start();
+    usize aliveCount = 0;
+    for (usize i = 0; i < ENTITY_CHURN_CYCLES; i++) {
+        aliveCount += ska_ecs_entity_is_alive(entities[i % 1000]) ? 1 : 0;
+    }
+    benchmark_stop("ecs entity is alive 1M lookups");
+    printf("[benchmark] entity is alive count = %zu\n", aliveCount);
+    ska_ecs_finalize();
+}
+#undef ENTITY_CHURN_CYCLES
+
+typedef struct BenchmarkPositionComponent {
+    f32 x;
+    f32 y;
+} BenchmarkPositionComponent;
+
+typedef struct BenchmarkVelocityComponent {
+    f32 x;
+    f32 y;
+} BenchmarkVelocityComponent;
+
+#define SPAWN_ENTITY_COUNT 10000
+
+static void benchmark_ecs_spawn(void) {
+    static SkaEntity entities[SPAWN_ENTITY_COUNT];
+    ska_ecs_initialize();
+    const SkaComponentTypeInfo* positionTypeInfo = SKA_ECS_REGISTER_COMPONENT(BenchmarkPositionComponent);
+    const SkaComponentTypeInfo* velocityTypeInfo = SKA_ECS_REGISTER_COMPONENT(BenchmarkVelocityComponent);
+    ska_ecs_system_register(SKA_ECS_SYSTEM_CREATE("benchmark movement system", BenchmarkPositionComponent, BenchmarkVelocityComponent));
+
+    // One entity at a time
+    benchmark_start();
+    for (usize i = 0; i < SPAWN_ENTITY_COUNT; i++) {
+        const SkaEntity entity = ska_ecs_entity_create();
+        BenchmarkPositionComponent* positionComponent = SKA_ALLOC(BenchmarkPositionComponent);
+        *positionComponent = (BenchmarkPositionComponent){ .x = 1.0f, .y = 2.0f };
+        ska_ecs_component_manager_set_component(entity, positionTypeInfo->index, positionComponent);
+        ska_ecs_component_manager_set_component(entity, velocityTypeInfo->index, SKA_ALLOC_ZEROED(BenchmarkVelocityComponent));
+        ska_ecs_system_update_entity_signature_with_systems(entity);
+        entities[i] = entity;
+    }
+    benchmark_stop("ecs spawn 10k entities x 2 components (individual)");
+    // Free in reverse so the default allocator's tracking list isn't part of the next measurement
+    for (usize i = SPAWN_ENTITY_COUNT; i > 0; i--) {
+        ska_ecs_component_manager_remove_all_components(entities[i - 1]);
+    }
+    ska_ecs_despawn_batch(entities, SPAWN_ENTITY_COUNT);
+
+    // Batch
+    const void* initData[SKA_ECS_MAX_COMPONENTS] = {0};
+    initData[positionTypeInfo->index] = &(BenchmarkPositionComponent){ .x = 1.0f, .y = 2.0f };
+    benchmark_start();
+    ska_ecs_spawn_batch(positionTypeInfo->type | velocityTypeInfo->type, SPAWN_ENTITY_COUNT, initData, entities);
+    benchmark_stop("ecs spawn 10k entities x 2 components (batch)");
+    benchmark_start();
+    ska_ecs_despawn_batch(entities, SPAWN_ENTITY_COUNT);
+    benchmark_stop("ecs despawn 10k entities x 2 components (batch)");
+
+    ska_ecs_finalize();
+}
+
+typedef struct BenchmarkHealthComponent {
+    int32 health;
+    int32 maxHealth;
+} BenchmarkHealthComponent;
+
+typedef struct BenchmarkTransformComponent {
+    f32 matrix[16];
+} BenchmarkTransformComponent;
+
+#define SNAPSHOT_ITERATIONS 100
+
+static void benchmark_ecs_snapshot(void) {
+    static SkaEntity entities[SPAWN_ENTITY_COUNT];
+    ska_ecs_initialize();
+    const SkaComponentTypeInfo* positionTypeInfo = SKA_ECS_REGISTER_COMPONENT(BenchmarkPositionComponent);
+    const SkaComponentTypeInfo* velocityTypeInfo = SKA_ECS_REGISTER_COMPONENT(BenchmarkVelocityComponent);
+    const SkaComponentTypeInfo* healthTypeInfo = SKA_ECS_REGISTER_COMPONENT(BenchmarkHealthComponent);
+    const SkaComponentTypeInfo* transformTypeInfo = SKA_ECS_REGISTER_COMPONENT(BenchmarkTransformComponent);
+    ska_ecs_system_register(SKA_ECS_SYSTEM_CREATE("benchmark movement system", BenchmarkPositionComponent, BenchmarkVelocityComponent));
+    ska_ecs_spawn_batch(positionTypeInfo->type | velocityTypeInfo->type | healthTypeInfo->type | transformTypeInfo->type, SPAWN_ENTITY_COUNT, NULL, entities);
+
+    SkaECSSnapshot* snapshot = ska_ecs_snapshot_create();
+    benchmark_start();
+    for (usize i = 0; i < SNAPSHOT_ITERATIONS; i++) {
+        ska_ecs_snapshot_capture(snapshot);
+    }
+    const f64 captureTime = benchmark_stop("ecs snapshot capture 10k entities x 4 components x100");
+    benchmark_start();
+    for (usize i = 0; i < SNAPSHOT_ITERATIONS; i++) {
+        ska_ecs_snapshot_restore(snapshot);
+    }
+    const f64 restoreTime = benchmark_stop("ecs snapshot restore 10k entities x 4 components x100");
+    printf("[benchmark] snapshot size = %zu bytes, capture = %.3f ms, restore = %.3f ms (per snapshot)\n", snapshot->size, captureTime / SNAPSHOT_ITERATIONS, restoreTime / SNAPSHOT_ITERATIONS);
+
+    ska_ecs_snapshot_destroy(snapshot);
+    ska_ecs_despawn_batch(entities, SPAWN_ENTITY_COUNT);
+    ska_ecs_finalize();
+}
+
+#undef SNAPSHOT_ITERATIONS
+#undef SPAWN_ENTITY_COUNT
+#endif // if SKA_ECS
+
+#define TINY_JOB_COUNT 1000000
+#define FORK_JOIN_DEPTH 17
+
+static uint32 tinyJobResults[TINY_JOB_COUNT];
+static SKA_ATOMIC(uint32) forkJoinLeafCount = 0;
+static SkaJobSystem* benchmarkJobSystem = NULL;
+
+static void benchmark_tiny_job(void* arg) {
+    const usize index = (usize)(uintptr_t)arg;
+    tinyJobResults[index] = (uint32)index * 2;
+}
+
+static void benchmark_fork_join_job(void* arg) {
+    const usize depth = (usize)(uintptr_t)arg;
+    if (depth == 0) {
+        ska_atomic_fetch_add(&forkJoinLeafCount, 1, SkaMemoryOrder_RELAXED);
+        return;
+    }
+    ska_job_system_submit(benchmarkJobSystem, benchmark_fork_join_job, (void*)(uintptr_t)(depth - 1));
+    ska_job_system_submit(benchmarkJobSystem, benchmark_fork_join_job, (void*)(uintptr_t)(depth - 1));
+}
+
+static void benchmark_job_system(void) {
+    char nameBuffer[128];
+    const usize maxWorkerCount = pcthread_get_num_procs() > 1 ? (usize)pcthread_get_num_procs() : 1;
+    for (usize workerCount = 1; workerCount <= maxWorkerCount; workerCount *= 2) {
+        benchmarkJobSystem = ska_job_system_create(workerCount);
+
+        benchmark_start();
+        for (usize i = 0; i < TINY_JOB_COUNT; i++) {
+            ska_job_system_submit(benchmarkJobSystem, benchmark_tiny_job, (void*)(uintptr_t)i);
+        }
+        ska_job_system_wait_idle(benchmarkJobSystem);
+        snprintf(nameBuffer, sizeof(nameBuffer), "job system 1M tiny jobs (%zu workers)", workerCount);
+        benchmark_stop(nameBuffer);
+
+        ska_job_system_set_stats_enabled(benchmarkJobSystem, true);
+        benchmark_start();
+        for (usize i = 0; i < TINY_JOB_COUNT; i++) {
+            ska_job_system_submit(benchmarkJobSystem, benchmark_tiny_job, (void*)(uintptr_t)i);
+        }
+        ska_job_system_wait_idle(benchmarkJobSystem);
+        snprintf(nameBuffer, sizeof(nameBuffer), "job system 1M tiny jobs with stats (%zu workers)", workerCount);
+        benchmark_stop(nameBuffer);
+        ska_job_system_set_stats_enabled(benchmarkJobSystem, false);
+
+        ska_atomic_store(&forkJoinLeafCount, 0, SkaMemoryOrder_SEQ_CST);
+        benchmark_start();
+        ska_job_system_submit(benchmarkJobSystem, benchmark_fork_join_job, (void*)(uintptr_t)FORK_JOIN_DEPTH);
+        ska_job_system_wait_idle(benchmarkJobSystem);
+        snprintf(nameBuffer, sizeof(nameBuffer), "job system fork tree depth %d (%zu workers)", FORK_JOIN_DEPTH, workerCount);
+        benchmark_stop(nameBuffer);
+        printf("[benchmark] fork tree leaf count = %u\n", ska_atomic_load(&forkJoinLeafCount, SkaMemoryOrder_SEQ_CST));
+
+        ska_job_system_destroy(benchmarkJobSystem);
+        benchmarkJobSystem = NULL;
+    }
+}
+
+#undef FORK_JOIN_DEPTH
+#undef TINY_JOB_COUNT
+
+// Latency of short jobs queued behind long tasks, long tasks either hold their worker or yield between slices
+#define LONG_TASK_COUNT 4
+#define LONG_TASK_SLICE_COUNT 40
+#define LONG_TASK_SLICE_MS 0.25
+#define SHORT_JOB_COUNT 64
+
+static f64 shortJobSubmitTime = 0.0;
+static f64 shortJobLatencies[SHORT_JOB_COUNT];
+static int32 longTaskSliceIndices[LONG_TASK_COUNT];
+
+static void benchmark_busy_wait_ms(f64 durationMs) {
+    const f64 endTime = benchmark_get_time_ms() + durationMs;
+    while (benchmark_get_time_ms() < endTime) {}
+}
+
+static void benchmark_short_job(void* arg) {
+    shortJobLatencies[(usize)(uintptr_t)arg] = benchmark_get_time_ms() - shortJobSubmitTime;
+}
+
+static void benchmark_long_blocking_job(void* arg) {
+    for (int32 i = 0; i < LONG_TASK_SLICE_COUNT; i++) {
+        benchmark_busy_wait_ms(LONG_TASK_SLICE_MS);
+    }
+}
+
+static SkaJobCoroutineResult benchmark_long_coroutine(SkaJobCoroutine* co, void* arg) {
+    int32* sliceIndex = (int32*)arg;
+    SKA_JOB_COROUTINE_BEGIN(co);
+    for (*sliceIndex = 0; *sliceIndex < LONG_TASK_SLICE_COUNT; (*sliceIndex)++) {
+        benchmark_busy_wait_ms(LONG_TASK_SLICE_MS);
+        SKA_JOB_COROUTINE_YIELD(co);
+    }
+    SKA_JOB_COROUTINE_END(co);
+}
+
+static void benchmark_print_short_job_latency(const char* name) {
+    f64 totalLatency = 0.0;
+    f64 maxLatency = 0.0;
+    for (usize i = 0; i < SHORT_JOB_COUNT; i++) {
+        totalLatency += shortJobLatencies[i];
+        maxLatency = shortJobLatencies[i] > maxLatency ? shortJobLatencies[i] : maxLatency;
+    }
+    printf("[benchmark] %-56s avg = %.3f ms, max = %.3f ms\n", name, totalLatency / SHORT_JOB_COUNT, maxLatency);
+}
+
+static void benchmark_job_coroutine_latency(void) {
+    benchmarkJobSystem = ska_job_system_create(1);
+
+    benchmark_start();
+    for (usize i = 0; i < LONG_TASK_COUNT; i++) {
+        ska_job_system_submit(benchmarkJobSystem, benchmark_long_blocking_job, NULL);
+    }
+    shortJobSubmitTime = benchmark_get_time_ms();
+    for (usize i = 0; i < SHORT_JOB_COUNT; i++) {
+        ska_job_system_submit(benchmarkJobSystem, benchmark_short_job, (void*)(uintptr_t)i);
+    }
+    ska_job_system_wait_idle(benchmarkJobSystem);
+    benchmark_stop("job system 4 blocking long tasks + 64 short jobs");
+    benchmark_print_short_job_latency("short job latency behind blocking tasks");
+
+    SkaJobCounter* coroutineCounter = ska_job_counter_create(benchmarkJobSystem);
+    benchmark_start();
+    for (usize i = 0; i < LONG_TASK_COUNT; i++) {
+        ska_job_system_submit_coroutine(benchmarkJobSystem, benchmark_long_coroutine, &longTaskSliceIndices[i], coroutineCounter);
+    }
+    shortJobSubmitTime = benchmark_get_time_ms();
+    for (usize i = 0; i < SHORT_JOB_COUNT; i++) {
+        ska_job_system_submit(benchmarkJobSystem, benchmark_short_job, (void*)(uintptr_t)i);
+    }
+    ska_job_system_wait_for_counter(benchmarkJobSystem, coroutineCounter);
+    ska_job_system_wait_idle(benchmarkJobSystem);
+    benchmark_stop("job system 4 yielding long coroutines + 64 short jobs");
+    benchmark_print_short_job_latency("short job latency behind yielding coroutines");
+
+    ska_job_counter_destroy(coroutineCounter);
+    ska_job_system_destroy(benchmarkJobSystem);
+    benchmarkJobSystem = NULL;
+}
+
+#undef SHORT_JOB_COUNT
+#undef LONG_TASK_SLICE_MS
+#undef LONG_TASK_SLICE_COUNT
+#undef LONG_TASK_COUNT
+
+// Cross thread handoff throughput, a mutex protected ring is the baseline
+#define RING_BUFFER_ITEM_COUNT 4000000
+#define RING_BUFFER_CAPACITY 1024
+#define RING_BUFFER_MPMC_THREAD_COUNT 2
+
+typedef struct BenchmarkMutexRing {
+    pthread_mutex_t mutex;
+    uint32 items[RING_BUFFER_CAPACITY];
+    usize head;
+    usize tail;
+} BenchmarkMutexRing;
+
+static BenchmarkMutexRing mutexRing;
+static SkaSPSCRingBuffer_uint32 spscRingBuffer;
+static SkaMPMCRingBuffer_uint32 mpmcRingBuffer;
+static SKA_ATOMIC(uint32) mpmcConsumedCount = 0;
+
+static bool benchmark_mutex_ring_try_push(uint32 item) {
+    pthread_mutex_lock(&mutexRing.mutex);
+    const bool hasRoom = mutexRing.tail - mutexRing.head < RING_BUFFER_CAPACITY;
+    if (hasRoom) {
+        mutexRing.items[mutexRing.tail++ % RING_BUFFER_CAPACITY] = item;
+    }
+    pthread_mutex_unlock(&mutexRing.mutex);
+    return hasRoom;
+}
+
+static bool benchmark_mutex_ring_try_pop(uint32* outItem) {
+    pthread_mutex_lock(&mutexRing.mutex);
+    const bool hasItem = mutexRing.tail != mutexRing.head;
+    if (hasItem) {
+        *outItem = mutexRing.items[mutexRing.head++ % RING_BUFFER_CAPACITY];
+    }
+    pthread_mutex_unlock(&mutexRing.mutex);
+    return hasItem;
+}
+
+static void* benchmark_mutex_ring_producer(void* arg) {
+    for (uint32 i = 0; i < RING_BUFFER_ITEM_COUNT; i++) {
+        while (!benchmark_mutex_ring_try_push(i)) {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* benchmark_spsc_ring_buffer_producer(void* arg) {
+    for (uint32 i = 0; i < RING_BUFFER_ITEM_COUNT; i++) {
+        while (!ska_spsc_ring_buffer_uint32_try_push(&spscRingBuffer, i)) {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* benchmark_mpmc_ring_buffer_producer(void* arg) {
+    for (uint32 i = 0; i < RING_BUFFER_ITEM_COUNT / RING_BUFFER_MPMC_THREAD_COUNT; i++) {
+        while (!ska_mpmc_ring_buffer_uint32_try_push(&mpmcRingBuffer, i)) {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* benchmark_mpmc_ring_buffer_consumer(void* arg) {
+    uint32 item = 0;
+    while (ska_atomic_load(&mpmcConsumedCount, SkaMemoryOrder_RELAXED) < RING_BUFFER_ITEM_COUNT) {
+        if (ska_mpmc_ring_buffer_uint32_try_pop(&mpmcRingBuffer, &item)) {
+            ska_atomic_fetch_add(&mpmcConsumedCount, 1, SkaMemoryOrder_RELAXED);
+        } else {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+static void benchmark_ring_buffers(void) {
+    pthread_t producerThread;
+    uint32 item = 0;
+    uint64 checksum = 0;
+
+    pthread_mutex_init(&mutexRing.mutex, NULL);
+    benchmark_start();
+    pthread_create(&producerThread, NULL, benchmark_mutex_ring_producer, NULL);
+    for (uint32 i = 0; i < RING_BUFFER_ITEM_COUNT; i++) {
+        while (!benchmark_mutex_ring_try_pop(&item)) {
+            pcthread_yield();
+        }
+        checksum += item;
+    }
+    pthread_join(producerThread, NULL);
+    benchmark_stop("mutex ring 4M items 1 producer 1 consumer");
+    pthread_mutex_destroy(&mutexRing.mutex);
+
+    ska_spsc_ring_buffer_uint32_initialize(&spscRingBuffer, RING_BUFFER_CAPACITY);
+    benchmark_start();
+    pthread_create(&producerThread, NULL, benchmark_spsc_ring_buffer_producer, NULL);
+    for (uint32 i = 0; i < RING_BUFFER_ITEM_COUNT; i++) {
+        while (!ska_spsc_ring_buffer_uint32_try_pop(&spscRingBuffer, &item)) {
+            pcthread_yield();
+        }
+        checksum += item;
+    }
+    pthread_join(producerThread, NULL);
+    benchmark_stop("spsc ring buffer 4M items 1 producer 1 consumer");
+    ska_spsc_ring_buffer_uint32_finalize(&spscRingBuffer);
+
+    ska_mpmc_ring_buffer_uint32_initialize(&mpmcRingBuffer, RING_BUFFER_CAPACITY);
+    ska_atomic_store(&mpmcConsumedCount, 0, SkaMemoryOrder_SEQ_CST);
+    pthread_t producerThreads[RING_BUFFER_MPMC_THREAD_COUNT];
+    pthread_t consumerThreads[RING_BUFFER_MPMC_THREAD_COUNT];
+    benchmark_start();
+    for (usize i = 0; i < RING_BUFFER_MPMC_THREAD_COUNT; i++) {
+        pthread_create(&producerThreads[i], NULL, benchmark_mpmc_ring_buffer_producer, NULL);
+        pthread_create(&consumerThreads[i], NULL, benchmark_mpmc_ring_buffer_consumer, NULL);
+    }
+    for (usize i = 0; i < RING_BUFFER_MPMC_THREAD_COUNT; i++) {
+        pthread_join(producerThreads[i], NULL);
+        pthread_join(consumerThreads[i], NULL);
+    }
+    benchmark_stop("mpmc ring buffer 4M items 2 producers 2 consumers");
+    ska_mpmc_ring_buffer_uint32_finalize(&mpmcRingBuffer);
+    printf("[benchmark] ring buffer checksum = %llu\n", (unsigned long long)checksum);
+}
+
+#undef RING_BUFFER_MPMC_THREAD_COUNT
+#undef RING_BUFFER_CAPACITY
+#undef RING_BUFFER_ITEM_COUNT
+
+// Round trips between two threads and uncontended lock/unlock, compared against mutex and condition variable
+#define SYNC_PING_PONG_COUNT 100000
+#define SYNC_LOCK_COUNT 10000000
+
+typedef struct BenchmarkCondEvent {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool isSet;
+} BenchmarkCondEvent;
+
+static BenchmarkCondEvent condPingEvent;
+static BenchmarkCondEvent condPongEvent;
+static SkaThreadEvent threadPingEvent;
+static SkaThreadEvent threadPongEvent;
+
+static void benchmark_cond_event_set(BenchmarkCondEvent* event) {
+    pthread_mutex_lock(&event->mutex);
+    event->isSet = true;
+    pthread_cond_signal(&event->cond);
+    pthread_mutex_unlock(&event->mutex);
+}
+
+static void benchmark_cond_event_wait(BenchmarkCondEvent* event) {
+    pthread_mutex_lock(&event->mutex);
+    while (!event->isSet) {
+        pthread_cond_wait(&event->cond, &event->mutex);
+    }
+    event->isSet = false;
+    pthread_mutex_unlock(&event->mutex);
+}
+
+static void* benchmark_cond_pong_thread(void* arg) {
+    for (usize i = 0; i < SYNC_PING_PONG_COUNT; i++) {
+        benchmark_cond_event_wait(&condPingEvent);
+        benchmark_cond_event_set(&condPongEvent);
+    }
+    return NULL;
+}
+
+static void* benchmark_thread_event_pong_thread(void* arg) {
+    for (usize i = 0; i < SYNC_PING_PONG_COUNT; i++) {
+        ska_thread_event_wait(&threadPingEvent);
+        ska_thread_event_set(&threadPongEvent);
+    }
+    return NULL;
+}
+
+static void benchmark_sync_primitives(void) {
+    pthread_t pongThread;
+    BenchmarkCondEvent* condEvents[2] = { &condPingEvent, &condPongEvent };
+    for (usize i = 0; i < 2; i++) {
+        pthread_mutex_init(&condEvents[i]->mutex, NULL);
+        pthread_cond_init(&condEvents[i]->cond, NULL);
+        condEvents[i]->isSet = false;
+    }
+    benchmark_start();
+    pthread_create(&pongThread, NULL, benchmark_cond_pong_thread, NULL);
+    for (usize i = 0; i < SYNC_PING_PONG_COUNT; i++) {
+        benchmark_cond_event_set(&condPingEvent);
+        benchmark_cond_event_wait(&condPongEvent);
+    }
+    pthread_join(pongThread, NULL);
+    benchmark_stop("mutex + cond event ping pong 100k round trips");
+    for (usize i = 0; i < 2; i++) {
+        pthread_mutex_destroy(&condEvents[i]->mutex);
+        pthread_cond_destroy(&condEvents[i]->cond);
+    }
+
+    ska_thread_event_initialize(&threadPingEvent);
+    ska_thread_event_initialize(&threadPongEvent);
+    benchmark_start();
+    pthread_create(&pongThread, NULL, benchmark_thread_event_pong_thread, NULL);
+    for (usize i = 0; i < SYNC_PING_PONG_COUNT; i++) {
+        ska_thread_event_set(&threadPingEvent);
+        ska_thread_event_wait(&threadPongEvent);
+    }
+    pthread_join(pongThread, NULL);
+    benchmark_stop("thread event ping pong 100k round trips");
+    ska_thread_event_finalize(&threadPingEvent);
+    ska_thread_event_finalize(&threadPongEvent);
+
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+    benchmark_start();
+    for (usize i = 0; i < SYNC_LOCK_COUNT; i++) {
+        pthread_mutex_lock(&mutex);
+        pthread_mutex_unlock(&mutex);
+    }
+    benchmark_stop("mutex uncontended lock/unlock 10M");
+    pthread_mutex_destroy(&mutex);
+
+    SkaSpinLock spinLock = SKA_SPIN_LOCK_INIT;
+    benchmark_start();
+    for (usize i = 0; i < SYNC_LOCK_COUNT; i++) {
+        ska_spin_lock_lock(&spinLock);
+        ska_spin_lock_unlock(&spinLock);
+    }
+    benchmark_stop("spin lock uncontended lock/unlock 10M");
+}
+
+#undef SYNC_LOCK_COUNT
+#undef SYNC_PING_PONG_COUNT
+
+#if SKA_RENDERING
+#define SPRITE_DRAW_COUNT 100000
+#define SPRITE_DRAW_TEXTURE_COUNT 8
+#define SPRITE_DRAW_MAX_BUFFERS 16
+
+typedef struct BenchmarkSpriteDrawJob {
+    SkaSpriteDrawBuffer* drawBuffer;
+    usize startIndex;
+    usize endIndex;
+} BenchmarkSpriteDrawJob;
+
+static SkaTexture spriteDrawTextures[SPRITE_DRAW_TEXTURE_COUNT];
+
+static void benchmark_queue_sprites(void* arg) {
+    BenchmarkSpriteDrawJob* job = (BenchmarkSpriteDrawJob*)arg;
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 32.0f, 32.0f };
+    const SkaSize2D destSize = { 32.0f, 32.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (usize i = job->startIndex; i < job->endIndex; i++) {
+        const SkaTransform2D transform = { .position = { (f32)(i % 800), (f32)(i % 600) }, .scale = { 1.0f, 1.0f }, .rotation = (f32)(i % 360) };
+        ska_sprite_draw_buffer_queue_sprite(job->drawBuffer, &spriteDrawTextures[(i / 64) % SPRITE_DRAW_TEXTURE_COUNT], sourceRect, destSize, color, false, false, &transform, (int32)(i % 9) - 4, NULL);
+    }
+}
+
+static void benchmark_sprite_draw_buffers(void) {
+    for (usize i = 0; i < SPRITE_DRAW_TEXTURE_COUNT; i++) {
+        spriteDrawTextures[i].id = (GLuint)i + 1;
+    }
+    SkaSpriteDrawBuffer* singleBuffer = ska_sprite_draw_buffer_create(SPRITE_DRAW_COUNT);
+    BenchmarkSpriteDrawJob singleJob = { .drawBuffer = singleBuffer, .startIndex = 0, .endIndex = SPRITE_DRAW_COUNT };
+    benchmark_start();
+    benchmark_queue_sprites(&singleJob);
+    benchmark_stop("sprite draw buffer queue 100k sprites (1 thread)");
+    ska_sprite_draw_buffer_destroy(singleBuffer);
+
+    SkaJobSystem* jobSystem = ska_job_system_create(0);
+    const usize workerCount = ska_job_system_get_worker_count(jobSystem);
+    const usize bufferCount = workerCount < SPRITE_DRAW_MAX_BUFFERS ? workerCount : SPRITE_DRAW_MAX_BUFFERS;
+    const usize spritesPerBuffer = (SPRITE_DRAW_COUNT + bufferCount - 1) / bufferCount;
+    SkaSpriteDrawBuffer* drawBuffers[SPRITE_DRAW_MAX_BUFFERS];
+    BenchmarkSpriteDrawJob jobs[SPRITE_DRAW_MAX_BUFFERS];
+    for (usize i = 0; i < bufferCount; i++) {
+        drawBuffers[i] = ska_sprite_draw_buffer_create(spritesPerBuffer);
+        const usize startIndex = i * spritesPerBuffer;
+        const usize endIndex = startIndex + spritesPerBuffer;
+        jobs[i] = (BenchmarkSpriteDrawJob){ .drawBuffer = drawBuffers[i], .startIndex = startIndex, .endIndex = endIndex < SPRITE_DRAW_COUNT ? endIndex : SPRITE_DRAW_COUNT };
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "sprite draw buffer queue 100k sprites (%zu threads)", bufferCount);
+    benchmark_start();
+    for (usize i = 0; i < bufferCount; i++) {
+        ska_job_system_submit(jobSystem, benchmark_queue_sprites, &jobs[i]);
+    }
+    ska_job_system_wait_idle(jobSystem);
+    benchmark_stop(name);
+    ska_job_system_destroy(jobSystem);
+    for (usize i = 0; i < bufferCount; i++) {
+        ska_sprite_draw_buffer_destroy(drawBuffers[i]);
+    }
+}
+
+#undef SPRITE_DRAW_MAX_BUFFERS
+#undef SPRITE_DRAW_TEXTURE_COUNT
+#undef SPRITE_DRAW_COUNT
+
+#define SPRITE_BATCH_SPRITE_COUNT 2000
+#define SPRITE_BATCH_ITERATIONS 200
+#define SPRITE_BATCH_LEGACY_VERTEX_STRIDE 10
+
+// Batch build cost on the cpu, the legacy version formats a model uniform name per sprite (the uniform upload itself isn't included)
+static void benchmark_sprite_batch_build(void) {
+    SkaTexture texture = { .width = 64, .height = 64, .applyNearestNeighbor = true };
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 32.0f, 32.0f };
+    const SkaSize2D destSize = { 32.0f, 32.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    mat4* models = (mat4*)SKA_ALLOC_BYTES(SPRITE_BATCH_SPRITE_COUNT * sizeof(mat4));
+    for (usize i = 0; i < SPRITE_BATCH_SPRITE_COUNT; i++) {
+        const SkaTransform2D transform = { .position = { (f32)(i % 800), (f32)(i % 600) }, .scale = { 1.0f, 1.0f }, .rotation = (f32)(i % 360) };
+        ska_transform2d_transform_to_mat4(&transform, models[i]);
+    }
+    f32 checksum = 0.0f;
+
+    f32* legacyVerts = (f32*)SKA_ALLOC_BYTES(SPRITE_BATCH_SPRITE_COUNT * SKA_SPRITE_BATCH_VERTICES_PER_SPRITE * SPRITE_BATCH_LEGACY_VERTEX_STRIDE * sizeof(f32));
+    benchmark_start();
+    for (usize iteration = 0; iteration < SPRITE_BATCH_ITERATIONS; iteration++) {
+        for (usize i = 0; i < SPRITE_BATCH_SPRITE_COUNT; i++) {
+            mat4 model;
+            glm_mat4_copy(models[i], model);
+            glm_scale(model, (vec3){ destSize.w, destSize.h, 1.0f });
+            const f32 determinate = glm_mat4_det(model);
+            char modelsBuffer[24];
+            sprintf(modelsBuffer, "CRE_MODELS[%zu]", i);
+            checksum += (f32)modelsBuffer[11];
+            for (int32 j = 0; j < SKA_SPRITE_BATCH_VERTICES_PER_SPRITE; j++) {
+                const bool isSMin = determinate >= 0.0f ? (j == 0 || j == 2 || j == 3) : (j == 1 || j == 2 || j == 5);
+                const bool isTMin = determinate >= 0.0f ? (j == 1 || j == 2 || j == 5) : (j == 0 || j == 2 || j == 3);
+                f32* vert = &legacyVerts[(i * SKA_SPRITE_BATCH_VERTICES_PER_SPRITE + (usize)j) * SPRITE_BATCH_LEGACY_VERTEX_STRIDE];
+                vert[0] = (f32)i;
+                vert[1] = isSMin ? 0.0f : 1.0f;
+                vert[2] = isTMin ? 0.0f : 1.0f;
+                vert[3] = isSMin ? sourceRect.x / (f32)texture.width : (sourceRect.x + sourceRect.w) / (f32)texture.width;
+                vert[4] = isTMin ? sourceRect.y / (f32)texture.height : (sourceRect.y + sourceRect.h) / (f32)texture.height;
+                vert[5] = color.r;
+                vert[6] = color.g;
+                vert[7] = color.b;
+                vert[8] = color.a;
+                vert[9] = (f32)texture.applyNearestNeighbor;
+            }
+        }
+        checksum += legacyVerts[iteration];
+    }
+    benchmark_stop("sprite batch build 2000 sprites x200 (legacy model uniforms)");
+    SKA_FREE(legacyVerts);
+
+    SkaSpriteVertex* verts = (SkaSpriteVertex*)SKA_ALLOC_BYTES(SPRITE_BATCH_SPRITE_COUNT * SKA_SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SkaSpriteVertex));
+    benchmark_start();
+    for (usize iteration = 0; iteration < SPRITE_BATCH_ITERATIONS; iteration++) {
+        for (usize i = 0; i < SPRITE_BATCH_SPRITE_COUNT; i++) {
+            ska_sprite_batch_write_sprite_vertices(&verts[i * SKA_SPRITE_BATCH_VERTICES_PER_SPRITE], &texture, &sourceRect, destSize, &color, false, false, models[i]);
+        }
+        checksum += verts[iteration].instance.modelOrigin[0];
+    }
+    benchmark_stop("sprite batch build 2000 sprites x200 (baked model vertices)");
+    SKA_FREE(verts);
+
+    SkaSpriteInstance* instances = (SkaSpriteInstance*)SKA_ALLOC_BYTES(SPRITE_BATCH_SPRITE_COUNT * sizeof(SkaSpriteInstance));
+    benchmark_start();
+    for (usize iteration = 0; iteration < SPRITE_BATCH_ITERATIONS; iteration++) {
+        for (usize i = 0; i < SPRITE_BATCH_SPRITE_COUNT; i++) {
+            ska_sprite_batch_write_sprite_instance(&instances[i], &texture, &sourceRect, destSize, &color, false, false, models[i]);
+        }
+        checksum += instances[iteration].modelOrigin[0];
+    }
+    benchmark_stop("sprite batch build 2000 sprites x200 (instances)");
+    SKA_FREE(instances);
+    printf("[benchmark] sprite batch checksum = %f\n", (f64)checksum);
+    SKA_FREE(models);
+}
+
+#undef SPRITE_BATCH_LEGACY_VERTEX_STRIDE
+#undef SPRITE_BATCH_ITERATIONS
+#undef SPRITE_BATCH_SPRITE_COUNT
+
+#define AFFINE2D_SPRITE_COUNT 10000
+#define AFFINE2D_ITERATIONS 200
+
+// Sprite transform math through cglm's 4x4 matrices against the 2x3 affine type
+static void benchmark_affine2d(void) {
+    SkaTexture texture = { .id = 1, .width = 32, .height = 32 };
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 32.0f, 32.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    SkaTransform2D* transforms = (SkaTransform2D*)SKA_ALLOC_BYTES(AFFINE2D_SPRITE_COUNT * sizeof(SkaTransform2D));
+    SkaSize2D* sizes = (SkaSize2D*)SKA_ALLOC_BYTES(AFFINE2D_SPRITE_COUNT * sizeof(SkaSize2D));
+    for (usize i = 0; i < AFFINE2D_SPRITE_COUNT; i++) {
+        transforms[i] = (SkaTransform2D){ .position = { (f32)(i % 800), (f32)(i % 600) }, .scale = { 1.0f + (f32)(i % 3), 1.0f }, .rotation = (f32)(i % 360) };
+        sizes[i] = (SkaSize2D){ 16.0f + (f32)(i % 16), 16.0f };
+    }
+    SkaSpriteInstance* instances = (SkaSpriteInstance*)SKA_ALLOC_BYTES(AFFINE2D_SPRITE_COUNT * sizeof(SkaSpriteInstance));
+    mat4* matrices = (mat4*)SKA_ALLOC_BYTES(AFFINE2D_SPRITE_COUNT * sizeof(mat4));
+    SkaAffine2D* affines = (SkaAffine2D*)SKA_ALLOC_BYTES(AFFINE2D_SPRITE_COUNT * sizeof(SkaAffine2D));
+    SkaVector2* corners = (SkaVector2*)SKA_ALLOC_BYTES(AFFINE2D_SPRITE_COUNT * 4 * sizeof(SkaVector2));
+    f32 checksum = 0.0f;
+
+    benchmark_start();
+    for (usize iteration = 0; iteration < AFFINE2D_ITERATIONS; iteration++) {
+        for (usize i = 0; i < AFFINE2D_SPRITE_COUNT; i++) {
+            ska_transform2d_transform_to_mat4(&transforms[i], matrices[i]);
+            ska_sprite_batch_write_sprite_instance(&instances[i], &texture, &sourceRect, sizes[i], &color, false, false, matrices[i]);
+        }
+        checksum += instances[iteration].modelBasis[0];
+    }
+    benchmark_stop("affine2d 10k transforms + instances x200 (cglm mat4)");
+
+    benchmark_start();
+    for (usize iteration = 0; iteration < AFFINE2D_ITERATIONS; iteration++) {
+        for (usize i = 0; i < AFFINE2D_SPRITE_COUNT; i++) {
+            ska_affine2d_from_transform(&transforms[i], &affines[i]);
+            ska_sprite_batch_write_sprite_instance2(&instances[i], &texture, &sourceRect, sizes[i], &color, false, false, &affines[i]);
+        }
+        checksum += instances[iteration].modelBasis[0];
+    }
+    benchmark_stop("affine2d 10k transforms + instances x200 (affine 2x3)");
+
+    // World space quad corners, e.g. for cpu side vertex generation or picking
+    benchmark_start();
+    for (usize iteration = 0; iteration < AFFINE2D_ITERATIONS; iteration++) {
+        for (usize i = 0; i < AFFINE2D_SPRITE_COUNT; i++) {
+            mat4 model;
+            glm_mat4_copy(matrices[i], model);
+            glm_scale(model, (vec3){ sizes[i].w, sizes[i].h, 1.0f });
+            static const f32 localCorners[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+            for (usize c = 0; c < 4; c++) {
+                vec4 corner = { localCorners[c][0], localCorners[c][1], 0.0f, 1.0f };
+                glm_mat4_mulv(model, corner, corner);
+                corners[i * 4 + c] = (SkaVector2){ corner[0], corner[1] };
+            }
+        }
+        checksum += corners[iteration].x;
+    }
+    benchmark_stop("affine2d 10k quad corners x200 (cglm mat4 * vec4)");
+
+    benchmark_start();
+    for (usize iteration = 0; iteration < AFFINE2D_ITERATIONS; iteration++) {
+        ska_affine2d_transform_quads(affines, sizes, AFFINE2D_SPRITE_COUNT, corners);
+        checksum += corners[iteration].x;
+    }
+    benchmark_stop("affine2d 10k quad corners x200 (affine batch kernel)");
+    printf("[benchmark] affine2d checksum = %f\n", (f64)checksum);
+    SKA_FREE(corners);
+    SKA_FREE(affines);
+    SKA_FREE(matrices);
+    SKA_FREE(instances);
+    SKA_FREE(sizes);
+    SKA_FREE(transforms);
+}
+
+#undef AFFINE2D_ITERATIONS
+#undef AFFINE2D_SPRITE_COUNT
+#define RENDER_QUEUE_SPRITE_COUNT 50000
+#define RENDER_QUEUE_TEXTURE_COUNT 16
+#define RENDER_QUEUE_Z_INDEX_COUNT 9
+#define RENDER_QUEUE_FRAME_COUNT 100
+#define RENDER_QUEUE_LEGACY_TEXTURE_LAYER_MAX 64
+#define RENDER_QUEUE_LEGACY_BATCH_ITEM_MAX 1024
+
+// Same layout as the renderer's sprite batch item
+typedef struct BenchmarkRenderQueueItem {
+    SkaTexture* texture;
+    SkaRect2 sourceRect;
+    SkaSize2D destSize;
+    SkaColor color;
+    bool flipH;
+    bool flipV;
+    SkaAffine2D model;
+    void* shaderInstance;
+} BenchmarkRenderQueueItem;
+
+// Legacy per z index texture layers, only the layers actually used are allocated here
+typedef struct BenchmarkLegacyTextureLayer {
+    BenchmarkRenderQueueItem* items;
+    usize count;
+} BenchmarkLegacyTextureLayer;
+
+// Queueing and ordering cost of a frame's sprites, the legacy version looks up texture layers with a linear scan and keeps
+// active z indices unique and sorted with a selection sort
+static void benchmark_render_queue(void) {
+    SkaTexture textures[RENDER_QUEUE_TEXTURE_COUNT];
+    for (usize i = 0; i < RENDER_QUEUE_TEXTURE_COUNT; i++) {
+        textures[i] = (SkaTexture){ .id = (GLuint)i + 1, .width = 32, .height = 32 };
+    }
+    BenchmarkRenderQueueItem item = { .sourceRect = { 0.0f, 0.0f, 32.0f, 32.0f }, .destSize = { 32.0f, 32.0f }, .color = { 1.0f, 1.0f, 1.0f, 1.0f } };
+    item.model = SKA_AFFINE2D_IDENTITY;
+    uint64 checksum = 0;
+
+    static BenchmarkLegacyTextureLayer legacyLayers[SKA_RENDERER_MAX_Z_INDEX][RENDER_QUEUE_LEGACY_TEXTURE_LAYER_MAX];
+    static usize legacyLayerCounts[SKA_RENDERER_MAX_Z_INDEX];
+    static int32 legacyActiveZIndices[SKA_RENDERER_MAX_Z_INDEX];
+    usize legacyActiveZIndexCount = 0;
+    for (usize z = 0; z < RENDER_QUEUE_Z_INDEX_COUNT; z++) {
+        for (usize t = 0; t < RENDER_QUEUE_TEXTURE_COUNT; t++) {
+            legacyLayers[z][t].items = (BenchmarkRenderQueueItem*)SKA_ALLOC_BYTES(RENDER_QUEUE_LEGACY_BATCH_ITEM_MAX * sizeof(BenchmarkRenderQueueItem));
+        }
+    }
+    benchmark_start();
+    for (usize frame = 0; frame < RENDER_QUEUE_FRAME_COUNT; frame++) {
+        for (usize i = 0; i < RENDER_QUEUE_SPRITE_COUNT; i++) {
+            const int32 z = (int32)(i % RENDER_QUEUE_Z_INDEX_COUNT);
+            item.texture = &textures[(i / RENDER_QUEUE_Z_INDEX_COUNT) % RENDER_QUEUE_TEXTURE_COUNT];
+            usize layerIndex = legacyLayerCounts[z];
+            for (usize l = 0; l < legacyLayerCounts[z]; l++) {
+                if (legacyLayers[z][l].items[0].texture == item.texture && legacyLayers[z][l].items[0].shaderInstance == item.shaderInstance) {
+                    layerIndex = l;
+                    break;
+                }
+            }
+            BenchmarkLegacyTextureLayer* layer = &legacyLayers[z][layerIndex];
+            if (layer->count == 0) {
+                legacyLayerCounts[z]++;
+                bool isActive = false;
+                for (usize a = 0; a < legacyActiveZIndexCount; a++) {
+                    isActive |= legacyActiveZIndices[a] == z;
+                }
+                if (!isActive) {
+                    legacyActiveZIndices[legacyActiveZIndexCount++] = z;
+                    ska_array_utils_selection_sort_int(legacyActiveZIndices, (int32)legacyActiveZIndexCount);
+                }
+            }
+            layer->items[layer->count++] = item;
+        }
+        for (usize a = 0; a < legacyActiveZIndexCount; a++) {
+            const int32 z = legacyActiveZIndices[a];
+            for (usize l = 0; l < legacyLayerCounts[z]; l++) {
+                checksum += legacyLayers[z][l].count;
+                legacyLayers[z][l].count = 0;
+            }
+            legacyLayerCounts[z] = 0;
+        }
+        legacyActiveZIndexCount = 0;
+    }
+    benchmark_stop("render queue 50k sprites x100 (legacy texture layers)");
+    for (usize z = 0; z < RENDER_QUEUE_Z_INDEX_COUNT; z++) {
+        for (usize t = 0; t < RENDER_QUEUE_TEXTURE_COUNT; t++) {
+            SKA_FREE(legacyLayers[z][t].items);
+        }
+    }
+
+    SkaRenderQueue* queue = ska_render_queue_create(1024);
+    usize itemCapacity = 1024;
+    BenchmarkRenderQueueItem* items = (BenchmarkRenderQueueItem*)SKA_ALLOC_BYTES(itemCapacity * sizeof(BenchmarkRenderQueueItem));
+    benchmark_start();
+    for (usize frame = 0; frame < RENDER_QUEUE_FRAME_COUNT; frame++) {
+        for (usize i = 0; i < RENDER_QUEUE_SPRITE_COUNT; i++) {
+            if (i >= itemCapacity) {
+                itemCapacity *= 2;
+                items = (BenchmarkRenderQueueItem*)ska_mem_reallocate(items, itemCapacity * sizeof(BenchmarkRenderQueueItem));
+            }
+            item.texture = &textures[(i / RENDER_QUEUE_Z_INDEX_COUNT) % RENDER_QUEUE_TEXTURE_COUNT];
+            items[i] = item;
+            ska_render_queue_push_sprite(queue, (uint32)(i % RENDER_QUEUE_Z_INDEX_COUNT), item.shaderInstance, item.texture->id, (uint32)i);
+        }
+        ska_render_queue_sort(queue);
+        checksum += ska_render_queue_key_get_index(queue->keys[queue->count - 1]);
+        ska_render_queue_clear(queue);
+    }
+    benchmark_stop("render queue 50k sprites x100 (sort keys + radix sort)");
+
+    const usize legacyMemory = (usize)SKA_RENDERER_MAX_Z_INDEX * RENDER_QUEUE_LEGACY_TEXTURE_LAYER_MAX * RENDER_QUEUE_LEGACY_BATCH_ITEM_MAX * sizeof(BenchmarkRenderQueueItem);
+    const usize queueMemory = ska_render_queue_get_memory_size(queue) + itemCapacity * sizeof(BenchmarkRenderQueueItem);
+    printf("[benchmark] render queue memory, legacy static layers = %.1f MB, render queue (50k sprites) = %.1f MB\n", (f64)legacyMemory / (1024.0 * 1024.0), (f64)queueMemory / (1024.0 * 1024.0));
+    printf("[benchmark] render queue checksum = %llu\n", (unsigned long long)checksum);
+    SKA_FREE(items);
+    ska_render_queue_destroy(queue);
+}
+
+#undef RENDER_QUEUE_LEGACY_BATCH_ITEM_MAX
+#undef RENDER_QUEUE_LEGACY_TEXTURE_LAYER_MAX
+#undef RENDER_QUEUE_FRAME_COUNT
+#undef RENDER_QUEUE_Z_INDEX_COUNT
+#undef RENDER_QUEUE_TEXTURE_COUNT
+#undef RENDER_QUEUE_SPRITE_COUNT
+
+#define SPRITE_CULLING_SPRITE_COUNT 50000
+#define SPRITE_CULLING_FRAME_COUNT 100
+#define SPRITE_CULLING_VIEW_SIZE 800.0f
+#define SPRITE_CULLING_WORLD_SIZE 2530.0f // About 10 times the view's area
+
+// Writes sprite instances at random positions across the world, 'SPRITE_CULLING_VIEW_SIZE' sized view at the world's origin
+static void benchmark_sprite_culling_fill_models(SkaAffine2D* models) {
+    uint32 seed = 12345;
+    for (usize i = 0; i < SPRITE_CULLING_SPRITE_COUNT; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        const f32 x = (f32)(seed >> 8) / (f32)(1u << 24) * SPRITE_CULLING_WORLD_SIZE;
+        seed = seed * 1664525u + 1013904223u;
+        const f32 y = (f32)(seed >> 8) / (f32)(1u << 24) * SPRITE_CULLING_WORLD_SIZE;
+        const SkaTransform2D transform = { .position = { x, y }, .scale = { 1.0f, 1.0f }, .rotation = (f32)(i % 360) };
+        ska_affine2d_from_transform(&transform, &models[i]);
+    }
+}
+
+// Cost of the culling stage against the sprite data it saves writing, for a world where about 10% of the sprites are visible
+static void benchmark_sprite_culling(void) {
+    SkaTexture texture = { .id = 1, .width = 32, .height = 32 };
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 32.0f, 32.0f };
+    const SkaSize2D destSize = { 32.0f, 32.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    const SkaRect2 view = { 0.0f, 0.0f, SPRITE_CULLING_VIEW_SIZE, SPRITE_CULLING_VIEW_SIZE };
+    SkaAffine2D* models = (SkaAffine2D*)SKA_ALLOC_BYTES(SPRITE_CULLING_SPRITE_COUNT * sizeof(SkaAffine2D));
+    benchmark_sprite_culling_fill_models(models);
+    SkaSpriteInstance* instances = (SkaSpriteInstance*)SKA_ALLOC_BYTES(SPRITE_CULLING_SPRITE_COUNT * sizeof(SkaSpriteInstance));
+    f32 checksum = 0.0f;
+
+    benchmark_start();
+    for (usize frame = 0; frame < SPRITE_CULLING_FRAME_COUNT; frame++) {
+        for (usize i = 0; i < SPRITE_CULLING_SPRITE_COUNT; i++) {
+            ska_sprite_batch_write_sprite_instance2(&instances[i], &texture, &sourceRect, destSize, &color, false, false, &models[i]);
+        }
+        checksum += instances[frame].modelOrigin[0];
+    }
+    benchmark_stop("sprite culling 50k sprites x100 (no culling)");
+
+    SkaSpriteCullingBounds* bounds = ska_sprite_culling_bounds_create(SPRITE_CULLING_SPRITE_COUNT);
+    bool* visible = (bool*)SKA_ALLOC_BYTES(SPRITE_CULLING_SPRITE_COUNT * sizeof(bool));
+    usize visibleCount = 0;
+    f64 testTime = 0.0;
+    benchmark_start();
+    for (usize frame = 0; frame < SPRITE_CULLING_FRAME_COUNT; frame++) {
+        ska_sprite_culling_bounds_clear(bounds);
+        for (usize i = 0; i < SPRITE_CULLING_SPRITE_COUNT; i++) {
+            ska_sprite_culling_bounds_add(bounds, &models[i], destSize);
+        }
+        const f64 testStartTime = benchmark_get_time_ms();
+        visibleCount = ska_sprite_culling_test_view(bounds, &view, visible);
+        testTime += benchmark_get_time_ms() - testStartTime;
+        usize instanceCount = 0;
+        for (usize i = 0; i < SPRITE_CULLING_SPRITE_COUNT; i++) {
+            if (visible[i]) {
+                ska_sprite_batch_write_sprite_instance2(&instances[instanceCount++], &texture, &sourceRect, destSize, &color, false, false, &models[i]);
+            }
+        }
+        checksum += instances[frame % instanceCount].modelOrigin[0];
+    }
+    benchmark_stop("sprite culling 50k sprites x100 (bounds + view test)");
+    printf("[benchmark] %-56s %10.3f ms\n", "  of which view test", testTime);
+    printf("[benchmark] sprite culling visible = %zu / %d, checksum = %f\n", visibleCount, SPRITE_CULLING_SPRITE_COUNT, (f64)checksum);
+    SKA_FREE(visible);
+    ska_sprite_culling_bounds_destroy(bounds);
+    SKA_FREE(instances);
+    SKA_FREE(models);
+}
+
+#endif // #if SKA_RENDERING
+
+#if SKA_RENDERING && SKA_BENCHMARK_HEADLESS_GL
+// Renderer benchmarks on a surfaceless EGL context (e.g. Mesa llvmpipe), enabled with the 'SEIKA_BENCHMARK_HEADLESS_GL' cmake option
+#define RENDERER_RESOLUTION 256
+#define RENDERER_SPRITE_COUNT 50000
+#define RENDERER_TEXTURE_COUNT 16
+#define RENDERER_FRAME_COUNT 30
+#define RENDERER_TEXT_COUNT 1000
+
+static bool benchmark_create_headless_gl_context(void) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay == NULL) {
+        return false;
+    }
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL) || !eglBindAPI(EGL_OPENGL_API)) {
+        return false;
+    }
+    const EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config;
+    EGLint configCount = 0;
+    eglChooseConfig(display, configAttributes, &config, 1, &configCount);
+    const EGLint contextAttributes[] = { EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3, EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+    EGLContext context = eglCreateContext(display, configCount > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        return false;
+    }
+    return gladLoadGLLoader((GLADloadproc)eglGetProcAddress) != 0;
+}
+
+// With 'useAtlas' the textures share an atlas page, so each z index is a single batch instead of one per texture
+static void benchmark_renderer_sprite_mode(SkaRendererSpriteMode spriteMode, bool useAtlas, const char* name) {
+    ska_renderer_initialize2(RENDERER_RESOLUTION, RENDERER_RESOLUTION, RENDERER_RESOLUTION, RENDERER_RESOLUTION, false, spriteMode);
+    SkaTextureAtlas* atlas = useAtlas ? ska_texture_atlas_create(256) : NULL;
+    unsigned char pixels[4 * 4 * 4];
+    memset(pixels, 255, sizeof(pixels));
+    SkaTexture* textures[RENDERER_TEXTURE_COUNT];
+    for (usize i = 0; i < RENDERER_TEXTURE_COUNT; i++) {
+        textures[i] = useAtlas ? ska_texture_atlas_add_image(atlas, pixels, 4, 4, 4, true) : ska_texture_create_solid_colored_texture(4, 4, 255);
+    }
+    const SkaColor backgroundColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 4.0f, 4.0f };
+    const SkaSize2D destSize = { 4.0f, 4.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    f64 flushTime = 0.0;
+    benchmark_start();
+    for (usize frame = 0; frame < RENDERER_FRAME_COUNT; frame++) {
+        for (usize i = 0; i < RENDERER_SPRITE_COUNT; i++) {
+            const SkaTransform2D transform = { .position = { (f32)(i % RENDERER_RESOLUTION), (f32)((i / RENDERER_RESOLUTION) % RENDERER_RESOLUTION) }, .scale = { 1.0f, 1.0f }, .rotation = (f32)(i % 360) };
+            ska_renderer_queue_sprite_draw(textures[i % RENDERER_TEXTURE_COUNT], sourceRect, destSize, color, false, false, &transform, (int32)((i / RENDERER_TEXTURE_COUNT) % 4), NULL);
+        }
+        const f64 flushStartTime = benchmark_get_time_ms();
+        ska_renderer_process_and_flush_batches_just_framebuffer(&backgroundColor);
+        flushTime += benchmark_get_time_ms() - flushStartTime;
+        glFinish();
+    }
+    benchmark_stop(name);
+    printf("[benchmark] %-56s %10.3f ms\n", "  of which flush (cpu submission)", flushTime);
+    for (usize i = 0; i < RENDERER_TEXTURE_COUNT; i++) {
+        ska_texture_delete(textures[i]);
+    }
+    if (atlas != NULL) {
+        ska_texture_atlas_destroy(atlas);
+    }
+    ska_renderer_finalize();
+}
+
+// 50k sprites in a world about 10 times the resolution's area, with and without culling
+static void benchmark_renderer_culling(bool useCulling, const char* name) {
+    ska_renderer_initialize2((int32)SPRITE_CULLING_VIEW_SIZE, (int32)SPRITE_CULLING_VIEW_SIZE, (int32)SPRITE_CULLING_VIEW_SIZE, (int32)SPRITE_CULLING_VIEW_SIZE, false, SkaRendererSpriteMode_INSTANCED);
+    ska_renderer_set_sprite_culling_enabled(useCulling);
+    SkaTexture* texture = ska_texture_create_solid_colored_texture(4, 4, 255);
+    SkaAffine2D* models = (SkaAffine2D*)SKA_ALLOC_BYTES(SPRITE_CULLING_SPRITE_COUNT * sizeof(SkaAffine2D));
+    benchmark_sprite_culling_fill_models(models);
+    const SkaColor backgroundColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 4.0f, 4.0f };
+    const SkaSize2D destSize = { 32.0f, 32.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    benchmark_start();
+    for (usize frame = 0; frame < RENDERER_FRAME_COUNT; frame++) {
+        for (usize i = 0; i < SPRITE_CULLING_SPRITE_COUNT; i++) {
+            mat4 model;
+            ska_affine2d_to_mat4(&models[i], model);
+            ska_renderer_queue_sprite_draw2(texture, sourceRect, destSize, color, false, false, model, 0, NULL);
+        }
+        ska_renderer_process_and_flush_batches_just_framebuffer(&backgroundColor);
+        glFinish();
+    }
+    benchmark_stop(name);
+    const SkaRendererStats stats = ska_renderer_get_stats();
+    printf("[benchmark] %-56s %zu / %zu\n", "  drawn / submitted sprites", stats.drawnSprites, stats.submittedSprites);
+    SKA_FREE(models);
+    ska_texture_delete(texture);
+    ska_renderer_set_sprite_culling_enabled(false);
+    ska_renderer_finalize();
+}
+
+// 1k strings per frame over two z indices, the font file is taken from the 'SEIKA_BENCHMARK_FONT' environment variable.
+// With 'useLayouts' the unchanged strings are drawn from cached text layouts instead of being laid out every frame.
+static void benchmark_renderer_text(bool useLayouts, const char* name) {
+    const char* fontPath = getenv("SEIKA_BENCHMARK_FONT");
+    if (fontPath == NULL) {
+        printf("[benchmark] 'SEIKA_BENCHMARK_FONT' not set, skipping text benchmark\n");
+        return;
+    }
+    ska_renderer_initialize2(RENDERER_RESOLUTION, RENDERER_RESOLUTION, RENDERER_RESOLUTION, RENDERER_RESOLUTION, false, SkaRendererSpriteMode_INSTANCED);
+    SkaFont* font = ska_font_create_font(fontPath, 16, false);
+    if (!font->isValid) {
+        printf("[benchmark] failed to load font '%s', skipping text benchmark\n", fontPath);
+        ska_font_delete(font);
+        ska_renderer_finalize();
+        return;
+    }
+    static char texts[RENDERER_TEXT_COUNT][24];
+    static SkaTextLayout* layouts[RENDERER_TEXT_COUNT];
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (usize i = 0; i < RENDERER_TEXT_COUNT; i++) {
+        snprintf(texts[i], sizeof(texts[i]), "Score: %05zu HP: %03zu", (i * 7919) % 100000, i % 1000);
+        if (useLayouts) {
+            layouts[i] = ska_text_layout_create(font, texts[i], 1.0f, 0.0f);
+            ska_text_layout_set_position(layouts[i], (SkaVector2){ (f32)(i % 8) * 32.0f, (f32)(i % RENDERER_RESOLUTION) });
+            // Laid out up front, so the frames measure reusing the cached quads
+            ska_text_layout_update(layouts[i]);
+        }
+    }
+    const SkaColor backgroundColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    f64 flushTime = 0.0;
+    benchmark_start();
+    for (usize frame = 0; frame < RENDERER_FRAME_COUNT; frame++) {
+        for (usize i = 0; i < RENDERER_TEXT_COUNT; i++) {
+            if (useLayouts) {
+                ska_renderer_queue_text_layout_draw_call(layouts[i], (int32)(i % 2));
+            } else {
+                ska_renderer_queue_font_draw_call(font, texts[i], (f32)(i % 8) * 32.0f, (f32)(i % RENDERER_RESOLUTION), 1.0f, color, (int32)(i % 2));
+            }
+        }
+        const f64 flushStartTime = benchmark_get_time_ms();
+        ska_renderer_process_and_flush_batches_just_framebuffer(&backgroundColor);
+        flushTime += benchmark_get_time_ms() - flushStartTime;
+        glFinish();
+    }
+    benchmark_stop(name);
+    printf("[benchmark] %-56s %10.3f ms\n", "  of which flush (cpu submission)", flushTime);
+    printf("[benchmark] %-56s %zu\n", "  draw calls per frame", ska_renderer_get_stats().drawCalls);
+    if (useLayouts) {
+        for (usize i = 0; i < RENDERER_TEXT_COUNT; i++) {
+            ska_text_layout_destroy(layouts[i]);
+        }
+    }
+    ska_font_delete(font);
+    ska_renderer_finalize();
+}
+
+#define FONT_SIZE_COUNT 5
+
+// A ui using 5 text sizes, as 5 bitmap fonts or a single sdf font scaled to each size
+static void benchmark_font_sizes(SkaFontRenderMode renderMode, const char* name) {
+    const char* fontPath = getenv("SEIKA_BENCHMARK_FONT");
+    if (fontPath == NULL) {
+        return;
+    }
+    static const int32 sizes[FONT_SIZE_COUNT] = { 12, 16, 24, 32, 48 };
+    const usize fontCount = renderMode == SkaFontRenderMode_SDF ? 1 : FONT_SIZE_COUNT;
+    SkaFont* fonts[FONT_SIZE_COUNT];
+    ska_renderer_initialize2(RENDERER_RESOLUTION, RENDERER_RESOLUTION, RENDERER_RESOLUTION, RENDERER_RESOLUTION, false, SkaRendererSpriteMode_INSTANCED);
+    benchmark_start();
+    for (usize i = 0; i < fontCount; i++) {
+        fonts[i] = ska_font_create_font2(fontPath, renderMode == SkaFontRenderMode_SDF ? 32 : sizes[i], false, renderMode);
+        // Printable ascii
+        for (uint32 codepoint = 32; codepoint < 127; codepoint++) {
+            ska_font_get_character(fonts[i], codepoint);
+        }
+    }
+    glFinish();
+    benchmark_stop(name);
+    usize atlasBytes = 0;
+    for (usize i = 0; i < fontCount; i++) {
+        atlasBytes += (usize)fonts[i]->glyphCache->atlasSize * (usize)fonts[i]->glyphCache->atlasSize;
+        ska_font_delete(fonts[i]);
+    }
+    printf("[benchmark] %-56s %zu KiB\n", "  atlas memory", atlasBytes / 1024);
+    ska_renderer_finalize();
+}
+#undef FONT_SIZE_COUNT
+
+static void benchmark_renderer(void) {
+    if (!benchmark_create_headless_gl_context()) {
+        printf("[benchmark] failed to create headless gl context, skipping renderer benchmarks\n");
+        return;
+    }
+    printf("[benchmark] renderer on '%s'\n", (const char*)glGetString(GL_RENDERER));
+    benchmark_renderer_sprite_mode(SkaRendererSpriteMode_VERTICES, false, "renderer 50k sprites x30 frames (vertices)");
+    benchmark_renderer_sprite_mode(SkaRendererSpriteMode_INSTANCED, false, "renderer 50k sprites x30 frames (instanced)");
+    benchmark_renderer_sprite_mode(SkaRendererSpriteMode_INSTANCED, true, "renderer 50k sprites x30 frames (instanced, atlas)");
+    benchmark_renderer_culling(false, "renderer 50k sprites x30 frames, 10% visible (no culling)");
+    benchmark_renderer_culling(true, "renderer 50k sprites x30 frames, 10% visible (culling)");
+    benchmark_renderer_text(false, "renderer 1k strings x30 frames");
+    benchmark_renderer_text(true, "renderer 1k strings x30 frames (text layouts)");
+    benchmark_font_sizes(SkaFontRenderMode_BITMAP, "font 5 sizes x95 glyphs (5 bitmap fonts)");
+    benchmark_font_sizes(SkaFontRenderMode_SDF, "font 5 sizes x95 glyphs (1 sdf font)");
+}
+
+#undef RENDERER_TEXT_COUNT
+#undef RENDERER_FRAME_COUNT
+#undef RENDERER_TEXTURE_COUNT
+#undef RENDERER_SPRITE_COUNT
+#undef RENDERER_RESOLUTION
+#endif // #if SKA_RENDERING && SKA_BENCHMARK_HEADLESS_GL
+
+#if SKA_RENDERING
+#undef SPRITE_CULLING_WORLD_SIZE
+#undef SPRITE_CULLING_VIEW_SIZE
+#undef SPRITE_CULLING_FRAME_COUNT
+#undef SPRITE_CULLING_SPRITE_COUNT
+#endif
+
+int32 main(int32 argv, char** args) {
+#if SKA_ECS
+    benchmark_ecs_entity_churn();
+    benchmark_ecs_entity_is_alive();
+    benchmark_ecs_spawn();
+    benchmark_ecs_snapshot();
+#endif
+    benchmark_job_system();
+    benchmark_job_coroutine_latency();
+    benchmark_ring_buffers();
+    benchmark_sync_primitives();
+#if SKA_RENDERING
+    benchmark_sprite_draw_buffers();
+    benchmark_sprite_batch_build();
+    benchmark_affine2d();
+    benchmark_render_queue();
+    benchmark_sprite_culling();
+#endif
+#if SKA_RENDERING && SKA_BENCHMARK_HEADLESS_GL
+    benchmark_renderer();
+#endif
+    return 0;
+}
@@ -1,16 +1,34 @@
 #include <unity.h>
 #include <string.h>
+#include "seika/thread/atomic.h"
 
 #include "seika/memory.h"
+#include "seika/string.h"
 #include "seika/event.h"
 #include "seika/asset/asset_file_loader.h"
 #include "seika/data_structures/array2d.h"
 #include "seika/data_structures/array_list.h"
+#include "seika/data_structures/array_utils.h"
 #include "seika/data_structures/id_queue.h"
 #include "seika/data_structures/spatial_hash_map.h"
 #include "seika/math/curve_float.h"
 #include "seika/rendering/shader/shader_instance.h"
 #include "seika/rendering/shader/shader_file_parser.h"
+#include "seika/rendering/sprite_draw_buffer.h"
+#include "seika/rendering/sprite_batch.h"
+#include "seika/rendering/rect_packer.h"
+#include "seika/rendering/render_queue.h"
+#include "seika/rendering/stream_ring.h"
+#include "seika/rendering/sprite_culling.h"
+#include "seika/rendering/glyph_cache.h"
+#include "seika/rendering/distance_field.h"
+#include "seika/thread/thread_pool.h"
+#include "seika/thread/sync.h"
+
+#define SKA_SPSC_RING_BUFFER_TEMPLATE uint32
+#include "seika/data_structures/spsc_ring_buffer_template.h"
+#define SKA_MPMC_RING_BUFFER_TEMPLATE uint32
+#include "seika/data_structures/mpmc_ring_buffer_template.h"
 
 #if SKA_ECS
 #include "seika/ecs/ecs.h"
@@ -28,20 +46,41 @@ void setUp(void) {}
 void tearDown(void) {}
 
 void seika_mem_test(void);
+void seika_string_utf8_test(void);
 void seika_array_list_test(void);
 void seika_hash_map_test(void);
 void seika_spatial_hash_map_test(void);
 void seika_array2d_test(void);
+void seika_array_utils_sort_test(void);
 void seika_id_queue_test(void);
+void seika_spsc_ring_buffer_test(void);
+void seika_mpmc_ring_buffer_test(void);
 
 void seika_asset_file_loader_test(void);
 void seika_observer_test(void);
 void seika_curve_float_test(void);
+void seika_affine2d_test(void);
 void seika_shader_instance_test(void);
 void seika_shader_file_parser_test(void);
+void seika_sprite_draw_buffer_test(void);
+void seika_rect_packer_test(void);
+void seika_render_queue_test(void);
+void seika_stream_ring_test(void);
+void seika_sprite_culling_test(void);
+void seika_glyph_cache_test(void);
+void seika_distance_field_test(void);
+void seika_sync_primitives_test(void);
+void seika_job_system_test(void);
+void seika_job_counter_test(void);
+void seika_job_coroutine_test(void);
+void seika_job_system_stats_test(void);
 
 #if SKA_ECS
 void seika_ecs_test(void);
+void seika_ecs_query_test(void);
+void seika_ecs_spawn_batch_test(void);
+void seika_ecs_change_detection_test(void);
+void seika_ecs_snapshot_test(void);
 #endif
 
 #if SKA_INPUT
@@ -51,18 +90,39 @@ void seika_input_test(void);
 int32 main(int32 argv, char** args) {
     UNITY_BEGIN();
     RUN_TEST(seika_mem_test);
+    RUN_TEST(seika_string_utf8_test);
     RUN_TEST(seika_array_list_test);
     RUN_TEST(seika_hash_map_test);
     RUN_TEST(seika_spatial_hash_map_test);
     RUN_TEST(seika_array2d_test);
+    RUN_TEST(seika_array_utils_sort_test);
     RUN_TEST(seika_id_queue_test);
+    RUN_TEST(seika_spsc_ring_buffer_test);
+    RUN_TEST(seika_mpmc_ring_buffer_test);
     RUN_TEST(seika_asset_file_loader_test);
     RUN_TEST(seika_observer_test);
     RUN_TEST(seika_curve_float_test);
+    RUN_TEST(seika_affine2d_test);
     RUN_TEST(seika_shader_instance_test);
     RUN_TEST(seika_shader_file_parser_test);
+    RUN_TEST(seika_sprite_draw_buffer_test);
+    RUN_TEST(seika_rect_packer_test);
+    RUN_TEST(seika_render_queue_test);
+    RUN_TEST(seika_stream_ring_test);
+    RUN_TEST(seika_sprite_culling_test);
+    RUN_TEST(seika_glyph_cache_test);
+    RUN_TEST(seika_distance_field_test);
+    RUN_TEST(seika_sync_primitives_test);
+    RUN_TEST(seika_job_system_test);
+    RUN_TEST(seika_job_counter_test);
+    RUN_TEST(seika_job_coroutine_test);
+    RUN_TEST(seika_job_system_stats_test);
 #if SKA_ECS
     RUN_TEST(seika_ecs_test);
+    RUN_TEST(seika_ecs_query_test);
+    RUN_TEST(seika_ecs_spawn_batch_test);
+    RUN_TEST(seika_ecs_change_detection_test);
+    RUN_TEST(seika_ecs_snapshot_test);
 #endif
 #if SKA_INPUT
     RUN_TEST(seika_input_test);
@@ -80,6 +140,27 @@ void seika_mem_test(void) {
     TEST_ASSERT_FALSE(ska_mem_report_leaks());
 }
 
+void seika_string_utf8_test(void) {
+    // 'A', e acute, euro sign, musical g clef
+    const char* text = "A\xC3\xA9\xE2\x82\xAC\xF0\x9D\x84\x9E";
+    const uint32 expectedCodepoints[] = { 0x41, 0xE9, 0x20AC, 0x1D11E };
+    for (usize i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expectedCodepoints[i], ska_str_utf8_decode_next(&text));
+    }
+    TEST_ASSERT_EQUAL_INT('\0', *text);
+
+    // Stray continuation byte, overlong encoding, surrogate and a truncated sequence each skip a single byte
+    const char* malformedText = "\x80" "\xC0\xAF" "\xED\xA0\x80" "\xE2\x82";
+    const char* malformedEnd = malformedText + strlen(malformedText);
+    usize replacementCount = 0;
+    while (*malformedText != '\0') {
+        TEST_ASSERT_EQUAL_UINT32(SKA_STR_UTF8_REPLACEMENT_CHARACTER, ska_str_utf8_decode_next(&malformedText));
+        replacementCount++;
+    }
+    TEST_ASSERT_EQUAL_PTR(malformedEnd, malformedText);
+    TEST_ASSERT_EQUAL_size_t(8, replacementCount);
+}
+
 static bool array_list_compare(const void* a, const void* b) {
     return ((int32)*(int32*)a == (int32)*(int32*)b);
 }
@@ -145,6 +226,123 @@ void seika_id_queue_test(void) {
     TEST_ASSERT_EQUAL_size_t(20, idQueue->capacity);
 }
 
+#define TEST_RING_BUFFER_ITEM_COUNT 100000
+#define TEST_RING_BUFFER_THREAD_COUNT 4
+
+static void* test_spsc_ring_buffer_producer(void* arg) {
+    SkaSPSCRingBuffer_uint32* ringBuffer = (SkaSPSCRingBuffer_uint32*)arg;
+    for (uint32 i = 0; i < TEST_RING_BUFFER_ITEM_COUNT; i++) {
+        while (!ska_spsc_ring_buffer_uint32_try_push(ringBuffer, i)) {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+void seika_spsc_ring_buffer_test(void) {
+    SkaSPSCRingBuffer_uint32* ringBuffer = ska_spsc_ring_buffer_uint32_create(3);
+    TEST_ASSERT_EQUAL_size_t(4, ringBuffer->capacity);
+    uint32 value = 0;
+    TEST_ASSERT_FALSE(ska_spsc_ring_buffer_uint32_try_pop(ringBuffer, &value));
+    // Fill and wrap around
+    for (uint32 i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ska_spsc_ring_buffer_uint32_try_push(ringBuffer, i));
+    }
+    TEST_ASSERT_FALSE(ska_spsc_ring_buffer_uint32_try_push(ringBuffer, 4));
+    TEST_ASSERT_EQUAL_size_t(4, ska_spsc_ring_buffer_uint32_get_size(ringBuffer));
+    TEST_ASSERT_TRUE(ska_spsc_ring_buffer_uint32_try_pop(ringBuffer, &value));
+    TEST_ASSERT_EQUAL_UINT32(0, value);
+    TEST_ASSERT_TRUE(ska_spsc_ring_buffer_uint32_try_push(ringBuffer, 4));
+    for (uint32 i = 1; i <= 4; i++) {
+        TEST_ASSERT_TRUE(ska_spsc_ring_buffer_uint32_try_pop(ringBuffer, &value));
+        TEST_ASSERT_EQUAL_UINT32(i, value);
+    }
+    TEST_ASSERT_TRUE(ska_spsc_ring_buffer_uint32_is_empty(ringBuffer));
+    ska_spsc_ring_buffer_uint32_destroy(ringBuffer);
+
+    // Items arrive in order across threads
+    ringBuffer = ska_spsc_ring_buffer_uint32_create(64);
+    pthread_t producerThread;
+    pthread_create(&producerThread, NULL, test_spsc_ring_buffer_producer, ringBuffer);
+    uint32 outOfOrderCount = 0;
+    for (uint32 expected = 0; expected < TEST_RING_BUFFER_ITEM_COUNT; expected++) {
+        while (!ska_spsc_ring_buffer_uint32_try_pop(ringBuffer, &value)) {
+            pcthread_yield();
+        }
+        outOfOrderCount += value != expected ? 1 : 0;
+    }
+    pthread_join(producerThread, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrderCount);
+    ska_spsc_ring_buffer_uint32_destroy(ringBuffer);
+}
+
+static SkaMPMCRingBuffer_uint32* testMPMCRingBuffer = NULL;
+static SKA_ATOMIC(uint64) mpmcPoppedSum = 0;
+static SKA_ATOMIC(uint32) mpmcPoppedCount = 0;
+
+static void* test_mpmc_ring_buffer_producer(void* arg) {
+    const uint32 producerIndex = (uint32)(uintptr_t)arg;
+    for (uint32 i = 0; i < TEST_RING_BUFFER_ITEM_COUNT; i++) {
+        while (!ska_mpmc_ring_buffer_uint32_try_push(testMPMCRingBuffer, producerIndex * TEST_RING_BUFFER_ITEM_COUNT + i)) {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* test_mpmc_ring_buffer_consumer(void* arg) {
+    uint32 value = 0;
+    while (ska_atomic_load(&mpmcPoppedCount, SkaMemoryOrder_SEQ_CST) < TEST_RING_BUFFER_THREAD_COUNT * TEST_RING_BUFFER_ITEM_COUNT) {
+        if (ska_mpmc_ring_buffer_uint32_try_pop(testMPMCRingBuffer, &value)) {
+            ska_atomic_fetch_add(&mpmcPoppedSum, value, SkaMemoryOrder_SEQ_CST);
+            ska_atomic_fetch_add(&mpmcPoppedCount, 1, SkaMemoryOrder_SEQ_CST);
+        } else {
+            pcthread_yield();
+        }
+    }
+    return NULL;
+}
+
+void seika_mpmc_ring_buffer_test(void) {
+    testMPMCRingBuffer = ska_mpmc_ring_buffer_uint32_create(4);
+    uint32 value = 0;
+    TEST_ASSERT_FALSE(ska_mpmc_ring_buffer_uint32_try_pop(testMPMCRingBuffer, &value));
+    for (uint32 i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ska_mpmc_ring_buffer_uint32_try_push(testMPMCRingBuffer, i + 10));
+    }
+    TEST_ASSERT_FALSE(ska_mpmc_ring_buffer_uint32_try_push(testMPMCRingBuffer, 14));
+    for (uint32 i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ska_mpmc_ring_buffer_uint32_try_pop(testMPMCRingBuffer, &value));
+        TEST_ASSERT_EQUAL_UINT32(i + 10, value);
+    }
+    TEST_ASSERT_TRUE(ska_mpmc_ring_buffer_uint32_is_empty(testMPMCRingBuffer));
+    ska_mpmc_ring_buffer_uint32_destroy(testMPMCRingBuffer);
+
+    // Every pushed item is popped exactly once
+    testMPMCRingBuffer = ska_mpmc_ring_buffer_uint32_create(256);
+    ska_atomic_store(&mpmcPoppedSum, 0, SkaMemoryOrder_SEQ_CST);
+    ska_atomic_store(&mpmcPoppedCount, 0, SkaMemoryOrder_SEQ_CST);
+    pthread_t producerThreads[TEST_RING_BUFFER_THREAD_COUNT];
+    pthread_t consumerThreads[TEST_RING_BUFFER_THREAD_COUNT];
+    for (usize i = 0; i < TEST_RING_BUFFER_THREAD_COUNT; i++) {
+        pthread_create(&producerThreads[i], NULL, test_mpmc_ring_buffer_producer, (void*)(uintptr_t)i);
+        pthread_create(&consumerThreads[i], NULL, test_mpmc_ring_buffer_consumer, NULL);
+    }
+    for (usize i = 0; i < TEST_RING_BUFFER_THREAD_COUNT; i++) {
+        pthread_join(producerThreads[i], NULL);
+        pthread_join(consumerThreads[i], NULL);
+    }
+    const uint64 itemCount = (uint64)TEST_RING_BUFFER_THREAD_COUNT * TEST_RING_BUFFER_ITEM_COUNT;
+    TEST_ASSERT_EQUAL_UINT32((uint32)itemCount, ska_atomic_load(&mpmcPoppedCount, SkaMemoryOrder_SEQ_CST));
+    TEST_ASSERT_EQUAL_UINT64(itemCount * (itemCount - 1) / 2, ska_atomic_load(&mpmcPoppedSum, SkaMemoryOrder_SEQ_CST));
+    TEST_ASSERT_TRUE(ska_mpmc_ring_buffer_uint32_is_empty(testMPMCRingBuffer));
+    ska_mpmc_ring_buffer_uint32_destroy(testMPMCRingBuffer);
+    testMPMCRingBuffer = NULL;
+}
+
+#undef TEST_RING_BUFFER_THREAD_COUNT
+#undef TEST_RING_BUFFER_ITEM_COUNT
+
 void seika_hash_map_test(void) {
     SkaHashMap* hashMap = ska_hash_map_create(sizeof(int32), sizeof(int32), SKA_HASH_MAP_MIN_CAPACITY);
     TEST_ASSERT_NOT_NULL(hashMap);
@@ -269,6 +467,50 @@ void seika_array2d_test(void) {
     ska_array2d_destroy(array2D);
 }
 
+#define TEST_SORT_SIZE 500
+
+typedef struct TestSortItem {
+    int32 key;
+    int32 order;
+} TestSortItem;
+
+static int32 test_sort_item_compare(const void* a, const void* b) {
+    return ((const TestSortItem*)a)->key - ((const TestSortItem*)b)->key;
+}
+
+void seika_array_utils_sort_test(void) {
+    int32 values[TEST_SORT_SIZE];
+    for (int32 i = 0; i < TEST_SORT_SIZE; i++) {
+        values[i] = ((i * 7919) % 211) - 100;
+    }
+    ska_array_utils_sort_int(values, TEST_SORT_SIZE);
+    for (usize i = 1; i < TEST_SORT_SIZE; i++) {
+        TEST_ASSERT_TRUE(values[i - 1] <= values[i]);
+    }
+    int32 smallValues[] = { 3, -1, 2, 2, 0 };
+    ska_array_utils_selection_sort_int(smallValues, 5);
+    const int32 expectedSmallValues[] = { -1, 0, 2, 2, 3 };
+    for (usize i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_INT32(expectedSmallValues[i], smallValues[i]);
+    }
+
+    // Items with equal keys keep their original order
+    TestSortItem items[TEST_SORT_SIZE];
+    TestSortItem scratch[TEST_SORT_SIZE];
+    for (int32 i = 0; i < TEST_SORT_SIZE; i++) {
+        items[i] = (TestSortItem){ .key = (i * 104729) % 13, .order = i };
+    }
+    ska_array_utils_merge_sort(items, scratch, TEST_SORT_SIZE, sizeof(TestSortItem), test_sort_item_compare);
+    for (usize i = 1; i < TEST_SORT_SIZE; i++) {
+        TEST_ASSERT_TRUE(items[i - 1].key <= items[i].key);
+        if (items[i - 1].key == items[i].key) {
+            TEST_ASSERT_TRUE(items[i - 1].order < items[i].order);
+        }
+    }
+}
+
+#undef TEST_SORT_SIZE
+
 void seika_asset_file_loader_test(void) {
     ska_asset_file_loader_initialize();
 
@@ -345,6 +587,20 @@ void seika_curve_float_test(void) {
     ska_curve_float_remove_control_point(&curve, point2.x, point2.y);
     TEST_ASSERT_EQUAL_UINT(1, curve.controlPointCount);
 
+    // Points are kept ordered by x however they are added
+    SkaCurveControlPoint points[] = {
+        { .x = 3.0, .y = 3.0 }, { .x = -1.0, .y = -1.0 }, { .x = 2.0, .y = 2.0 }
+    };
+    ska_curve_float_add_control_points(&curve, points, 3);
+    ska_curve_float_add_control_point(&curve, (SkaCurveControlPoint){ .x = 1.0, .y = 1.0 });
+    TEST_ASSERT_EQUAL_UINT(5, curve.controlPointCount);
+    for (usize i = 0; i < curve.controlPointCount; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE((f64)i - 1.0, curve.controlPoints[i].x);
+    }
+    TEST_ASSERT_TRUE(ska_curve_float_remove_control_point(&curve, 1.0, 1.0));
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, curve.controlPoints[2].x);
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, curve.controlPoints[3].x);
+
     // TODO: Write performance tests
 //    SE_PROFILE_CODE(
 //        for (int32 i = 0; i < 10000000; i++) {}
@@ -355,6 +611,58 @@ void seika_curve_float_test(void) {
 //    printf("Time taken: %f seconds\n", cpu_time_used);
 }
 
+#define TEST_AFFINE2D_QUAD_COUNT 5
+
+void seika_affine2d_test(void) {
+    // Matches the mat4 built by cglm
+    const SkaTransform2D transform = { .position = { 10.0f, -4.0f }, .scale = { 2.0f, -3.0f }, .rotation = 30.0f };
+    mat4 matrix;
+    ska_transform2d_transform_to_mat4(&transform, matrix);
+    SkaAffine2D affine;
+    ska_affine2d_from_transform(&transform, &affine);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, matrix[0][0], affine.xAxis[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, matrix[0][1], affine.xAxis[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, matrix[1][0], affine.yAxis[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, matrix[1][1], affine.yAxis[1]);
+    TEST_ASSERT_EQUAL_FLOAT(matrix[3][0], affine.origin[0]);
+    TEST_ASSERT_EQUAL_FLOAT(matrix[3][1], affine.origin[1]);
+    mat4 roundTrip;
+    ska_affine2d_to_mat4(&affine, roundTrip);
+    SkaAffine2D affineFromMatrix;
+    ska_affine2d_from_mat4(roundTrip, &affineFromMatrix);
+    TEST_ASSERT_EQUAL_MEMORY(&affine, &affineFromMatrix, sizeof(SkaAffine2D));
+
+    // Parent translates by (100, 0) and doubles, child point (1, 1) ends up at (102, 2)
+    const SkaAffine2D parent = { .xAxis = { 2.0f, 0.0f }, .yAxis = { 0.0f, 2.0f }, .origin = { 100.0f, 0.0f } };
+    const SkaAffine2D child = { .xAxis = { 1.0f, 0.0f }, .yAxis = { 0.0f, 1.0f }, .origin = { 1.0f, 1.0f } };
+    SkaAffine2D combined;
+    ska_affine2d_multiply(&parent, &child, &combined);
+    const SkaVector2 point = ska_affine2d_transform_point(&combined, SKA_VECTOR2_ZERO);
+    TEST_ASSERT_EQUAL_FLOAT(102.0f, point.x);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, point.y);
+
+    // Batch kernel against single points, an odd count covers the simd remainder
+    SkaAffine2D affines[TEST_AFFINE2D_QUAD_COUNT];
+    SkaSize2D sizes[TEST_AFFINE2D_QUAD_COUNT];
+    for (usize i = 0; i < TEST_AFFINE2D_QUAD_COUNT; i++) {
+        const SkaTransform2D quadTransform = { .position = { (f32)i * 5.0f, 1.0f }, .scale = { 1.0f, 1.0f + (f32)i }, .rotation = (f32)i * 45.0f };
+        ska_affine2d_from_transform(&quadTransform, &affines[i]);
+        sizes[i] = (SkaSize2D){ 4.0f + (f32)i, 2.0f };
+    }
+    SkaVector2 corners[TEST_AFFINE2D_QUAD_COUNT * 4];
+    ska_affine2d_transform_quads(affines, sizes, TEST_AFFINE2D_QUAD_COUNT, corners);
+    for (usize i = 0; i < TEST_AFFINE2D_QUAD_COUNT; i++) {
+        const SkaVector2 localCorners[4] = { { 0.0f, 0.0f }, { sizes[i].w, 0.0f }, { 0.0f, sizes[i].h }, { sizes[i].w, sizes[i].h } };
+        for (usize c = 0; c < 4; c++) {
+            const SkaVector2 expected = ska_affine2d_transform_point(&affines[i], localCorners[c]);
+            TEST_ASSERT_FLOAT_WITHIN(0.0001f, expected.x, corners[i * 4 + c].x);
+            TEST_ASSERT_FLOAT_WITHIN(0.0001f, expected.y, corners[i * 4 + c].y);
+        }
+    }
+}
+
+#undef TEST_AFFINE2D_QUAD_COUNT
+
 void seika_shader_instance_test(void) {
     // Shader instance param tests
     SkaShaderInstance shaderInstance = { .shader = NULL, .paramMap = ska_string_hash_map_create_default_capacity() };
@@ -404,6 +712,779 @@ void seika_shader_file_parser_test(void) {
     ska_shader_file_parse_clear_parse_result(&result);
 }
 
+void seika_sprite_draw_buffer_test(void) {
+    SkaTexture textureA = { .id = 1 };
+    SkaTexture textureB = { .id = 2 };
+    SkaShaderInstance shaderInstance = {0};
+    const SkaRect2 sourceRect = { 0.0f, 0.0f, 32.0f, 32.0f };
+    const SkaSize2D destSize = { 32.0f, 32.0f };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    const SkaTransform2D transform = { .position = { 10.0f, 20.0f }, .scale = { 1.0f, 1.0f }, .rotation = 0.0f };
+
+    SkaSpriteDrawBuffer* bufferA = ska_sprite_draw_buffer_create(4);
+    SkaSpriteDrawBuffer* bufferB = ska_sprite_draw_buffer_create(4);
+    // Buffer A: (z 1, texture B), (z 0, texture A), (z 1, texture A)
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferA, &textureB, sourceRect, destSize, color, false, false, &transform, 1, NULL));
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferA, &textureA, sourceRect, destSize, color, false, false, &transform, 0, NULL));
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferA, &textureA, sourceRect, destSize, color, false, false, &transform, 1, NULL));
+    TEST_ASSERT_FALSE(ska_sprite_draw_buffer_queue_sprite(bufferA, NULL, sourceRect, destSize, color, false, false, &transform, 1, NULL));
+    // Buffer B: (z -1, texture A), (z 1, texture B), (z 0, texture A + shader)
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferB, &textureA, sourceRect, destSize, color, false, false, &transform, -1, NULL));
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferB, &textureB, sourceRect, destSize, color, true, false, &transform, 1, NULL));
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferB, &textureA, sourceRect, destSize, color, false, false, &transform, 0, &shaderInstance));
+    TEST_ASSERT_TRUE(ska_sprite_draw_buffer_queue_sprite(bufferB, &textureA, sourceRect, destSize, color, false, false, &transform, 0, NULL));
+    // Full
+    TEST_ASSERT_FALSE(ska_sprite_draw_buffer_queue_sprite(bufferB, &textureA, sourceRect, destSize, color, false, false, &transform, 0, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, bufferA->commands[0].model.origin[0]);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, bufferA->commands[0].model.origin[1]);
+
+    TEST_ASSERT_EQUAL_INT(-1, bufferB->commands[0].zIndex);
+    TEST_ASSERT_TRUE(bufferB->commands[1].flipH);
+    TEST_ASSERT_EQUAL_PTR(&shaderInstance, bufferB->commands[2].shaderInstance);
+
+    ska_sprite_draw_buffer_clear(bufferA);
+    TEST_ASSERT_EQUAL_size_t(0, bufferA->count);
+    ska_sprite_draw_buffer_destroy(bufferA);
+    ska_sprite_draw_buffer_destroy(bufferB);
+}
+
+#define TEST_RECT_PACKER_RECT_COUNT 64
+
+void seika_rect_packer_test(void) {
+    SkaRectPacker* packer = ska_rect_packer_create(64, 64);
+    int32 rects[TEST_RECT_PACKER_RECT_COUNT][4];
+    usize rectCount = 0;
+    for (usize i = 0; i < TEST_RECT_PACKER_RECT_COUNT; i++) {
+        const int32 width = 4 + (int32)(i * 7 % 13);
+        const int32 height = 4 + (int32)(i * 5 % 11);
+        int32 x = 0;
+        int32 y = 0;
+        if (ska_rect_packer_pack(packer, width, height, &x, &y)) {
+            rects[rectCount][0] = x;
+            rects[rectCount][1] = y;
+            rects[rectCount][2] = width;
+            rects[rectCount][3] = height;
+            rectCount++;
+        }
+    }
+    TEST_ASSERT_TRUE(rectCount > 16);
+    TEST_ASSERT_TRUE(ska_rect_packer_get_occupancy(packer) > 0.5f);
+    // Packed rects are within bounds and don't overlap
+    for (usize i = 0; i < rectCount; i++) {
+        TEST_ASSERT_TRUE(rects[i][0] >= 0 && rects[i][0] + rects[i][2] <= 64);
+        TEST_ASSERT_TRUE(rects[i][1] >= 0 && rects[i][1] + rects[i][3] <= 64);
+        for (usize j = i + 1; j < rectCount; j++) {
+            const bool overlaps = rects[i][0] < rects[j][0] + rects[j][2] && rects[j][0] < rects[i][0] + rects[i][2]
+                && rects[i][1] < rects[j][1] + rects[j][3] && rects[j][1] < rects[i][1] + rects[i][3];
+            TEST_ASSERT_FALSE(overlaps);
+        }
+    }
+
+    // Too large, then a full page after clearing
+    int32 x = 0;
+    int32 y = 0;
+    TEST_ASSERT_FALSE(ska_rect_packer_pack(packer, 65, 1, &x, &y));
+    ska_rect_packer_clear(packer);
+    TEST_ASSERT_TRUE(ska_rect_packer_pack(packer, 64, 64, &x, &y));
+    TEST_ASSERT_EQUAL_INT(0, x);
+    TEST_ASSERT_EQUAL_INT(0, y);
+    TEST_ASSERT_FALSE(ska_rect_packer_pack(packer, 1, 1, &x, &y));
+    ska_rect_packer_destroy(packer);
+
+    // Atlased texture coordinates are remapped into the page
+    const SkaTexture texture = { .width = 16, .height = 8, .isAtlased = true, .atlasOffsetX = 32, .atlasOffsetY = 16, .atlasPageWidth = 64, .atlasPageHeight = 64 };
+    const SkaColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    mat4 model;
+    glm_mat4_identity(model);
+    SkaSpriteInstance instance;
+    ska_sprite_batch_write_sprite_instance(&instance, &texture, &(SkaRect2){ 0.0f, 0.0f, 16.0f, 8.0f }, (SkaSize2D){ 16.0f, 8.0f }, &color, false, false, model);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, instance.uvRect[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, instance.uvRect[1]);
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, instance.uvRect[2]);
+    TEST_ASSERT_EQUAL_FLOAT(0.375f, instance.uvRect[3]);
+    ska_sprite_batch_write_sprite_instance(&instance, &texture, &(SkaRect2){ 8.0f, 0.0f, 8.0f, 8.0f }, (SkaSize2D){ 8.0f, 8.0f }, &color, true, false, model);
+    TEST_ASSERT_EQUAL_FLOAT(47.5f / 64.0f, instance.uvRect[0]);
+    TEST_ASSERT_EQUAL_FLOAT(40.5f / 64.0f, instance.uvRect[2]);
+}
+
+#undef TEST_RECT_PACKER_RECT_COUNT
+
+#define TEST_RADIX_SORT_SIZE 1000
+
+void seika_render_queue_test(void) {
+    // Radix sort on the upper bits keeps the lower bits (original index here) in order
+    uint64 values[TEST_RADIX_SORT_SIZE];
+    uint64 scratch[TEST_RADIX_SORT_SIZE];
+    for (uint64 i = 0; i < TEST_RADIX_SORT_SIZE; i++) {
+        values[i] = (((i * 7919) % 37) << 40) | (((i * 104729) % 5) << 20) | i;
+    }
+    ska_array_utils_radix_sort_uint64(values, scratch, TEST_RADIX_SORT_SIZE, 20);
+    for (usize i = 1; i < TEST_RADIX_SORT_SIZE; i++) {
+        TEST_ASSERT_TRUE(values[i - 1] >> 20 <= values[i] >> 20);
+        if (values[i - 1] >> 20 == values[i] >> 20) {
+            TEST_ASSERT_TRUE((values[i - 1] & 0xFFFFF) < (values[i] & 0xFFFFF));
+        }
+    }
+
+    static int32 shaderA = 0;
+    SkaRenderQueue* queue = ska_render_queue_create(2);
+    ska_render_queue_push_sprite(queue, 5, NULL, 7, 0);
+    ska_render_queue_push_sprite(queue, 3, &shaderA, 7, 1);
+    ska_render_queue_push_font(queue, 3, 11, 0);
+    ska_render_queue_push_sprite(queue, 3, NULL, 9, 2);
+    ska_render_queue_push_sprite(queue, 3, NULL, 7, 3);
+    ska_render_queue_push_sprite(queue, 5, NULL, 7, 4);
+    TEST_ASSERT_EQUAL_size_t(6, queue->count);
+    ska_render_queue_sort(queue);
+    // By z index, sprites before fonts, then shader and texture in order of first appearance
+    const uint32 expectedIndices[] = { 3, 2, 1, 0, 0, 4 };
+    for (usize i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expectedIndices[i], ska_render_queue_key_get_index(queue->keys[i]));
+        TEST_ASSERT_EQUAL_INT(i == 3 ? SkaRenderQueueItemType_FONT : SkaRenderQueueItemType_SPRITE, ska_render_queue_key_get_type(queue->keys[i]));
+    }
+    TEST_ASSERT_NOT_EQUAL(ska_render_queue_key_get_batch(queue->keys[0]), ska_render_queue_key_get_batch(queue->keys[1]));
+    TEST_ASSERT_EQUAL_UINT32(ska_render_queue_key_get_batch(queue->keys[4]), ska_render_queue_key_get_batch(queue->keys[5]));
+
+    // Shader and texture numbering restarts each frame
+    ska_render_queue_clear(queue);
+    TEST_ASSERT_EQUAL_size_t(0, queue->count);
+    ska_render_queue_push_sprite(queue, 3, NULL, 9, 0);
+    ska_render_queue_push_sprite(queue, 3, NULL, 7, 1);
+    ska_render_queue_sort(queue);
+    TEST_ASSERT_EQUAL_UINT32(0, ska_render_queue_key_get_index(queue->keys[0]));
+    TEST_ASSERT_TRUE(ska_render_queue_get_memory_size(queue) > 0);
+
+    // Hidden sprites are removed, fonts are always kept
+    ska_render_queue_push_font(queue, 3, 11, 0);
+    const bool spriteVisibility[] = { false, true };
+    ska_render_queue_remove_hidden_sprites(queue, spriteVisibility);
+    TEST_ASSERT_EQUAL_size_t(2, queue->count);
+    TEST_ASSERT_EQUAL_UINT32(1, ska_render_queue_key_get_index(queue->keys[0]));
+    TEST_ASSERT_EQUAL_INT(SkaRenderQueueItemType_FONT, ska_render_queue_key_get_type(queue->keys[1]));
+
+    // Text sharing a font atlas forms one batch
+    ska_render_queue_clear(queue);
+    ska_render_queue_push_font(queue, 3, 11, 0);
+    ska_render_queue_push_font(queue, 3, 12, 1);
+    ska_render_queue_push_font(queue, 3, 11, 2);
+    ska_render_queue_sort(queue);
+    TEST_ASSERT_EQUAL_UINT32(2, ska_render_queue_key_get_index(queue->keys[1]));
+    TEST_ASSERT_EQUAL_UINT32(ska_render_queue_key_get_batch(queue->keys[0]), ska_render_queue_key_get_batch(queue->keys[1]));
+    TEST_ASSERT_NOT_EQUAL(ska_render_queue_key_get_batch(queue->keys[1]), ska_render_queue_key_get_batch(queue->keys[2]));
+
+    // Past the per frame limits handles share the overflow ordinal, the z index and type bits stay intact
+    ska_render_queue_clear(queue);
+    const uint32 overflowCount = SKA_RENDER_QUEUE_MAX_TEXTURES + 8;
+    for (uint32 i = 0; i < overflowCount; i++) {
+        ska_render_queue_push_sprite(queue, 3, NULL, 100 + i, i);
+    }
+    ska_render_queue_push_sprite(queue, 2, NULL, 100 + overflowCount - 1, overflowCount);
+    ska_render_queue_push_font(queue, 3, 100 + overflowCount - 2, 0);
+    ska_render_queue_sort(queue);
+    TEST_ASSERT_EQUAL_UINT32(overflowCount + 2, (uint32)queue->count);
+    // Lower z index first, fonts after the sprites of their z index
+    TEST_ASSERT_EQUAL_UINT32(overflowCount, ska_render_queue_key_get_index(queue->keys[0]));
+    TEST_ASSERT_EQUAL_INT(SkaRenderQueueItemType_FONT, ska_render_queue_key_get_type(queue->keys[queue->count - 1]));
+    TEST_ASSERT_TRUE(ska_render_queue_key_is_overflow(queue->keys[0]));
+    TEST_ASSERT_TRUE(ska_render_queue_key_is_overflow(queue->keys[queue->count - 1]));
+    for (uint32 i = 0; i < overflowCount; i++) {
+        const uint64 key = queue->keys[i + 1];
+        TEST_ASSERT_EQUAL_UINT32(3, (uint32)(key >> SKA_RENDER_QUEUE_KEY_Z_INDEX_SHIFT));
+        TEST_ASSERT_EQUAL_INT(SkaRenderQueueItemType_SPRITE, ska_render_queue_key_get_type(key));
+        TEST_ASSERT_EQUAL_UINT32(i, ska_render_queue_key_get_index(key));
+        TEST_ASSERT_EQUAL_INT(i >= SKA_RENDER_QUEUE_TEXTURE_OVERFLOW_ORDINAL, ska_render_queue_key_is_overflow(key));
+    }
+    ska_render_queue_clear(queue);
+    for (uint32 i = 0; i < SKA_RENDER_QUEUE_MAX_SHADERS + 8; i++) {
+        ska_render_queue_push_sprite(queue, 3, (const void*)(uintptr_t)(i + 1), 7, i);
+    }
+    ska_render_queue_push_font(queue, 2, 7, 0);
+    ska_render_queue_sort(queue);
+    TEST_ASSERT_EQUAL_INT(SkaRenderQueueItemType_FONT, ska_render_queue_key_get_type(queue->keys[0]));
+    TEST_ASSERT_FALSE(ska_render_queue_key_is_overflow(queue->keys[0]));
+    TEST_ASSERT_TRUE(ska_render_queue_key_is_overflow(queue->keys[queue->count - 1]));
+    TEST_ASSERT_EQUAL_UINT32(3, (uint32)(queue->keys[queue->count - 1] >> SKA_RENDER_QUEUE_KEY_Z_INDEX_SHIFT));
+    // Cleared tables number handles from the start again
+    ska_render_queue_clear(queue);
+    ska_render_queue_push_sprite(queue, 3, NULL, 7, 0);
+    TEST_ASSERT_FALSE(ska_render_queue_key_is_overflow(queue->keys[0]));
+    ska_render_queue_destroy(queue);
+}
+
+#undef TEST_RADIX_SORT_SIZE
+
+#define TEST_SPRITE_CULLING_COUNT 37
+
+void seika_stream_ring_test(void) {
+    SkaStreamRing ring;
+    ska_stream_ring_initialize(&ring, 100);
+
+    // Ranges are appended after each other
+    SkaStreamRingRange range = ska_stream_ring_reserve(&ring, 40);
+    TEST_ASSERT_EQUAL_size_t(0, range.offset);
+    TEST_ASSERT_FALSE(range.needsNewStorage);
+    range = ska_stream_ring_reserve(&ring, 40);
+    TEST_ASSERT_EQUAL_size_t(40, range.offset);
+    TEST_ASSERT_FALSE(range.needsNewStorage);
+
+    // Wraps to the start with new storage (orphaning) once the end is reached
+    range = ska_stream_ring_reserve(&ring, 40);
+    TEST_ASSERT_EQUAL_size_t(0, range.offset);
+    TEST_ASSERT_TRUE(range.needsNewStorage);
+    TEST_ASSERT_EQUAL_size_t(100, ring.size);
+    range = ska_stream_ring_reserve(&ring, 60);
+    TEST_ASSERT_EQUAL_size_t(40, range.offset);
+    TEST_ASSERT_FALSE(range.needsNewStorage);
+
+    // Grows when a range is larger than the whole buffer
+    range = ska_stream_ring_reserve(&ring, 250);
+    TEST_ASSERT_EQUAL_size_t(0, range.offset);
+    TEST_ASSERT_TRUE(range.needsNewStorage);
+    TEST_ASSERT_EQUAL_size_t(400, ring.size);
+    range = ska_stream_ring_reserve(&ring, 150);
+    TEST_ASSERT_EQUAL_size_t(250, range.offset);
+    TEST_ASSERT_FALSE(range.needsNewStorage);
+    range = ska_stream_ring_reserve(&ring, 1);
+    TEST_ASSERT_EQUAL_size_t(0, range.offset);
+    TEST_ASSERT_TRUE(range.needsNewStorage);
+    TEST_ASSERT_EQUAL_size_t(1, ring.offset);
+}
+
+void seika_sprite_culling_test(void) {
+    SkaSpriteCullingBounds* bounds = ska_sprite_culling_bounds_create(1);
+    // Rotated by 90 degrees, the quad spans (-20, 0) to (0, 10)
+    SkaAffine2D model = { .xAxis = { 0.0f, 1.0f }, .yAxis = { -1.0f, 0.0f }, .origin = { 0.0f, 0.0f } };
+    ska_sprite_culling_bounds_add(bounds, &model, (SkaSize2D){ 10.0f, 20.0f });
+    TEST_ASSERT_EQUAL_FLOAT(-20.0f, bounds->minX[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bounds->maxX[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bounds->minY[0]);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, bounds->maxY[0]);
+
+    // A row of sprites crossing the view, the count isn't a multiple of the simd width so the remainder is tested too
+    ska_sprite_culling_bounds_clear(bounds);
+    for (usize i = 0; i < TEST_SPRITE_CULLING_COUNT; i++) {
+        model = SKA_AFFINE2D_IDENTITY;
+        model.origin[0] = (f32)i * 10.0f - 100.0f;
+        model.origin[1] = 50.0f;
+        ska_sprite_culling_bounds_add(bounds, &model, (SkaSize2D){ 8.0f, 8.0f });
+    }
+    TEST_ASSERT_EQUAL_size_t(TEST_SPRITE_CULLING_COUNT, bounds->count);
+    const SkaRect2 view = { 0.0f, 0.0f, 200.0f, 100.0f };
+    bool visible[TEST_SPRITE_CULLING_COUNT];
+    const usize visibleCount = ska_sprite_culling_test_view(bounds, &view, visible);
+    usize expectedVisibleCount = 0;
+    for (usize i = 0; i < TEST_SPRITE_CULLING_COUNT; i++) {
+        const f32 x = (f32)i * 10.0f - 100.0f;
+        const bool expectedVisible = x + 8.0f >= 0.0f && x <= 200.0f;
+        TEST_ASSERT_EQUAL(expectedVisible, visible[i]);
+        expectedVisibleCount += expectedVisible;
+    }
+    TEST_ASSERT_EQUAL_size_t(expectedVisibleCount, visibleCount);
+    // Nothing overlaps a view below the row
+    const SkaRect2 emptyView = { 0.0f, 100.0f, 200.0f, 100.0f };
+    TEST_ASSERT_EQUAL_size_t(0, ska_sprite_culling_test_view(bounds, &emptyView, visible));
+    ska_sprite_culling_bounds_destroy(bounds);
+}
+
+void seika_glyph_cache_test(void) {
+    // Four 16 x 16 cells in a 32 x 32 atlas, growing to 64 x 64
+    SkaGlyphCache* cache = ska_glyph_cache_create(16, 16, 32, 64);
+    TEST_ASSERT_EQUAL_UINT32(4, cache->entryCapacity);
+    TEST_ASSERT_EQUAL_UINT32(SKA_GLYPH_CACHE_NOT_FOUND, ska_glyph_cache_find(cache, 'a'));
+    const uint32 entryA = ska_glyph_cache_insert(cache, 'a');
+    TEST_ASSERT_EQUAL_INT(0, cache->entries[entryA].cellX);
+    TEST_ASSERT_EQUAL_INT(0, cache->entries[entryA].cellY);
+    TEST_ASSERT_FALSE(cache->entries[entryA].isCellReused);
+    TEST_ASSERT_EQUAL_UINT32(entryA, ska_glyph_cache_find(cache, 'a'));
+    for (uint32 codepoint = 1; codepoint < 4; codepoint++) {
+        ska_glyph_cache_insert(cache, 'a' + codepoint);
+    }
+    TEST_ASSERT_EQUAL_INT(32, cache->atlasSize);
+    // Full, the atlas grows and existing cells stay where they are
+    const uint32 entryE = ska_glyph_cache_insert(cache, 'e');
+    TEST_ASSERT_EQUAL_INT(64, cache->atlasSize);
+    TEST_ASSERT_EQUAL_UINT32(16, cache->entryCapacity);
+    TEST_ASSERT_EQUAL_UINT32(entryA, ska_glyph_cache_find(cache, 'a'));
+    TEST_ASSERT_EQUAL_INT(0, cache->entries[entryA].cellX);
+    TEST_ASSERT_TRUE(cache->entries[entryE].cellX >= 32 || cache->entries[entryE].cellY >= 32);
+    for (uint32 codepoint = 5; codepoint < 16; codepoint++) {
+        ska_glyph_cache_insert(cache, 'a' + codepoint);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, cache->evictionCount);
+    for (uint32 i = 0; i < cache->entryCount; i++) {
+        TEST_ASSERT_FALSE(cache->entries[i].isCellReused);
+    }
+
+    // At the max size, the least recently used glyph from a previous frame is evicted
+    const uint32 entryB = ska_glyph_cache_find(cache, 'b');
+    const int32 cellXB = cache->entries[entryB].cellX;
+    const int32 cellYB = cache->entries[entryB].cellY;
+    for (uint32 codepoint = 0; codepoint < 16; codepoint++) {
+        ska_glyph_cache_find(cache, 'a' + codepoint);
+    }
+    ska_glyph_cache_begin_frame(cache);
+    // 'a' is used this frame, which leaves 'b' as the least recently used glyph
+    ska_glyph_cache_find(cache, 'a');
+    TEST_ASSERT_EQUAL_UINT32(entryB, ska_glyph_cache_insert(cache, 'z'));
+    TEST_ASSERT_EQUAL_UINT32(1, cache->evictionCount);
+    // The new glyph takes over the evicted glyph's cell, which has to be cleared before drawing into it
+    TEST_ASSERT_EQUAL_INT(cellXB, cache->entries[entryB].cellX);
+    TEST_ASSERT_EQUAL_INT(cellYB, cache->entries[entryB].cellY);
+    TEST_ASSERT_TRUE(cache->entries[entryB].isCellReused);
+    TEST_ASSERT_FALSE(cache->entries[entryA].isCellReused);
+    TEST_ASSERT_EQUAL_UINT32(SKA_GLYPH_CACHE_NOT_FOUND, ska_glyph_cache_find(cache, 'b'));
+    TEST_ASSERT_EQUAL_UINT32(entryB, ska_glyph_cache_find(cache, 'z'));
+    // Every other glyph can still be found after the removal shifted the table
+    for (uint32 codepoint = 0; codepoint < 16; codepoint++) {
+        if (codepoint != 1) {
+            TEST_ASSERT_NOT_EQUAL(SKA_GLYPH_CACHE_NOT_FOUND, ska_glyph_cache_find(cache, 'a' + codepoint));
+        }
+    }
+    // Marking entries as used keeps them like a lookup does, 'z' was used before 'a' but 'a' is evicted
+    ska_glyph_cache_begin_frame(cache);
+    ska_glyph_cache_mark_used(cache, &entryB, 1);
+    TEST_ASSERT_EQUAL_UINT32(entryA, ska_glyph_cache_insert(cache, 'y'));
+    TEST_ASSERT_EQUAL_UINT32(2, cache->evictionCount);
+    TEST_ASSERT_TRUE(cache->entries[entryA].isCellReused);
+    TEST_ASSERT_EQUAL_UINT32(entryB, ska_glyph_cache_find(cache, 'z'));
+
+    // Glyphs used this frame are never evicted
+    ska_glyph_cache_begin_frame(cache);
+    for (uint32 codepoint = 0; codepoint < 16; codepoint++) {
+        ska_glyph_cache_insert(cache, 0x4E00 + codepoint);
+    }
+    TEST_ASSERT_EQUAL_UINT32(SKA_GLYPH_CACHE_NOT_FOUND, ska_glyph_cache_insert(cache, 0x4E10));
+    ska_glyph_cache_destroy(cache);
+}
+
+void seika_distance_field_test(void) {
+    // A 2 x 2 square and a half covered pixel, the field has 2 pixels of room on every side
+    const unsigned char coverage[4 * 4] = {
+        128, 0, 0, 0,
+        0, 255, 255, 0,
+        0, 255, 255, 0,
+        0, 0, 0, 0
+    };
+    unsigned char field[8 * 8];
+    ska_distance_field_generate(coverage, 4, 4, 4, 2, field);
+    // A pixel inside and outside of the square's edge are one pixel from the other side, the outline is halfway
+    TEST_ASSERT_EQUAL_INT(191, field[4 * 8 + 4]);
+    TEST_ASSERT_EQUAL_INT(64, field[4 * 8 + 5]);
+    TEST_ASSERT_EQUAL_INT(64, field[5 * 8 + 4]);
+    // The outline crosses the middle of the half covered pixel
+    TEST_ASSERT_EQUAL_INT(128, field[2 * 8 + 2]);
+    // Distances are clamped at the spread
+    TEST_ASSERT_EQUAL_INT(0, field[7 * 8 + 7]);
+    TEST_ASSERT_EQUAL_INT(0, field[0]);
+}
+
+#undef TEST_SPRITE_CULLING_COUNT
+
+//--- Sync Primitives Test ---//
+
+#define TEST_SYNC_THREAD_COUNT 4
+#define TEST_SYNC_ITERATIONS 20000
+
+static SkaSpinLock testSpinLock = SKA_SPIN_LOCK_INIT;
+static int32 spinLockProtectedCount = 0;
+static SkaThreadEvent testPingEvent;
+static SkaThreadEvent testPongEvent;
+static SkaSemaphore testSemaphore;
+static SKA_ATOMIC(int32) semaphoreAcquiredCount = 0;
+
+static void* test_sync_spin_lock_thread(void* arg) {
+    for (int32 i = 0; i < TEST_SYNC_ITERATIONS; i++) {
+        ska_spin_lock_lock(&testSpinLock);
+        spinLockProtectedCount++;
+        ska_spin_lock_unlock(&testSpinLock);
+    }
+    return NULL;
+}
+
+static void* test_sync_pong_thread(void* arg) {
+    for (int32 i = 0; i < 1000; i++) {
+        ska_thread_event_wait(&testPingEvent);
+        ska_thread_event_set(&testPongEvent);
+    }
+    return NULL;
+}
+
+static void* test_sync_semaphore_thread(void* arg) {
+    for (int32 i = 0; i < 100; i++) {
+        ska_semaphore_wait(&testSemaphore);
+        ska_atomic_fetch_add(&semaphoreAcquiredCount, 1, SkaMemoryOrder_RELAXED);
+    }
+    return NULL;
+}
+
+void seika_sync_primitives_test(void) {
+    pthread_t threads[TEST_SYNC_THREAD_COUNT];
+
+    // Spin lock
+    TEST_ASSERT_TRUE(ska_spin_lock_try_lock(&testSpinLock));
+    TEST_ASSERT_FALSE(ska_spin_lock_try_lock(&testSpinLock));
+    ska_spin_lock_unlock(&testSpinLock);
+    for (usize i = 0; i < TEST_SYNC_THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, test_sync_spin_lock_thread, NULL);
+    }
+    for (usize i = 0; i < TEST_SYNC_THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SYNC_THREAD_COUNT * TEST_SYNC_ITERATIONS, spinLockProtectedCount);
+
+    // Event
+    ska_thread_event_initialize(&testPingEvent);
+    ska_thread_event_initialize(&testPongEvent);
+    TEST_ASSERT_FALSE(ska_thread_event_try_wait(&testPingEvent));
+    ska_thread_event_set(&testPingEvent);
+    ska_thread_event_set(&testPingEvent);
+    TEST_ASSERT_TRUE(ska_thread_event_try_wait(&testPingEvent));
+    TEST_ASSERT_FALSE(ska_thread_event_try_wait(&testPingEvent));
+    pthread_create(&threads[0], NULL, test_sync_pong_thread, NULL);
+    for (int32 i = 0; i < 1000; i++) {
+        ska_thread_event_set(&testPingEvent);
+        ska_thread_event_wait(&testPongEvent);
+    }
+    pthread_join(threads[0], NULL);
+    TEST_ASSERT_FALSE(ska_thread_event_try_wait(&testPingEvent));
+    TEST_ASSERT_FALSE(ska_thread_event_try_wait(&testPongEvent));
+    ska_thread_event_finalize(&testPingEvent);
+    ska_thread_event_finalize(&testPongEvent);
+
+    // Semaphore
+    ska_semaphore_initialize(&testSemaphore, 2);
+    TEST_ASSERT_TRUE(ska_semaphore_try_wait(&testSemaphore));
+    TEST_ASSERT_TRUE(ska_semaphore_try_wait(&testSemaphore));
+    TEST_ASSERT_FALSE(ska_semaphore_try_wait(&testSemaphore));
+    for (usize i = 0; i < TEST_SYNC_THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, test_sync_semaphore_thread, NULL);
+    }
+    for (int32 i = 0; i < TEST_SYNC_THREAD_COUNT * 100; i++) {
+        ska_semaphore_post(&testSemaphore, 1);
+    }
+    for (usize i = 0; i < TEST_SYNC_THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SYNC_THREAD_COUNT * 100, ska_atomic_load(&semaphoreAcquiredCount, SkaMemoryOrder_RELAXED));
+    TEST_ASSERT_FALSE(ska_semaphore_try_wait(&testSemaphore));
+    ska_semaphore_post(&testSemaphore, 3);
+    TEST_ASSERT_TRUE(ska_semaphore_try_wait(&testSemaphore));
+    ska_semaphore_finalize(&testSemaphore);
+}
+
+#undef TEST_SYNC_ITERATIONS
+#undef TEST_SYNC_THREAD_COUNT
+
+//--- Job System Test ---//
+
+static SKA_ATOMIC(int32) jobsRunInTestCount = 0;
+static SkaJobSystem* testJobSystem = NULL;
+
+static void test_job_increment(void* arg) {
+    ska_atomic_fetch_add(&jobsRunInTestCount, 1, SkaMemoryOrder_SEQ_CST);
+}
+
+// Submits jobs from within a job so they're pushed to the worker's own deque
+static void test_job_spawn_children(void* arg) {
+    const usize depth = (usize)(uintptr_t)arg;
+    if (depth == 0) {
+        ska_atomic_fetch_add(&jobsRunInTestCount, 1, SkaMemoryOrder_SEQ_CST);
+        return;
+    }
+    ska_job_system_submit(testJobSystem, test_job_spawn_children, (void*)(uintptr_t)(depth - 1));
+    ska_job_system_submit(testJobSystem, test_job_spawn_children, (void*)(uintptr_t)(depth - 1));
+}
+
+void seika_job_system_test(void) {
+    testJobSystem = ska_job_system_create(4);
+    TEST_ASSERT_EQUAL_size_t(4, ska_job_system_get_worker_count(testJobSystem));
+
+    // More jobs than the queues hold
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+    for (int32 i = 0; i < 20000; i++) {
+        TEST_ASSERT_TRUE(ska_job_system_submit(testJobSystem, test_job_increment, NULL));
+    }
+    ska_job_system_wait_idle(testJobSystem);
+    TEST_ASSERT_EQUAL_INT(20000, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+    TEST_ASSERT_EQUAL_size_t(0, ska_job_system_get_pending_job_count(testJobSystem));
+
+    // Nested submissions (2^10 leaves)
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+    ska_job_system_submit(testJobSystem, test_job_spawn_children, (void*)(uintptr_t)10);
+    ska_job_system_wait_idle(testJobSystem);
+    TEST_ASSERT_EQUAL_INT(1024, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+    ska_job_system_destroy(testJobSystem);
+    testJobSystem = NULL;
+
+    // Thread pool compatibility layer, sized from the cpus
+    SkaCpuTopology topology;
+    ska_cpu_topology_query(&topology);
+    uint32 reservedOrder[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    usize defaultReservedCpuCount = 0;
+    TEST_ASSERT_EQUAL_size_t(topology.cpuCount, ska_cpu_topology_get_reserved_spread_order(&topology, SKA_JOB_SYSTEM_DEFAULT_RESERVED_CORE_COUNT, reservedOrder, SKA_CPU_TOPOLOGY_MAX_CPUS, &defaultReservedCpuCount));
+    const usize expectedWorkerCount = topology.cpuCount > defaultReservedCpuCount ? topology.cpuCount - defaultReservedCpuCount : 1;
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+    SkaThreadPool* threadPool = ska_tpool_create(0);
+    TEST_ASSERT_EQUAL_size_t(expectedWorkerCount < SKA_JOB_SYSTEM_MAX_WORKERS ? expectedWorkerCount : SKA_JOB_SYSTEM_MAX_WORKERS, threadPool->threadCount);
+    for (int32 i = 0; i < 100; i++) {
+        ska_tpool_add_work(threadPool, test_job_increment, NULL);
+    }
+    ska_tpool_wait(threadPool);
+    TEST_ASSERT_EQUAL_INT(100, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+    ska_tpool_destroy(threadPool);
+
+    // Topology
+    TEST_ASSERT_TRUE(topology.cpuCount >= 1);
+    TEST_ASSERT_TRUE(topology.physicalCoreCount >= 1 && topology.physicalCoreCount <= topology.cpuCount);
+    uint32 cpuOrder[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    TEST_ASSERT_EQUAL_size_t(topology.cpuCount, ska_cpu_topology_get_spread_order(&topology, cpuOrder, SKA_CPU_TOPOLOGY_MAX_CPUS));
+    for (usize i = 0; i < topology.physicalCoreCount; i++) {
+        for (usize j = 0; j < i; j++) {
+            TEST_ASSERT_TRUE(cpuOrder[i] != cpuOrder[j]);
+        }
+    }
+
+    // Reserved cores take all of their SMT siblings with them
+    const uint32 reservedCoreId = topology.coreIds[0];
+    usize reservedCoreCpuCount = 0;
+    for (usize i = 0; i < topology.cpuCount; i++) {
+        reservedCoreCpuCount += topology.coreIds[i] == reservedCoreId ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, reservedCoreId);
+    TEST_ASSERT_EQUAL_size_t(reservedCoreCpuCount, defaultReservedCpuCount);
+    TEST_ASSERT_EQUAL_UINT32(cpuOrder[0], reservedOrder[0]);
+
+    // Reserved cpus and pinning
+    testJobSystem = ska_job_system_create_with_config(&(SkaJobSystemConfig){ .workerCount = 2, .reservedCoreCount = 1, .pinWorkers = true });
+    uint32 reservedCpuIds[SKA_CPU_TOPOLOGY_MAX_CPUS];
+    const usize reservedCpuCount = ska_job_system_get_reserved_cpus(testJobSystem, reservedCpuIds, SKA_CPU_TOPOLOGY_MAX_CPUS);
+    TEST_ASSERT_EQUAL_size_t(reservedCoreCpuCount, reservedCpuCount);
+    TEST_ASSERT_EQUAL_UINT32(cpuOrder[0], reservedCpuIds[0]);
+#if defined(PLATFORM_LINUX)
+    for (usize i = 0; i < 2; i++) {
+        const int32 workerCpu = ska_job_system_get_worker_cpu(testJobSystem, i);
+        TEST_ASSERT_TRUE(workerCpu >= 0);
+        if (topology.physicalCoreCount > 1) {
+            for (usize j = 0; j < reservedCpuCount; j++) {
+                TEST_ASSERT_TRUE((uint32)workerCpu != reservedCpuIds[j]);
+            }
+        }
+    }
+#endif
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+    for (int32 i = 0; i < 100; i++) {
+        ska_job_system_submit(testJobSystem, test_job_increment, NULL);
+    }
+    ska_job_system_wait_idle(testJobSystem);
+    TEST_ASSERT_EQUAL_INT(100, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+    ska_job_system_destroy(testJobSystem);
+    testJobSystem = NULL;
+}
+
+#define TEST_PIPELINE_JOB_COUNT 64
+
+static SKA_ATOMIC(int32) physicsJobsDoneCount = 0;
+static SKA_ATOMIC(int32) transformJobsDoneCount = 0;
+static SKA_ATOMIC(int32) pipelineOrderErrorCount = 0;
+
+static void test_job_physics(void* arg) {
+    ska_atomic_fetch_add(&physicsJobsDoneCount, 1, SkaMemoryOrder_SEQ_CST);
+}
+
+static void test_job_transform(void* arg) {
+    if (ska_atomic_load(&physicsJobsDoneCount, SkaMemoryOrder_SEQ_CST) != TEST_PIPELINE_JOB_COUNT) {
+        ska_atomic_fetch_add(&pipelineOrderErrorCount, 1, SkaMemoryOrder_SEQ_CST);
+    }
+    ska_atomic_fetch_add(&transformJobsDoneCount, 1, SkaMemoryOrder_SEQ_CST);
+}
+
+static void test_job_render_prep(void* arg) {
+    if (ska_atomic_load(&transformJobsDoneCount, SkaMemoryOrder_SEQ_CST) != TEST_PIPELINE_JOB_COUNT) {
+        ska_atomic_fetch_add(&pipelineOrderErrorCount, 1, SkaMemoryOrder_SEQ_CST);
+    }
+    ska_atomic_fetch_add(&jobsRunInTestCount, 1, SkaMemoryOrder_SEQ_CST);
+}
+
+// Waits on its own counter from within a job
+static void test_job_wait_on_children(void* arg) {
+    SkaJobCounter* childCounter = ska_job_counter_create(testJobSystem);
+    for (int32 i = 0; i < 8; i++) {
+        ska_job_system_submit_with_counter(testJobSystem, test_job_increment, NULL, childCounter);
+    }
+    ska_job_system_wait_for_counter(testJobSystem, childCounter);
+    ska_job_counter_destroy(childCounter);
+}
+
+void seika_job_counter_test(void) {
+    testJobSystem = ska_job_system_create(3);
+    SkaJobCounter* physicsCounter = ska_job_counter_create(testJobSystem);
+    SkaJobCounter* transformCounter = ska_job_counter_create(testJobSystem);
+    SkaJobCounter* renderPrepCounter = ska_job_counter_create(testJobSystem);
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+
+    // physics -> transform -> render prep, all stages are submitted up front without waiting in between
+    for (int32 i = 0; i < TEST_PIPELINE_JOB_COUNT; i++) {
+        ska_job_system_submit_with_counter(testJobSystem, test_job_physics, NULL, physicsCounter);
+    }
+    for (int32 i = 0; i < TEST_PIPELINE_JOB_COUNT; i++) {
+        ska_job_system_submit_after(testJobSystem, test_job_transform, NULL, physicsCounter, transformCounter);
+    }
+    for (int32 i = 0; i < TEST_PIPELINE_JOB_COUNT; i++) {
+        ska_job_system_submit_after(testJobSystem, test_job_render_prep, NULL, transformCounter, renderPrepCounter);
+    }
+    ska_job_system_wait_for_counter(testJobSystem, renderPrepCounter);
+    TEST_ASSERT_TRUE(ska_job_counter_is_done(physicsCounter));
+    TEST_ASSERT_TRUE(ska_job_counter_is_done(transformCounter));
+    TEST_ASSERT_EQUAL_size_t(0, ska_job_counter_get_value(renderPrepCounter));
+    TEST_ASSERT_EQUAL_INT(TEST_PIPELINE_JOB_COUNT, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+    TEST_ASSERT_EQUAL_INT(0, ska_atomic_load(&pipelineOrderErrorCount, SkaMemoryOrder_SEQ_CST));
+
+    // Dependency that's already done runs right away
+    ska_job_system_submit_after(testJobSystem, test_job_increment, NULL, physicsCounter, renderPrepCounter);
+    ska_job_system_wait_for_counter(testJobSystem, renderPrepCounter);
+    TEST_ASSERT_EQUAL_INT(TEST_PIPELINE_JOB_COUNT + 1, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+
+    // Nested waits help run jobs instead of blocking the worker
+    for (int32 i = 0; i < 4; i++) {
+        ska_job_system_submit_with_counter(testJobSystem, test_job_wait_on_children, NULL, renderPrepCounter);
+    }
+    ska_job_system_wait_for_counter(testJobSystem, renderPrepCounter);
+    TEST_ASSERT_EQUAL_INT(TEST_PIPELINE_JOB_COUNT + 1 + 32, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+
+    ska_job_counter_destroy(physicsCounter);
+    ska_job_counter_destroy(transformCounter);
+    ska_job_counter_destroy(renderPrepCounter);
+    ska_job_system_destroy(testJobSystem);
+    testJobSystem = NULL;
+}
+
+#undef TEST_PIPELINE_JOB_COUNT
+
+typedef struct TestCoroutineState {
+    int32 step;
+    int32 childJobsSeen;
+    SkaJobCounter* childCounter;
+    SkaJobCounter* ioCounter;
+} TestCoroutineState;
+
+static SkaJobCoroutineResult test_coroutine_yield_steps(SkaJobCoroutine* co, void* arg) {
+    TestCoroutineState* state = (TestCoroutineState*)arg;
+    SKA_JOB_COROUTINE_BEGIN(co);
+    for (state->step = 0; state->step < 5; state->step++) {
+        ska_atomic_fetch_add(&jobsRunInTestCount, 1, SkaMemoryOrder_SEQ_CST);
+        SKA_JOB_COROUTINE_YIELD(co);
+    }
+    SKA_JOB_COROUTINE_END(co);
+}
+
+static SkaJobCoroutineResult test_coroutine_await(SkaJobCoroutine* co, void* arg) {
+    TestCoroutineState* state = (TestCoroutineState*)arg;
+    SKA_JOB_COROUTINE_BEGIN(co);
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+    for (int32 i = 0; i < 16; i++) {
+        ska_job_system_submit_with_counter(testJobSystem, test_job_increment, NULL, state->childCounter);
+    }
+    SKA_JOB_COROUTINE_AWAIT(co, state->childCounter);
+    state->childJobsSeen = ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST);
+    // Completed by the test thread, like an I/O request finishing
+    SKA_JOB_COROUTINE_AWAIT(co, state->ioCounter);
+    state->step = 1;
+    SKA_JOB_COROUTINE_END(co);
+}
+
+void seika_job_coroutine_test(void) {
+    testJobSystem = ska_job_system_create(2);
+    SkaJobCounter* coroutineCounter = ska_job_counter_create(testJobSystem);
+
+    // Yielding
+    TestCoroutineState yieldStates[8] = {0};
+    ska_atomic_store(&jobsRunInTestCount, 0, SkaMemoryOrder_SEQ_CST);
+    for (int32 i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(ska_job_system_submit_coroutine(testJobSystem, test_coroutine_yield_steps, &yieldStates[i], coroutineCounter));
+    }
+    ska_job_system_wait_for_counter(testJobSystem, coroutineCounter);
+    TEST_ASSERT_EQUAL_INT(40, ska_atomic_load(&jobsRunInTestCount, SkaMemoryOrder_SEQ_CST));
+    for (int32 i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_INT(5, yieldStates[i].step);
+    }
+
+    // Awaiting child jobs and a manually signaled counter
+    TestCoroutineState awaitState = { .step = 0, .childCounter = ska_job_counter_create(testJobSystem), .ioCounter = ska_job_counter_create(testJobSystem) };
+    ska_job_counter_add(awaitState.ioCounter, 1);
+    ska_job_system_submit_coroutine(testJobSystem, test_coroutine_await, &awaitState, coroutineCounter);
+    ska_job_system_wait_for_counter(testJobSystem, awaitState.childCounter);
+    // Parked on the io counter, not holding a worker but still pending so waiting for idle can't return early
+    while (ska_job_system_get_pending_job_count(testJobSystem) > 1) {
+        ska_job_system_run_pending_job(testJobSystem);
+    }
+    TEST_ASSERT_FALSE(ska_job_counter_is_done(coroutineCounter));
+    TEST_ASSERT_EQUAL_size_t(1, ska_job_system_get_pending_job_count(testJobSystem));
+    TEST_ASSERT_EQUAL_INT(0, awaitState.step);
+    ska_job_counter_signal(awaitState.ioCounter);
+    ska_job_system_wait_idle(testJobSystem);
+    TEST_ASSERT_TRUE(ska_job_counter_is_done(coroutineCounter));
+    TEST_ASSERT_EQUAL_size_t(0, ska_job_system_get_pending_job_count(testJobSystem));
+    TEST_ASSERT_EQUAL_INT(16, awaitState.childJobsSeen);
+    TEST_ASSERT_EQUAL_INT(1, awaitState.step);
+
+    ska_job_counter_destroy(awaitState.childCounter);
+    ska_job_counter_destroy(awaitState.ioCounter);
+    ska_job_counter_destroy(coroutineCounter);
+    ska_job_system_destroy(testJobSystem);
+    testJobSystem = NULL;
+}
+
+void seika_job_system_stats_test(void) {
+    testJobSystem = ska_job_system_create(2);
+    TEST_ASSERT_FALSE(ska_job_system_is_stats_enabled(testJobSystem));
+    ska_job_system_set_stats_enabled(testJobSystem, true);
+    TEST_ASSERT_TRUE(ska_job_system_is_stats_enabled(testJobSystem));
+
+    for (int32 i = 0; i < 500; i++) {
+        ska_job_system_submit(testJobSystem, test_job_increment, NULL);
+    }
+    ska_job_system_submit(testJobSystem, test_job_spawn_children, (void*)(uintptr_t)6);
+    ska_job_system_wait_idle(testJobSystem);
+
+    // 500 + (2^7 - 1) jobs split between the workers and the waiting thread
+    SkaJobSystemStats stats;
+    ska_job_system_get_stats(testJobSystem, &stats);
+    TEST_ASSERT_EQUAL_size_t(2, stats.workerCount);
+    uint64 jobsRun = stats.external.jobsRun;
+    for (usize i = 0; i < stats.workerCount; i++) {
+        jobsRun += stats.workers[i].jobsRun;
+        TEST_ASSERT_TRUE(stats.workers[i].steals <= stats.workers[i].stealAttempts);
+    }
+    TEST_ASSERT_EQUAL_UINT64(627, jobsRun);
+    uint64 latencyCount = 0;
+    uint64 runTimeCount = 0;
+    for (usize i = 0; i < SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT; i++) {
+        latencyCount += stats.latencyHistogram[i];
+        runTimeCount += stats.runTimeHistogram[i];
+    }
+    TEST_ASSERT_EQUAL_UINT64(627, latencyCount);
+    TEST_ASSERT_EQUAL_UINT64(627, runTimeCount);
+    TEST_ASSERT_TRUE(stats.external.peakQueueDepth >= 1);
+    TEST_ASSERT_EQUAL_size_t(0, stats.pendingJobCount);
+
+    ska_job_system_reset_stats(testJobSystem);
+    ska_job_system_get_stats(testJobSystem, &stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.workers[0].jobsRun + stats.workers[1].jobsRun + stats.external.jobsRun);
+
+    // Percentiles report the upper bound of the bucket
+    uint64 histogram[SKA_JOB_STATS_HISTOGRAM_BUCKET_COUNT] = {0};
+    TEST_ASSERT_EQUAL_UINT64(0, ska_job_stats_get_histogram_percentile(histogram, 0.5f));
+    histogram[4] = 90;
+    histogram[10] = 10;
+    TEST_ASSERT_EQUAL_UINT64(32, ska_job_stats_get_histogram_percentile(histogram, 0.5f));
+    TEST_ASSERT_EQUAL_UINT64(2048, ska_job_stats_get_histogram_percentile(histogram, 0.95f));
+    TEST_ASSERT_EQUAL_UINT64(2048, ska_job_stats_get_histogram_percentile(histogram, 1.0f));
+
+    ska_job_system_set_stats_enabled(testJobSystem, false);
+    ska_job_system_destroy(testJobSystem);
+    testJobSystem = NULL;
+}
+
 #if SKA_ECS
 typedef struct TestValueComponent {
     int32 value;
@@ -480,6 +1561,32 @@ void seika_ecs_test(void) {
     TEST_ASSERT_EQUAL_size_t(1, ska_ecs_entity_get_active_count());
 #undef TEST_ENTITY_QUEUE_AMOUNT
 
+    // Test generational entity ids
+    TEST_ASSERT_TRUE(ska_ecs_entity_is_alive(testEntity));
+    TEST_ASSERT_FALSE(ska_ecs_entity_is_alive(1));
+    // Stale handles don't reach the components of whatever entity has their index now
+    const SkaEntity reusedEntity = ska_ecs_entity_create();
+    const SkaEntity staleEntity = SKA_ENTITY_MAKE(SKA_ENTITY_GET_INDEX(reusedEntity), SKA_ENTITY_GET_GENERATION(reusedEntity) - 1);
+    ska_ecs_component_manager_set_component(reusedEntity, valueTypeInfo->index, SKA_ALLOC_ZEROED(TestValueComponent));
+    TEST_ASSERT_TRUE(ska_ecs_component_manager_has_component(reusedEntity, valueTypeInfo->index));
+    TEST_ASSERT_FALSE(ska_ecs_component_manager_has_component(staleEntity, valueTypeInfo->index));
+    TEST_ASSERT_NULL(ska_ecs_component_manager_get_component_unchecked(staleEntity, valueTypeInfo->index));
+    ska_ecs_component_manager_remove_all_components(reusedEntity);
+    ska_ecs_entity_return(reusedEntity);
+    TEST_ASSERT_FALSE(ska_ecs_entity_is_alive(SKA_NULL_ENTITY));
+    SkaEntity churnedEntity = SKA_NULL_ENTITY;
+    for (usize i = 0; i < 4096; i++) {
+        churnedEntity = ska_ecs_entity_create();
+        ska_ecs_entity_return(churnedEntity);
+    }
+    const SkaEntity recycledEntity = ska_ecs_entity_create();
+    TEST_ASSERT_TRUE(ska_ecs_entity_is_alive(recycledEntity));
+    TEST_ASSERT_NOT_EQUAL(0, SKA_ENTITY_GET_GENERATION(recycledEntity));
+    TEST_ASSERT_FALSE(ska_ecs_entity_is_alive(SKA_ENTITY_MAKE(SKA_ENTITY_GET_INDEX(recycledEntity), SKA_ENTITY_GET_GENERATION(recycledEntity) - 1)));
+    TEST_ASSERT_EQUAL_UINT32(recycledEntity, ska_ecs_entity_get_from_index(SKA_ENTITY_GET_INDEX(recycledEntity)));
+    ska_ecs_entity_return(recycledEntity);
+    TEST_ASSERT_EQUAL_size_t(1, ska_ecs_entity_get_active_count());
+
     // Test getting component
     TestValueComponent testComponent = { .value = 10 };
     ska_ecs_component_manager_set_component(testEntity, valueTypeInfo->index, &testComponent);
@@ -499,6 +1606,230 @@ void seika_ecs_test(void) {
 
     ska_ecs_finalize();
 }
+
+void seika_ecs_query_test(void) {
+    ska_ecs_initialize();
+
+    const SkaComponentTypeInfo* valueTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestValueComponent);
+    const SkaComponentTypeInfo* transformTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestTransformComponent);
+
+    // Entities created before the query should be picked up on creation
+    const SkaEntity valueEntity = ska_ecs_entity_create();
+    ska_ecs_component_manager_set_component(valueEntity, valueTypeInfo->index, SKA_ALLOC_ZEROED(TestValueComponent));
+    const SkaEntity bothEntity = ska_ecs_entity_create();
+    ska_ecs_component_manager_set_component(bothEntity, valueTypeInfo->index, SKA_ALLOC_ZEROED(TestValueComponent));
+    ska_ecs_component_manager_set_component(bothEntity, transformTypeInfo->index, SKA_ALLOC_ZEROED(TestTransformComponent));
+
+    SkaECSQuery* valueQuery = SKA_ECS_QUERY_CREATE(TestValueComponent);
+    SkaECSQuery* bothQuery = SKA_ECS_QUERY_CREATE(TestValueComponent, TestTransformComponent);
+    SkaECSQuery* valueOnlyQuery = ska_ecs_query_create_with_filter(valueTypeInfo->type, transformTypeInfo->type);
+    TEST_ASSERT_EQUAL_size_t(2, ska_ecs_query_get_entity_count(valueQuery));
+    TEST_ASSERT_EQUAL_size_t(1, ska_ecs_query_get_entity_count(bothQuery));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_entity(bothQuery, bothEntity));
+    TEST_ASSERT_EQUAL_size_t(1, ska_ecs_query_get_entity_count(valueOnlyQuery));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_entity(valueOnlyQuery, valueEntity));
+
+    // Signature changes should update queries incrementally
+    ska_ecs_component_manager_set_component(valueEntity, transformTypeInfo->index, SKA_ALLOC_ZEROED(TestTransformComponent));
+    TEST_ASSERT_EQUAL_size_t(2, ska_ecs_query_get_entity_count(bothQuery));
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_entity_count(valueOnlyQuery));
+
+    ska_ecs_component_manager_remove_component(bothEntity, transformTypeInfo->index);
+    TEST_ASSERT_FALSE(ska_ecs_query_has_entity(bothQuery, bothEntity));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_entity(valueOnlyQuery, bothEntity));
+
+    usize iterCount = 0;
+    SKA_ECS_QUERY_FOR_EACH(bothQuery, entity) {
+        TEST_ASSERT_EQUAL_UINT32(valueEntity, entity);
+        iterCount++;
+    }
+    TEST_ASSERT_EQUAL_size_t(1, iterCount);
+
+    ska_ecs_component_manager_remove_all_components(valueEntity);
+    ska_ecs_component_manager_remove_all_components(bothEntity);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_entity_count(valueQuery));
+    iterCount = 0;
+    SKA_ECS_QUERY_FOR_EACH(valueQuery, entity) {
+        TEST_ASSERT_NOT_EQUAL(SKA_NULL_ENTITY, entity);
+        iterCount++;
+    }
+    TEST_ASSERT_EQUAL_size_t(0, iterCount);
+
+    // A query without a 'with' signature only matches live entities that have components
+    SkaECSQuery* anyQuery = ska_ecs_query_create(SKA_ECS_COMPONENT_TYPE_NONE);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_entity_count(anyQuery));
+    ska_ecs_component_manager_set_component(valueEntity, valueTypeInfo->index, SKA_ALLOC_ZEROED(TestValueComponent));
+    TEST_ASSERT_EQUAL_size_t(1, ska_ecs_query_get_entity_count(anyQuery));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_entity(anyQuery, valueEntity));
+    ska_ecs_despawn_batch(&valueEntity, 1);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_entity_count(anyQuery));
+    // Rebuilding skips the despawned entity's free slot
+    ska_ecs_query_set_without(anyQuery, SKA_ECS_COMPONENT_TYPE_NONE);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_entity_count(anyQuery));
+
+    ska_ecs_query_destroy(valueQuery);
+    ska_ecs_finalize();
+}
+
+void seika_ecs_spawn_batch_test(void) {
+    ska_ecs_initialize();
+
+    const SkaComponentTypeInfo* valueTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestValueComponent);
+    const SkaComponentTypeInfo* transformTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestTransformComponent);
+    entityRegisteredInTestCount = 0;
+    SkaECSSystem* valueSystem = SKA_ECS_SYSTEM_CREATE("batch value system", TestValueComponent);
+    valueSystem->on_entity_registered_func = test_ecs_callback_on_entity_registered;
+    ska_ecs_system_register(valueSystem);
+    SkaECSQuery* bothQuery = SKA_ECS_QUERY_CREATE(TestValueComponent, TestTransformComponent);
+
+#define TEST_SPAWN_BATCH_AMOUNT 2000
+    static SkaEntity entities[TEST_SPAWN_BATCH_AMOUNT];
+    const void* initData[SKA_ECS_MAX_COMPONENTS] = {0};
+    initData[valueTypeInfo->index] = &(TestValueComponent){ .value = 42 };
+    ska_ecs_spawn_batch(valueTypeInfo->type | transformTypeInfo->type, TEST_SPAWN_BATCH_AMOUNT, initData, entities);
+
+    TEST_ASSERT_EQUAL_size_t(TEST_SPAWN_BATCH_AMOUNT, ska_ecs_entity_get_active_count());
+    TEST_ASSERT_EQUAL_size_t(TEST_SPAWN_BATCH_AMOUNT, valueSystem->entities->size);
+    TEST_ASSERT_EQUAL_INT(TEST_SPAWN_BATCH_AMOUNT, entityRegisteredInTestCount);
+    TEST_ASSERT_EQUAL_size_t(TEST_SPAWN_BATCH_AMOUNT, ska_ecs_query_get_entity_count(bothQuery));
+    const TestValueComponent* valueComponent = (TestValueComponent*)ska_ecs_component_manager_get_component(entities[TEST_SPAWN_BATCH_AMOUNT - 1], valueTypeInfo->index);
+    TEST_ASSERT_EQUAL_INT(42, valueComponent->value);
+    const TestTransformComponent* transformComponent = (TestTransformComponent*)ska_ecs_component_manager_get_component(entities[0], transformTypeInfo->index);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, transformComponent->transform2D.position.x);
+
+    // Batch allocated components can still be removed individually
+    ska_ecs_component_manager_remove_component(entities[0], transformTypeInfo->index);
+    TEST_ASSERT_FALSE(ska_ecs_component_manager_has_component(entities[0], transformTypeInfo->index));
+    TEST_ASSERT_FALSE(ska_ecs_query_has_entity(bothQuery, entities[0]));
+
+    ska_ecs_despawn_batch(entities, TEST_SPAWN_BATCH_AMOUNT);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_entity_get_active_count());
+    TEST_ASSERT_EQUAL_size_t(0, valueSystem->entities->size);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_entity_count(bothQuery));
+    TEST_ASSERT_FALSE(ska_ecs_entity_is_alive(entities[0]));
+#undef TEST_SPAWN_BATCH_AMOUNT
+
+    ska_ecs_finalize();
+}
+
+static usize changedEntitiesInTestCount = 0;
+
+static void test_ecs_callback_count_changed_entities(SkaECSSystem* system, f32 deltaTime) {
+    changedEntitiesInTestCount = 0;
+    SKA_ECS_SYSTEM_CHANGED_ENTITIES_FOR(system, entity) {
+        changedEntitiesInTestCount++;
+    }
+}
+
+void seika_ecs_change_detection_test(void) {
+    ska_ecs_initialize();
+
+    const SkaComponentTypeInfo* valueTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestValueComponent);
+    const SkaComponentTypeInfo* transformTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestTransformComponent);
+    SkaECSSystem* valueSystem = SKA_ECS_SYSTEM_CREATE("changed value system", TestValueComponent);
+    valueSystem->update_func = test_ecs_callback_count_changed_entities;
+    ska_ecs_system_register(valueSystem);
+    SkaECSQuery* valueQuery = SKA_ECS_QUERY_CREATE(TestValueComponent, TestTransformComponent);
+    ska_ecs_query_set_changed(valueQuery, valueTypeInfo->type);
+
+    SkaEntity entities[4];
+    for (usize i = 0; i < 4; i++) {
+        entities[i] = ska_ecs_entity_create();
+        ska_ecs_component_manager_set_component(entities[i], valueTypeInfo->index, SKA_ALLOC_ZEROED(TestValueComponent));
+        ska_ecs_component_manager_set_component(entities[i], transformTypeInfo->index, SKA_ALLOC_ZEROED(TestTransformComponent));
+        ska_ecs_system_update_entity_signature_with_systems(entities[i]);
+    }
+
+    // Newly added components count as changed
+    TEST_ASSERT_EQUAL_size_t(4, ska_ecs_query_get_changed_entity_count(valueQuery));
+    ska_ecs_system_event_update_systems(0.1f);
+    TEST_ASSERT_EQUAL_size_t(4, changedEntitiesInTestCount);
+    ska_ecs_query_clear_changed(valueQuery);
+    TEST_ASSERT_EQUAL_size_t(0, ska_ecs_query_get_changed_entity_count(valueQuery));
+    ska_ecs_system_event_update_systems(0.1f);
+    TEST_ASSERT_EQUAL_size_t(0, changedEntitiesInTestCount);
+
+    // Mutable fetches and explicit marks flag components as changed
+    TestValueComponent* valueComponent = (TestValueComponent*)ska_ecs_component_manager_get_component_mut(entities[1], valueTypeInfo->index);
+    valueComponent->value = 7;
+    ska_ecs_component_manager_mark_changed(entities[3], valueTypeInfo->index);
+    ska_ecs_component_manager_mark_changed(entities[3], valueTypeInfo->index);
+    // Not part of the query's changed signature
+    ska_ecs_component_manager_mark_changed(entities[2], transformTypeInfo->index);
+    TEST_ASSERT_EQUAL_size_t(2, ska_ecs_query_get_changed_entity_count(valueQuery));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_changed_entity(valueQuery, entities[1]));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_changed_entity(valueQuery, entities[3]));
+    TEST_ASSERT_FALSE(ska_ecs_query_has_changed_entity(valueQuery, entities[0]));
+    usize changedCount = 0;
+    SKA_ECS_QUERY_FOR_EACH_CHANGED(valueQuery, entity) {
+        TEST_ASSERT_TRUE(entity == entities[1] || entity == entities[3]);
+        changedCount++;
+    }
+    TEST_ASSERT_EQUAL_size_t(2, changedCount);
+    ska_ecs_system_event_update_systems(0.1f);
+    TEST_ASSERT_EQUAL_size_t(2, changedEntitiesInTestCount);
+    TEST_ASSERT_TRUE(ska_ecs_component_manager_get_component_change_tick(entities[1], valueTypeInfo->index) > ska_ecs_component_manager_get_component_change_tick(entities[0], valueTypeInfo->index));
+
+    // Entities leaving the query are dropped from its changed list
+    ska_ecs_component_manager_remove_component(entities[3], transformTypeInfo->index);
+    TEST_ASSERT_EQUAL_size_t(1, ska_ecs_query_get_changed_entity_count(valueQuery));
+    TEST_ASSERT_TRUE(ska_ecs_query_has_changed_entity(valueQuery, entities[1]));
+
+    // Changing the filter rebuilds the query, which can't tell what changed in between so every entity is marked
+    ska_ecs_query_set_without(valueQuery, SKA_ECS_COMPONENT_TYPE_NONE);
+    TEST_ASSERT_EQUAL_size_t(3, ska_ecs_query_get_entity_count(valueQuery));
+    TEST_ASSERT_EQUAL_size_t(3, ska_ecs_query_get_changed_entity_count(valueQuery));
+
+    ska_ecs_finalize();
+}
+
+void seika_ecs_snapshot_test(void) {
+    ska_ecs_initialize();
+
+    const SkaComponentTypeInfo* valueTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestValueComponent);
+    const SkaComponentTypeInfo* transformTypeInfo = SKA_ECS_REGISTER_COMPONENT(TestTransformComponent);
+    SkaECSSystem* valueSystem = SKA_ECS_SYSTEM_CREATE("snapshot value system", TestValueComponent);
+    ska_ecs_system_register(valueSystem);
+    SkaECSQuery* bothQuery = SKA_ECS_QUERY_CREATE(TestValueComponent, TestTransformComponent);
+
+    SkaEntity entities[3];
+    const void* initData[SKA_ECS_MAX_COMPONENTS] = {0};
+    initData[valueTypeInfo->index] = &(TestValueComponent){ .value = 5 };
+    ska_ecs_spawn_batch(valueTypeInfo->type | transformTypeInfo->type, 3, initData, entities);
+
+    SkaECSSnapshot* snapshot = ska_ecs_snapshot_create();
+    ska_ecs_snapshot_capture(snapshot);
+    TEST_ASSERT_NOT_NULL(snapshot->data);
+    TEST_ASSERT_GREATER_THAN(0, snapshot->size);
+
+    // Mutate state after the snapshot
+    ((TestValueComponent*)ska_ecs_component_manager_get_component_mut(entities[0], valueTypeInfo->index))->value = 99;
+    ska_ecs_component_manager_remove_component(entities[1], transformTypeInfo->index);
+    ska_ecs_despawn_batch(&entities[2], 1);
+    const SkaEntity newEntity = ska_ecs_entity_create();
+    ska_ecs_component_manager_set_component(newEntity, valueTypeInfo->index, SKA_ALLOC_ZEROED(TestValueComponent));
+    ska_ecs_system_update_entity_signature_with_systems(newEntity);
+    TEST_ASSERT_EQUAL_size_t(3, valueSystem->entities->size);
+    TEST_ASSERT_EQUAL_size_t(1, ska_ecs_query_get_entity_count(bothQuery));
+
+    ska_ecs_snapshot_restore(snapshot);
+    TEST_ASSERT_EQUAL_size_t(3, ska_ecs_entity_get_active_count());
+    TEST_ASSERT_TRUE(ska_ecs_entity_is_alive(entities[2]));
+    TEST_ASSERT_FALSE(ska_ecs_entity_is_alive(newEntity));
+    TEST_ASSERT_EQUAL_INT(5, ((TestValueComponent*)ska_ecs_component_manager_get_component(entities[0], valueTypeInfo->index))->value);
+    TEST_ASSERT_EQUAL_INT(5, ((TestValueComponent*)ska_ecs_component_manager_get_component(entities[2], valueTypeInfo->index))->value);
+    TEST_ASSERT_TRUE(ska_ecs_component_manager_has_component(entities[1], transformTypeInfo->index));
+    TEST_ASSERT_FALSE(ska_ecs_component_manager_has_component(newEntity, valueTypeInfo->index));
+    TEST_ASSERT_EQUAL_size_t(3, valueSystem->entities->size);
+    TEST_ASSERT_TRUE(ska_ecs_system_has_entity(entities[2], valueSystem));
+    TEST_ASSERT_FALSE(ska_ecs_system_has_entity(newEntity, valueSystem));
+    TEST_ASSERT_EQUAL_size_t(3, ska_ecs_query_get_entity_count(bothQuery));
+    // Entity creation after restoring follows the same order as after the capture
+    TEST_ASSERT_EQUAL_UINT32(newEntity, ska_ecs_entity_create());
+
+    ska_ecs_snapshot_destroy(snapshot);
+    ska_ecs_finalize();
+}
 #endif
 
 #if SKA_INPUT